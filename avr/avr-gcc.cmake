@@ -0,0 +1,27 @@
+# Toolchain of the on-target build: avr-gcc for the ATmega328P of the Arduino Uno, with the flags of the
+# Arduino IDE.
+#
+#   cmake -S avr/target -B build-avr -DCMAKE_TOOLCHAIN_FILE=avr/avr-gcc.cmake
+
+set(CMAKE_SYSTEM_NAME Generic)
+set(CMAKE_SYSTEM_PROCESSOR avr)
+
+set(AVR_MCU atmega328p CACHE STRING "AVR microcontroller (-mmcu)")
+set(AVR_F_CPU 16000000UL CACHE STRING "CPU frequency (F_CPU)")
+
+find_program(AVR_GCC avr-gcc)
+find_program(AVR_GXX avr-g++)
+
+set(CMAKE_C_COMPILER ${AVR_GCC})
+set(CMAKE_CXX_COMPILER ${AVR_GXX})
+set(CMAKE_ASM_COMPILER ${AVR_GCC})
+
+set(AVR_FLAGS "-mmcu=${AVR_MCU} -DF_CPU=${AVR_F_CPU} -ffunction-sections -fdata-sections")
+
+set(CMAKE_C_FLAGS_INIT "${AVR_FLAGS}")
+set(CMAKE_CXX_FLAGS_INIT "${AVR_FLAGS} -fpermissive -fno-exceptions -fno-threadsafe-statics")
+set(CMAKE_ASM_FLAGS_INIT "${AVR_FLAGS} -x assembler-with-cpp")
+set(CMAKE_EXE_LINKER_FLAGS_INIT "-mmcu=${AVR_MCU} -Wl,--gc-sections")
+
+# No programs can run on the host: the compiler checks build static libraries
+set(CMAKE_TRY_COMPILE_TARGET_TYPE STATIC_LIBRARY)
@@ -0,0 +1,245 @@
+/*
+ * HotPaths.ino
+ * Measures the CPU cycles and the stack used by the most used functions of the SmartObject libraries
+ * (AVR boards, e.g. Arduino Uno).
+ *
+ * Timer1 counts CPU cycles (no prescaler) while a function is called with interrupts disabled; the cost
+ * of an empty call is subtracted. Then the free RAM is filled with a pattern and the function is called
+ * once more: the stack used is the size of the area overwritten below the caller, less the one of an
+ * empty call. The RAM is filled and checked with interrupts disabled, so interrupt handlers do not add
+ * their frames.
+ * IntervalSeconds::getTimeAsString is measured twice: in the same minute and format as the previous
+ * call (only the seconds are written) and alternating two formats (the whole string is written).
+ * Results are printed as CSV lines on the serial monitor:
+ *
+ *   function,calls,cycles_per_call,stack_bytes
+ *
+ * followed by the flash size of the sketch. A function longer than 65535 cycles is reported with
+ * cycles_per_call = -1.
+ *
+ * The sketch can be uploaded from the Arduino IDE, or built by CMake with avr-gcc and run on simavr (see
+ * avr/CMakeLists.txt): with SMRTOBJ_SIMAVR defined the lines are written on the simavr console and the
+ * simulation ends after the measurements.
+ *
+ * Authors:
+ *         Marco Boeris Frusca
+ *
+ */
+#include <Arduino.h>
+#include <Time.h>
+#include <smrtobjio.h>
+#include <stringparser.h>
+#include <avgvalue.h>
+#include <gpsposition.h>
+#include <intervalseconds.h>
+
+#if !defined(__AVR__)
+#error "This benchmark uses Timer1 and the AVR memory layout"
+#endif
+
+#if defined(SMRTOBJ_SIMAVR)
+#include <avr/sleep.h>
+#include <simavr/avr/avr_mcu_section.h>
+
+// Simulated MCU, and console of simavr: the bytes written in GPIOR0 are printed by the simulator
+AVR_MCU(F_CPU, "atmega328p");
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+/**
+ * Writes on the simavr console.
+ */
+class SimavrConsole : public Print
+{
+  public:
+    virtual size_t write(uint8_t c)
+    {
+      GPIOR0 = c;
+      return 1;
+    }
+};
+
+SimavrConsole console;
+Print &out = console;
+#else
+Print &out = Serial;
+#endif
+
+// Number of calls for each function
+#define CALLS 32
+
+// Pattern used to fill free RAM
+#define STACK_PATTERN 0xAA
+
+// Symbols of the AVR memory layout
+extern uint8_t __heap_start;
+extern void *__brkval;
+extern uint8_t __data_load_end;
+
+// Objects used by the functions
+smrtobj::data::AvgValue avg;
+smrtobj::data::GPSPosition position;
+smrtobj::io::AnalogInput ain;
+smrtobj::timer::IntervalSeconds interval;
+char number[] = "-1234.5678";
+
+// Cost of an empty call
+uint16_t emptyCycles = 0;
+uint16_t emptyStack = 0;
+
+// Functions under test
+void emptyCall() { }
+void isFloatStr() { smrtobj::parser::StringParser::isFloatStr(number); }
+void avgPush() { avg.push(12.5); }
+void inputVoltage() { ain.inputVoltage(); }
+void getTimeAsString() { interval.getTimeAsString(); }
+void getTimeAsStringUncached()
+{
+  static byte format = smrtobj::timer::IntervalSeconds::DEFAULT_TF;
+
+  format = (format == smrtobj::timer::IntervalSeconds::ISO) ?
+      smrtobj::timer::IntervalSeconds::DEFAULT_TF : smrtobj::timer::IntervalSeconds::ISO;
+  interval.getTimeAsString(format);
+}
+void setCoordinate() { position.setLatitude("45.0703"); }
+
+/**
+ * Fills the free RAM (from the end of the heap to the stack pointer) with the pattern.
+ */
+void paintStack()
+{
+  uint8_t *p = (__brkval) ? (uint8_t*) __brkval : &__heap_start;
+  uint8_t *sp = (uint8_t*) SP;
+
+  // Keep a margin for this function
+  while (p < sp - 8)
+  {
+    *p++ = STACK_PATTERN;
+  }
+}
+
+/**
+ * Gets the lowest address overwritten since the last paintStack.
+ */
+uint8_t* stackBottom()
+{
+  uint8_t *p = (__brkval) ? (uint8_t*) __brkval : &__heap_start;
+
+  while (*p == STACK_PATTERN && p < (uint8_t*) SP)
+  {
+    p++;
+  }
+
+  return p;
+}
+
+/**
+ * Calls a function with interrupts disabled and returns the cycles counted by Timer1, or 0xFFFF if the
+ * timer overflows.
+ */
+uint16_t cycles(void (*f)())
+{
+  uint8_t sreg = SREG;
+  cli();
+
+  TCNT1 = 0;
+  TIFR1 = _BV(TOV1);
+  f();
+  uint16_t n = TCNT1;
+  bool overflow = TIFR1 & _BV(TOV1);
+
+  SREG = sreg;
+
+  return (overflow) ? 0xFFFF : n;
+}
+
+/**
+ * Calls a function with interrupts disabled and returns the stack used below the caller.
+ */
+uint16_t stack(void (*f)())
+{
+  uint8_t sreg = SREG;
+  cli();
+
+  paintStack();
+  uint8_t *sp = (uint8_t*) SP;
+  f();
+  uint8_t *bottom = stackBottom();
+
+  SREG = sreg;
+
+  return (bottom < sp) ? (uint16_t) (sp - bottom) : 0;
+}
+
+/**
+ * Measures a function and prints a CSV line.
+ */
+void measure(const __FlashStringHelper *name, void (*f)())
+{
+  uint32_t total = 0;
+  bool overflow = false;
+
+  for (uint8_t i = 0; i < CALLS; i++)
+  {
+    uint16_t n = cycles(f);
+
+    if (n == 0xFFFF)
+      overflow = true;
+
+    // A call can be faster than the empty one (e.g. a cached path): the difference is never negative
+    total += (n > emptyCycles) ? n - emptyCycles : 0;
+  }
+
+  uint16_t used = stack(f);
+
+  out.print(name);
+  out.print(',');
+  out.print(CALLS);
+  out.print(',');
+  if (overflow)
+    out.print(-1);
+  else
+    out.print(total / CALLS);
+  out.print(',');
+  out.println( (used > emptyStack) ? used - emptyStack : 0 );
+}
+
+void setup()
+{
+#if !defined(SMRTOBJ_SIMAVR)
+  // Open serial monitor
+  Serial.begin(115200);
+#endif
+
+  ain.init(A0);
+  interval.update();
+  interval.getTimeAsString();    // the cached measurement starts from a formatted string
+
+  // Timer1: normal mode, clock without prescaler (1 tick = 1 cycle)
+  TCCR1A = 0;
+  TCCR1B = _BV(CS10);
+
+  emptyCycles = cycles(emptyCall);
+  emptyStack = stack(emptyCall);
+
+  out.println( F("function,calls,cycles_per_call,stack_bytes") );
+  measure(F("StringParser::isFloatStr"), isFloatStr);
+  measure(F("AvgValue::push"), avgPush);
+  measure(F("AnalogInput::inputVoltage"), inputVoltage);
+  measure(F("IntervalSeconds::getTimeAsString (cached)"), getTimeAsString);
+  measure(F("IntervalSeconds::getTimeAsString (uncached)"), getTimeAsStringUncached);
+  measure(F("GPSPosition::setCoordinate"), setCoordinate);
+
+  out.print( F("flash_bytes,") );
+  out.println( (uint16_t) &__data_load_end );
+
+#if defined(SMRTOBJ_SIMAVR)
+  // simavr stops when the CPU sleeps with interrupts disabled
+  cli();
+  sleep_enable();
+  sleep_cpu();
+#endif
+}
+
+void loop()
+{
+}
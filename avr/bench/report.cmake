@@ -0,0 +1,105 @@
+# Runs the benchmark sketch on simavr and writes its results as CSV, with the flash size of the symbols
+# read by avr-nm:
+#
+#   hotpaths.csv          function,calls,cycles_per_call,stack_bytes,flash_bytes
+#   hotpaths_symbols.csv  symbol,flash_bytes (all the smrtobj symbols linked, largest last)
+#
+# flash_bytes of a function is the size of its own code (all its overloads), without the functions it
+# calls. Both files are printed at the end.
+#
+#   cmake -DSIMAVR=simavr -DAVR_NM=avr-nm -DAVR_MCU=atmega328p -DAVR_F_CPU=16000000
+#         -DELF=hotpaths.elf -DOUTPUT_DIR=. -P report.cmake
+
+foreach(var SIMAVR AVR_NM AVR_MCU AVR_F_CPU ELF OUTPUT_DIR)
+  if (NOT ${var})
+    message(FATAL_ERROR "${var} is not set")
+  endif()
+endforeach()
+
+# simavr prints the console lines (prefixed by "O:" and colored by some versions) on stderr
+execute_process(
+  COMMAND ${SIMAVR} -m ${AVR_MCU} -f ${AVR_F_CPU} ${ELF}
+  OUTPUT_VARIABLE console
+  ERROR_VARIABLE console
+  RESULT_VARIABLE result
+  TIMEOUT 300)
+
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "simavr failed (${result}):\n${console}")
+endif()
+
+string(ASCII 27 esc)
+string(REGEX REPLACE "${esc}\\[[0-9;]*m" "" console "${console}")
+string(REGEX MATCHALL "[^\n]+" lines "${console}")
+
+execute_process(
+  COMMAND ${AVR_NM} --size-sort --print-size --radix=d -C ${ELF}
+  OUTPUT_VARIABLE nm
+  RESULT_VARIABLE result)
+
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "avr-nm failed (${result})")
+endif()
+
+# Code of the libraries: "address size type name"
+string(REGEX MATCHALL "[^\n]+" symbols "${nm}")
+set(names "")
+set(sizes "")
+set(csv "symbol,flash_bytes\n")
+
+foreach(symbol IN LISTS symbols)
+  if (symbol MATCHES "^[0-9]+ ([0-9]+) [tTwW] (.*smrtobj::.*)$")
+    set(size ${CMAKE_MATCH_1})
+    string(REPLACE ";" "," name "${CMAKE_MATCH_2}")
+    string(REGEX REPLACE "^0+([0-9])" "\\1" size "${size}")
+    list(APPEND names "${name}")
+    list(APPEND sizes ${size})
+    string(APPEND csv "\"${name}\",${size}\n")
+  endif()
+endforeach()
+
+file(WRITE ${OUTPUT_DIR}/hotpaths_symbols.csv "${csv}")
+
+# Measurements of the sketch, with the size of the functions measured
+set(csv "")
+set(rows 0)
+
+foreach(line IN LISTS lines)
+  string(REGEX REPLACE "^O: ?" "" line "${line}")
+
+  if (line MATCHES "^function,")
+    string(APPEND csv "${line},flash_bytes\n")
+  elseif (line MATCHES "^flash_bytes,([0-9]+)$")
+    string(APPEND csv "sketch,,,,${CMAKE_MATCH_1}\n")
+  elseif (line MATCHES "^([^,]+),([0-9]+),(-?[0-9]+),([0-9]+)$")
+    # "Class::function (variant)" matches the symbols "...::Class::function(...)"
+    string(REGEX REPLACE " \\(.*\\)$" "" function "${CMAKE_MATCH_1}")
+    set(flash 0)
+    list(LENGTH names count)
+
+    if (count GREATER 0)
+      math(EXPR last "${count} - 1")
+
+      foreach(i RANGE ${last})
+        list(GET names ${i} name)
+
+        string(FIND "${name}" "::${function}(" pos)
+        if (pos GREATER -1)
+          list(GET sizes ${i} size)
+          math(EXPR flash "${flash} + ${size}")
+        endif()
+      endforeach()
+    endif()
+
+    string(APPEND csv "${line},${flash}\n")
+    math(EXPR rows "${rows} + 1")
+  endif()
+endforeach()
+
+if (rows EQUAL 0)
+  message(FATAL_ERROR "no measurements on the simavr console:\n${console}")
+endif()
+
+file(WRITE ${OUTPUT_DIR}/hotpaths.csv "${csv}")
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E cat ${OUTPUT_DIR}/hotpaths.csv ${OUTPUT_DIR}/hotpaths_symbols.csv)
@@ -0,0 +1,311 @@
+/**
+ * \file throughput.cpp
+ * \brief Throughput of the parsers and of the i2c drivers in the host build.
+ *
+ * Every benchmark runs an operation a number of times (1000000 by default, or the first argument of
+ * the program) and prints the operations per second measured with the wall clock of the host. The
+ * drivers run against the device models, so their figures count the work of the driver, Wire and
+ * I2Cdev on the host, not the time of the bus.
+ *
+ * The program returns an error if an operation fails, so a short run checks the benchmarks too.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <smrtobjstrparser.h>
+#include <smrtobjdata.h>
+#include <smrtobji2c.h>
+#include <smrtobji2ctime.h>
+#include <simulation.h>
+#include <models.h>
+
+using namespace smrtobj;
+
+/**
+ * Operation measured: it returns false if it fails.
+ */
+typedef bool (*operation_t)();
+
+//! Benchmarks failed
+static unsigned int g_failed = 0;
+
+static double seconds()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Runs an operation and prints its throughput.
+ *
+ * \param[in] name name of the benchmark
+ * \param[in] op operation
+ * \param[in] n number of operations
+ */
+static void run(const char *name, operation_t op, unsigned long n)
+{
+  bool ok = true;
+  double start = seconds();
+
+  for (unsigned long i = 0; i < n && ok; i++)
+  {
+    ok = op();
+  }
+
+  double elapsed = seconds() - start;
+
+  if (!ok)
+  {
+    printf("%-28s FAILED\n", name);
+    g_failed++;
+    return;
+  }
+
+  printf("%-28s %12.0f ops/s %10.1f ns/op\n", name, n / elapsed, elapsed * 1e9 / n);
+}
+
+/******************************************************************************
+ * Parsers
+ ******************************************************************************/
+static bool parseInt()
+{
+  char str[] = "-31245";
+  int n = 0;
+
+  return parser::StringParser::toInt(str, n) && n == -31245;
+}
+
+static bool parseLong()
+{
+  char str[] = "2147483000";
+  unsigned long n = 0;
+
+  return parser::StringParser::toLong(str, n, sizeof(str)) && n == 2147483000UL;
+}
+
+static bool parseFloat()
+{
+  char str[] = "-1234.5625";
+  float n = 0;
+
+  return parser::StringParser::toFloat(str, n, sizeof(str)) && n == -1234.5625;
+}
+
+static bool tokenize()
+{
+  static const char csv[] = "12,-7,305,,4096,1.5";
+
+  parser::StringTokenizer t(csv, ',');
+  int a, b, c, d;
+  float f;
+
+  return t.next(a) && t.next(b) && t.next(c) && t.skip() && t.next(d) && t.next(f) && d == 4096;
+}
+
+//! NMEA sentences, with checksums computed at start
+static char g_gga[96] = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*";
+static char g_rmc[96] = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*";
+
+static void checksum(char *sentence)
+{
+  uint8_t sum = 0;
+  char *p = sentence + 1;
+
+  for (; *p != '*'; p++)
+  {
+    sum ^= (uint8_t) *p;
+  }
+
+  sprintf(p + 1, "%02X\r\n", sum);
+}
+
+static data::GPSPosition g_position;
+static data::NMEAParser g_nmea(g_position);
+
+static bool decode(const char *sentence)
+{
+  int ret = data::NMEAParser::SENTENCE_PENDING;
+
+  for (const char *c = sentence; *c; c++)
+  {
+    ret = g_nmea.encode(*c);
+
+    if (ret == data::NMEAParser::SENTENCE_VALID)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static bool decodeGGA()
+{
+  return decode(g_gga);
+}
+
+static bool decodeRMC()
+{
+  return decode(g_rmc);
+}
+
+static bool setCoordinates()
+{
+  // Errors are negative
+  return g_position.setLatitude("48.1173") >= 0 && g_position.setLongitude("-11.5166") >= 0;
+}
+
+/******************************************************************************
+ * Drivers
+ ******************************************************************************/
+static i2c::ADS1100 g_ads1100;
+static i2c::HIH7121 g_hih7121;
+static i2c::IAQ2000 g_iaq2000;
+static i2c::T6713 g_t6713;
+static i2c::TCS34725 g_tcs34725;
+static i2c::TCA6507 g_tca6507;
+static i2c::PIC24FV32KA301 g_pic;
+static i2c::DS130RTC g_rtc;
+static i2c::PCA9548A g_mux;
+static i2c::HIH7121 g_routed[2] = { i2c::HIH7121(0x28), i2c::HIH7121(0x28) };
+
+static bool readADS1100() { return g_ads1100.read(); }
+static bool readHIH7121() { return g_hih7121.read(); }
+static bool readIAQ2000() { return g_iaq2000.read(); }
+static bool readT6713() { return g_t6713.read(); }
+static bool readTCS34725() { return g_tcs34725.read(); }
+static bool readTCA6507() { return g_tca6507.read(); }
+static bool readPIC24() { return g_pic.read(); }
+static bool readRTC() { return g_rtc.read(); }
+
+static bool blinkTCA6507()
+{
+  static uint8_t state = i2c::TCA6507::LED_ON;
+
+  state = (state == i2c::TCA6507::LED_ON) ? i2c::TCA6507::LED_OFF : i2c::TCA6507::LED_ON;
+
+  return g_tca6507.pinsSetState(0x7F, state);
+}
+
+static bool nowRTC()
+{
+  sim::advance(1000);
+
+  return g_rtc.now() > 0;
+}
+
+static bool readRouted()
+{
+  static uint8_t n = 0;
+
+  n ^= 1;
+
+  return g_routed[n].read();
+}
+
+static bool queuedHIH7121()
+{
+  if ( !g_hih7121.begin() )
+  {
+    return false;
+  }
+
+  int8_t status;
+
+  while ( (status = g_hih7121.poll()) == i2c::I2CTransaction::QUEUED || status == i2c::I2CTransaction::RUNNING )
+  {
+  }
+
+  return status == i2c::I2CTransaction::DONE;
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned long n = (argc > 1) ? strtoul(argv[1], 0, 10) : 1000000UL;
+
+  if (n == 0)
+  {
+    printf("usage: %s [operations]\n", argv[0]);
+    return 1;
+  }
+
+  sim::setSerialEcho(false);
+
+  checksum(g_gga);
+  checksum(g_rmc);
+
+  printf("%lu operations\n", n);
+
+  run("StringParser::toInt", parseInt, n);
+  run("StringParser::toLong", parseLong, n);
+  run("StringParser::toFloat", parseFloat, n);
+  run("StringTokenizer (6 fields)", tokenize, n);
+  run("NMEAParser GGA", decodeGGA, n);
+  run("NMEAParser RMC", decodeRMC, n);
+  run("GPSPosition coordinates", setCoordinates, n);
+
+  // Board with all the devices
+  sim::ADS1100Model ads1100;
+  sim::HIH7121Model hih7121;
+  sim::IAQ2000Model iaq2000;
+  sim::T6713Model t6713;
+  sim::TCS34725Model tcs34725;
+  sim::TCA6507Model tca6507;
+  sim::PIC24FV32KA301Model pic;
+  sim::DS1307Model rtc;
+  sim::PCA9548AModel mux;
+  sim::HIH7121Model routed[2] = { sim::HIH7121Model(0x28), sim::HIH7121Model(0x28) };
+
+  sim::attach(ads1100);
+  sim::attach(hih7121);
+  sim::attach(iaq2000);
+  sim::attach(t6713);
+  sim::attach(tcs34725);
+  sim::attach(tca6507);
+  sim::attach(pic);
+  sim::attach(rtc);
+  sim::attach(mux);
+
+  // Identical sensors behind the multiplexer, at another address than the one on the bus
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    mux.attach(i, routed[i]);
+    g_routed[i].setPath(&g_mux, i);
+  }
+
+  rtc.setTime(1583020790UL);
+  sim::setAutoStep(100);
+  if ( !g_tcs34725.initialize() || !g_tca6507.initialize() || !g_rtc.startClock() )
+  {
+    printf("initialization failed\n");
+    return 1;
+  }
+  sim::setAutoStep(0);
+
+  run("ADS1100::read", readADS1100, n);
+  run("HIH7121::read", readHIH7121, n);
+  run("IAQ2000::read", readIAQ2000, n);
+  run("T6713::read", readT6713, n);
+  run("TCS34725::read", readTCS34725, n);
+  run("TCA6507::read", readTCA6507, n);
+  run("TCA6507::pinsSetState", blinkTCA6507, n);
+  run("PIC24FV32KA301::read", readPIC24, n);
+  run("DS130RTC::read", readRTC, n);
+  run("DS130RTC::now", nowRTC, n);
+  run("HIH7121::read (2 channels)", readRouted, n);
+
+  i2c::WireBus bus;
+  i2c::I2CQueue::setBus(bus);
+  run("HIH7121::begin/poll", queuedHIH7121, n);
+
+  printf("%lu I2C transfers\n", sim::transfers());
+
+  return (g_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+/**
+ * \file ads1100model.cpp
+ * \brief ADS1100Model is a register level model of the ADS1100 A/D converter (see
+ *        smrtobj::i2c::ADS1100).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "ads1100model.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    ADS1100Model::ADS1100Model(uint8_t addr, float vdd) :
+        smrtobj::i2c::I2CSimDevice(addr),
+        m_vdd(vdd),
+        m_voltage(0),
+        m_config(0x8C)
+    {
+    }
+
+    ADS1100Model::~ADS1100Model()
+    {
+    }
+
+    bool ADS1100Model::write(const uint8_t *data, uint8_t len)
+    {
+      if (len > 0)
+      {
+        // Bits 6 and 5 are always 0
+        m_config = data[len - 1] & 0x9F;
+      }
+
+      return true;
+    }
+
+    bool ADS1100Model::read(uint8_t *data, uint8_t len)
+    {
+      int16_t c = code();
+      uint8_t out[3] = { (uint8_t) (c >> 8), (uint8_t) c, m_config };
+
+      for (uint8_t i = 0; i < len; i++)
+      {
+        data[i] = out[i % 3];
+      }
+
+      return true;
+    }
+
+    int16_t ADS1100Model::code() const
+    {
+      // Data rate 128, 32, 16 and 8 SPS: 12, 14, 15 and 16 bits
+      static const long MIN_CODE[4] = { -2048, -8192, -16384, -32768 };
+
+      long min_code = MIN_CODE[(m_config >> 2) & 0x03];
+      long c = lround(-min_code * (1 << (m_config & 0x03)) * m_voltage / m_vdd);
+
+      return (int16_t) constrain(c, min_code, -min_code - 1);
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
@@ -0,0 +1,88 @@
+/**
+ * \file ads1100model.h
+ * \brief ADS1100Model is a register level model of the ADS1100 A/D converter (see
+ *        smrtobj::i2c::ADS1100).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef ADS1100MODEL_H_
+#define ADS1100MODEL_H_
+
+#include <Arduino.h>
+#include "bus/i2csimbus.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * The ADS1100Model class models the output and the configuration registers of an ADS1100:
+     *   - write: the byte is the configuration register (ST/BSY, SC, DR1:0, PGA1:0);
+     *   - read: output register (MSB first) followed by the configuration register.
+     *
+     * The output code is -MIN_CODE * PGA * V / VDD, where MIN_CODE depends on the data rate (-2048 at
+     * 128 SPS, ..., -32768 at 8 SPS), clipped to the range of the code.
+     */
+    class ADS1100Model : public smrtobj::i2c::I2CSimDevice
+    {
+      public:
+        //! Default device address (ADS1100A0)
+        static const uint8_t DEVICE_ADDRESS = 0x48;
+
+        /**
+         * Constructor. The configuration is the power on one (continuous conversion, 8 SPS, gain 1).
+         *
+         * \param[in] addr device address
+         * \param[in] vdd supply voltage (reference)
+         */
+        ADS1100Model(uint8_t addr = DEVICE_ADDRESS, float vdd = 5.0);
+
+        /**
+         * Destructor.
+         */
+        virtual ~ADS1100Model();
+
+        virtual bool write(const uint8_t *data, uint8_t len);
+
+        virtual bool read(uint8_t *data, uint8_t len);
+
+        /**
+         * Sets the differential input voltage.
+         *
+         * \param[in] v voltage
+         */
+        void setVoltage(float v) { m_voltage = v; }
+
+        /**
+         * Gets the output code for the current input and configuration.
+         *
+         * \return output code
+         */
+        int16_t code() const;
+
+        /**
+         * Gets the configuration register.
+         *
+         * \return configuration
+         */
+        uint8_t config() const { return m_config; }
+
+      private:
+        //! Supply voltage
+        float m_vdd;
+
+        //! Input voltage
+        float m_voltage;
+
+        //! Configuration register
+        uint8_t m_config;
+    };
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* ADS1100MODEL_H_ */
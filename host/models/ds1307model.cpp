@@ -0,0 +1,130 @@
+/**
+ * \file ds1307model.cpp
+ * \brief DS1307Model is a register level model of the DS1307 real time clock (see
+ *        smrtobj::i2c::DS130RTC and smrtobj::i2c::DS130NVRAMLog).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "ds1307model.h"
+#include "simulation.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    namespace
+    {
+      uint8_t bcd(uint8_t n)
+      {
+        return ((n / 10) << 4) | (n % 10);
+      }
+
+      uint8_t dec(uint8_t n)
+      {
+        return (n >> 4) * 10 + (n & 0x0F);
+      }
+    }
+
+    DS1307Model::DS1307Model() :
+        RegisterModel(DEVICE_ADDRESS, REGISTERS),
+        m_epoch(SECS_YR_2000),
+        m_base_us(trueMicros()),
+        m_drift(0),
+        m_halted(false)
+    {
+    }
+
+    DS1307Model::~DS1307Model()
+    {
+    }
+
+    unsigned long long DS1307Model::elapsed() const
+    {
+      long long e = (long long) (trueMicros() - m_base_us);
+
+      return e + (e * m_drift) / 1000000LL;
+    }
+
+    void DS1307Model::setTime(time_t t)
+    {
+      m_epoch = t;
+      m_base_us = trueMicros();
+    }
+
+    time_t DS1307Model::time() const
+    {
+      if (m_halted)
+      {
+        return m_epoch;
+      }
+
+      return m_epoch + (time_t) (elapsed() / 1000000ULL);
+    }
+
+    void DS1307Model::setDrift(long ppm)
+    {
+      // Keep the phase of the second
+      unsigned long long e = elapsed();
+
+      m_epoch += (time_t) (e / 1000000ULL);
+      m_base_us = trueMicros() - (e % 1000000ULL);
+      m_drift = ppm;
+    }
+
+    void DS1307Model::latch()
+    {
+      tmElements_t tm;
+
+      breakTime(time(), tm);
+
+      m_regs[0] = bcd(tm.Second) | (m_halted ? 0x80 : 0x00);
+      m_regs[1] = bcd(tm.Minute);
+      m_regs[2] = bcd(tm.Hour);
+      m_regs[3] = tm.Wday;
+      m_regs[4] = bcd(tm.Day);
+      m_regs[5] = bcd(tm.Month);
+      m_regs[6] = bcd(tmYearToY2k(tm.Year) % 100);
+    }
+
+    void DS1307Model::store(uint8_t reg, uint8_t value)
+    {
+      if (reg > 6)
+      {
+        m_regs[reg] = value;
+        return;
+      }
+
+      time_t before = time();
+      tmElements_t tm;
+
+      latch();
+      m_regs[reg] = value;
+
+      tm.Second = dec(m_regs[0] & 0x7F);
+      tm.Minute = dec(m_regs[1] & 0x7F);
+      tm.Hour = dec(m_regs[2] & 0x3F);
+      tm.Wday = m_regs[3];
+      tm.Day = dec(m_regs[4] & 0x3F);
+      tm.Month = dec(m_regs[5] & 0x1F);
+      tm.Year = y2kYearToTm(dec(m_regs[6]));
+
+      time_t after = makeTime(tm);
+
+      if (reg == 0)
+      {
+        // The divider is reset
+        m_halted = (value & 0x80);
+        setTime(after);
+      }
+      else
+      {
+        m_epoch += after - before;
+      }
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
@@ -0,0 +1,114 @@
+/**
+ * \file ds1307model.h
+ * \brief DS1307Model is a register level model of the DS1307 real time clock (see
+ *        smrtobj::i2c::DS130RTC and smrtobj::i2c::DS130NVRAMLog).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef DS1307MODEL_H_
+#define DS1307MODEL_H_
+
+#include <Time.h>
+#include "registermodel.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * The DS1307Model class models the registers of a DS1307:
+     *   - 0x00 - 0x06: time and date in BCD (24 hour mode), bit 7 of the seconds is the clock halt bit;
+     *   - 0x07: control;
+     *   - 0x08 - 0x3F: battery backed RAM.
+     *
+     * The time follows the true time of the simulation (smrtobj::sim::trueMicros), with the error of
+     * the oscillator of the RTC (see setDrift). The time registers are latched at the start of every
+     * read, and writing the seconds resets the divider of the clock. The day of the week is computed
+     * from the date.
+     *
+     * The register pointer wraps from 0x3F to 0x00.
+     */
+    class DS1307Model : public RegisterModel
+    {
+      public:
+        //! Device address
+        static const uint8_t DEVICE_ADDRESS = 0x68;
+
+        //! First register of the RAM
+        static const uint8_t RAM_START = 0x08;
+
+        //! Number of registers
+        static const uint8_t REGISTERS = 0x40;
+
+        /**
+         * Constructor. The clock is running from 1/1/2000 00:00:00 and the RAM is 0.
+         */
+        DS1307Model();
+
+        /**
+         * Destructor.
+         */
+        virtual ~DS1307Model();
+
+        /**
+         * Sets the time, as written by the master.
+         *
+         * \param[in] t time
+         */
+        void setTime(time_t t);
+
+        /**
+         * Gets the time of the clock.
+         *
+         * \return time
+         */
+        time_t time() const;
+
+        /**
+         * Sets the error of the oscillator of the RTC from now on.
+         *
+         * \param[in] ppm error (in parts per million), positive if the RTC runs fast
+         */
+        void setDrift(long ppm);
+
+        /**
+         * Checks if the clock is halted (CH bit).
+         *
+         * \return true if the clock is halted, false otherwise
+         */
+        bool halted() const { return m_halted; }
+
+      protected:
+        virtual void store(uint8_t reg, uint8_t value);
+
+        virtual void latch();
+
+      private:
+        /**
+         * Gets the time elapsed from the base, according to the oscillator of the RTC.
+         *
+         * \return time (in microseconds)
+         */
+        unsigned long long elapsed() const;
+
+        //! Time at m_base_us
+        time_t m_epoch;
+
+        //! True time of the last change of the clock
+        unsigned long long m_base_us;
+
+        //! Error of the oscillator (in ppm)
+        long m_drift;
+
+        //! Clock halted
+        bool m_halted;
+    };
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* DS1307MODEL_H_ */
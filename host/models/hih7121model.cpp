@@ -0,0 +1,94 @@
+/**
+ * \file hih7121model.cpp
+ * \brief HIH7121Model is a model of the HIH7121 humidity and temperature sensor (see
+ *        smrtobj::i2c::HIH7121).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "hih7121model.h"
+#include "simulation.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    HIH7121Model::HIH7121Model(uint8_t addr) :
+        smrtobj::i2c::I2CSimDevice(addr),
+        m_rh(0),
+        m_t(0),
+        m_humidity(0),
+        m_temperature(0),
+        m_fresh(false),
+        m_converting(false),
+        m_end(0),
+        m_conversions(0)
+    {
+    }
+
+    HIH7121Model::~HIH7121Model()
+    {
+    }
+
+    void HIH7121Model::update()
+    {
+      if ( !m_converting || trueMicros() < m_end )
+      {
+        return;
+      }
+
+      // 14 bits, from 0 to 2^14 - 2
+      long h = lround(m_rh / 100.0 * 16382);
+      long t = lround((m_t + 40.0) / 165.0 * 16382);
+
+      m_humidity = constrain(h, 0L, 16383L);
+      m_temperature = constrain(t, 0L, 16383L);
+      m_fresh = true;
+      m_converting = false;
+    }
+
+    bool HIH7121Model::write(const uint8_t *data, uint8_t len)
+    {
+      (void) data;
+      (void) len;
+
+      update();
+
+      if (!m_converting)
+      {
+        m_converting = true;
+        m_end = trueMicros() + MEASUREMENT_TIME;
+        m_conversions++;
+      }
+
+      return true;
+    }
+
+    bool HIH7121Model::read(uint8_t *data, uint8_t len)
+    {
+      update();
+
+      uint8_t status = m_fresh ? 0 : 1;
+      uint8_t out[4] =
+      {
+        (uint8_t) ((status << 6) | (m_humidity >> 8)),
+        (uint8_t) m_humidity,
+        (uint8_t) (m_temperature >> 6),
+        (uint8_t) (m_temperature << 2)
+      };
+
+      for (uint8_t i = 0; i < len; i++)
+      {
+        data[i] = (i < 4) ? out[i] : 0xFF;
+      }
+
+      m_fresh = false;
+
+      return true;
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
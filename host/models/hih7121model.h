@@ -0,0 +1,104 @@
+/**
+ * \file hih7121model.h
+ * \brief HIH7121Model is a model of the HIH7121 humidity and temperature sensor (see
+ *        smrtobj::i2c::HIH7121).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef HIH7121MODEL_H_
+#define HIH7121MODEL_H_
+
+#include <Arduino.h>
+#include "bus/i2csimbus.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * The HIH7121Model class models the measurement cycle of a HIH7121:
+     *   - a write (measurement request, usually without data) starts a conversion, that ends after
+     *     MEASUREMENT_TIME of true time;
+     *   - a read gives the status (2 bits), the humidity (14 bits) and the temperature (14 bits, left
+     *     aligned) of the last conversion. The status is 0 the first time a conversion is read, 1
+     *     (stale data) after.
+     *
+     * The values converted are the ones set when the conversion ends.
+     */
+    class HIH7121Model : public smrtobj::i2c::I2CSimDevice
+    {
+      public:
+        //! Device address
+        static const uint8_t DEVICE_ADDRESS = 0x27;
+
+        //! Conversion time (in microseconds)
+        static const unsigned long MEASUREMENT_TIME = 36650;
+
+        /**
+         * Constructor. No conversion has been done: the data are 0 and stale.
+         *
+         * \param[in] addr device address
+         */
+        HIH7121Model(uint8_t addr = DEVICE_ADDRESS);
+
+        /**
+         * Destructor.
+         */
+        virtual ~HIH7121Model();
+
+        virtual bool write(const uint8_t *data, uint8_t len);
+
+        virtual bool read(uint8_t *data, uint8_t len);
+
+        /**
+         * Sets the relative humidity. A conversion already ended keeps the previous value.
+         *
+         * \param[in] rh humidity (in %)
+         */
+        void setHumidity(float rh) { update(); m_rh = rh; }
+
+        /**
+         * Sets the temperature. A conversion already ended keeps the previous value.
+         *
+         * \param[in] t temperature (in Celsius degrees)
+         */
+        void setTemperature(float t) { update(); m_t = t; }
+
+        /**
+         * Gets the number of conversions started.
+         *
+         * \return number of conversions
+         */
+        unsigned long conversions() const { return m_conversions; }
+
+      private:
+        //! Ends the conversion in progress, if its time has elapsed
+        void update();
+
+        float m_rh;
+        float m_t;
+
+        //! Data of the last conversion
+        uint16_t m_humidity;
+        uint16_t m_temperature;
+
+        //! Data of the last conversion not read yet
+        bool m_fresh;
+
+        //! Conversion in progress
+        bool m_converting;
+
+        //! True time of the end of the conversion
+        unsigned long long m_end;
+
+        unsigned long m_conversions;
+    };
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* HIH7121MODEL_H_ */
@@ -0,0 +1,65 @@
+/**
+ * \file iaq2000model.cpp
+ * \brief IAQ2000Model is a model of the iAQ-2000 indoor air quality sensor (see smrtobj::i2c::IAQ2000).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "iaq2000model.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    IAQ2000Model::IAQ2000Model(uint8_t addr) :
+        smrtobj::i2c::I2CSimDevice(addr),
+        m_prediction(450),
+        m_status(OK),
+        m_resistance(0),
+        m_tvoc(125)
+    {
+    }
+
+    IAQ2000Model::~IAQ2000Model()
+    {
+    }
+
+    void IAQ2000Model::set(uint16_t prediction, uint16_t tvoc, uint32_t resistance, uint8_t status)
+    {
+      m_prediction = prediction;
+      m_tvoc = tvoc;
+      m_resistance = resistance;
+      m_status = status;
+    }
+
+    bool IAQ2000Model::write(const uint8_t *data, uint8_t len)
+    {
+      (void) data;
+
+      return (len == 0);
+    }
+
+    bool IAQ2000Model::read(uint8_t *data, uint8_t len)
+    {
+      uint8_t out[9] =
+      {
+        (uint8_t) (m_prediction >> 8), (uint8_t) m_prediction,
+        m_status,
+        (uint8_t) (m_resistance >> 24), (uint8_t) (m_resistance >> 16),
+        (uint8_t) (m_resistance >> 8), (uint8_t) m_resistance,
+        (uint8_t) (m_tvoc >> 8), (uint8_t) m_tvoc
+      };
+
+      for (uint8_t i = 0; i < len; i++)
+      {
+        data[i] = (i < 9) ? out[i] : 0xFF;
+      }
+
+      return true;
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
@@ -0,0 +1,85 @@
+/**
+ * \file iaq2000model.h
+ * \brief IAQ2000Model is a model of the iAQ-2000 indoor air quality sensor (see smrtobj::i2c::IAQ2000).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef IAQ2000MODEL_H_
+#define IAQ2000MODEL_H_
+
+#include <Arduino.h>
+#include "bus/i2csimbus.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * The IAQ2000Model class models the data of an iAQ-2000. The device is read only: a read gives
+     * the prediction (CO2 equivalent ppm, 2 bytes), the status (1 byte), the resistance of the sensor
+     * (4 bytes) and the TVOC equivalent ppb (2 bytes), MSB first. Writes with data are not
+     * acknowledged.
+     */
+    class IAQ2000Model : public smrtobj::i2c::I2CSimDevice
+    {
+      public:
+        //! Device address
+        static const uint8_t DEVICE_ADDRESS = 0x5A;
+
+        //! Status of the device
+        enum _status
+        {
+          //! Data valid
+          OK = 0x00,
+
+          //! Warming up
+          RUNIN = 0x10,
+
+          //! Busy
+          BUSY = 0x01,
+
+          //! Error
+          ERROR = 0x80,
+        };
+
+        /**
+         * Constructor. The prediction is 450 ppm, the minimum of the sensor.
+         *
+         * \param[in] addr device address
+         */
+        IAQ2000Model(uint8_t addr = DEVICE_ADDRESS);
+
+        /**
+         * Destructor.
+         */
+        virtual ~IAQ2000Model();
+
+        virtual bool write(const uint8_t *data, uint8_t len);
+
+        virtual bool read(uint8_t *data, uint8_t len);
+
+        /**
+         * Sets the data of the sensor.
+         *
+         * \param[in] prediction CO2 equivalent (in ppm)
+         * \param[in] tvoc TVOC equivalent (in ppb)
+         * \param[in] resistance resistance of the sensor (in ohm)
+         * \param[in] status status (see smrtobj::sim::IAQ2000Model::_status)
+         */
+        void set(uint16_t prediction, uint16_t tvoc, uint32_t resistance, uint8_t status = OK);
+
+      private:
+        uint16_t m_prediction;
+        uint8_t m_status;
+        uint32_t m_resistance;
+        uint16_t m_tvoc;
+    };
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* IAQ2000MODEL_H_ */
@@ -0,0 +1,22 @@
+/**
+ * \file models.h
+ * \brief Models of the i2c devices handled by the SmrtObj libraries, for the host build.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef MODELS_H_
+#define MODELS_H_
+
+#include "registermodel.h"
+#include "ads1100model.h"
+#include "hih7121model.h"
+#include "iaq2000model.h"
+#include "t6713model.h"
+#include "tcs34725model.h"
+#include "pca9548amodel.h"
+#include "tca6507model.h"
+#include "pic24fv32ka301model.h"
+#include "ds1307model.h"
+
+#endif /* MODELS_H_ */
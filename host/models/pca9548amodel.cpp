@@ -0,0 +1,82 @@
+/**
+ * \file pca9548amodel.cpp
+ * \brief PCA9548AModel is a model of the PCA9548A i2c multiplexer (see smrtobj::i2c::PCA9548A).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "pca9548amodel.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    PCA9548AModel::PCA9548AModel(uint8_t addr) :
+        I2CSimMux(addr),
+        m_control(0),
+        m_selections(0)
+    {
+      memset(m_count, 0, sizeof(m_count));
+    }
+
+    PCA9548AModel::~PCA9548AModel()
+    {
+    }
+
+    bool PCA9548AModel::write(const uint8_t *data, uint8_t len)
+    {
+      if (len > 0)
+      {
+        // The last byte received is the one latched
+        m_control = data[len - 1];
+        m_selections++;
+      }
+
+      return true;
+    }
+
+    bool PCA9548AModel::read(uint8_t *data, uint8_t len)
+    {
+      memset(data, m_control, len);
+
+      return true;
+    }
+
+    smrtobj::i2c::I2CSimDevice * PCA9548AModel::find(uint8_t addr)
+    {
+      for (uint8_t ch = 0; ch < CHANNELS; ch++)
+      {
+        if ( !(m_control & (1 << ch)) )
+        {
+          continue;
+        }
+
+        for (uint8_t i = 0; i < m_count[ch]; i++)
+        {
+          if (m_devices[ch][i]->address() == addr)
+          {
+            return m_devices[ch][i];
+          }
+        }
+      }
+
+      return 0;
+    }
+
+    bool PCA9548AModel::attach(uint8_t channel, smrtobj::i2c::I2CSimDevice &d)
+    {
+      if (channel >= CHANNELS || m_count[channel] >= MAX_DEVICES)
+      {
+        return false;
+      }
+
+      m_devices[channel][m_count[channel]++] = &d;
+
+      return true;
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
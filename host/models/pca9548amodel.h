@@ -0,0 +1,104 @@
+/**
+ * \file pca9548amodel.h
+ * \brief PCA9548AModel is a model of the PCA9548A i2c multiplexer (see smrtobj::i2c::PCA9548A).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef PCA9548AMODEL_H_
+#define PCA9548AMODEL_H_
+
+#include "simulation.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * The PCA9548AModel class models a PCA9548A: the control register (one bit per channel) is written
+     * and read without register address, and the devices of the enabled channels are connected to
+     * the bus. Devices with the same address can be connected to different channels.
+     *
+     * \code{.cpp}
+     * smrtobj::sim::PCA9548AModel mux;
+     * smrtobj::sim::HIH7121Model rh[2];
+     *
+     * mux.attach(0, rh[0]);
+     * mux.attach(1, rh[1]);
+     * smrtobj::sim::attach(mux);
+     * \endcode
+     */
+    class PCA9548AModel : public I2CSimMux
+    {
+      public:
+        //! Default device address
+        static const uint8_t DEVICE_ADDRESS = 0x70;
+
+        //! Number of channels
+        static const uint8_t CHANNELS = 8;
+
+        //! Maximum number of devices on a channel
+        static const uint8_t MAX_DEVICES = 4;
+
+        /**
+         * Constructor. All channels are disabled.
+         *
+         * \param[in] addr device address
+         */
+        PCA9548AModel(uint8_t addr = DEVICE_ADDRESS);
+
+        /**
+         * Destructor.
+         */
+        virtual ~PCA9548AModel();
+
+        virtual bool write(const uint8_t *data, uint8_t len);
+
+        virtual bool read(uint8_t *data, uint8_t len);
+
+        virtual smrtobj::i2c::I2CSimDevice * find(uint8_t addr);
+
+        /**
+         * Connects a device to a channel.
+         *
+         * \param[in] channel channel (0 - 7)
+         * \param[in] d device
+         *
+         * \return false if the channel is not valid or it has already MAX_DEVICES devices, true otherwise
+         */
+        bool attach(uint8_t channel, smrtobj::i2c::I2CSimDevice &d);
+
+        /**
+         * Gets the control register.
+         *
+         * \return enabled channels (bit n for channel n)
+         */
+        uint8_t control() const { return m_control; }
+
+        /**
+         * Gets the number of writes of the control register.
+         *
+         * \return number of writes
+         */
+        unsigned long selections() const { return m_selections; }
+
+      private:
+        //! Devices of each channel
+        smrtobj::i2c::I2CSimDevice *m_devices[CHANNELS][MAX_DEVICES];
+
+        //! Number of devices of each channel
+        uint8_t m_count[CHANNELS];
+
+        //! Control register
+        uint8_t m_control;
+
+        unsigned long m_selections;
+    };
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* PCA9548AMODEL_H_ */
@@ -0,0 +1,67 @@
+/**
+ * \file pic24fv32ka301model.cpp
+ * \brief PIC24FV32KA301Model is a model of the firmware of the PIC24FV32KA301 that acquires the
+ *        radiation and dust sensors (see smrtobj::i2c::PIC24FV32KA301).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "pic24fv32ka301model.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    PIC24FV32KA301Model::PIC24FV32KA301Model(uint8_t addr) :
+        smrtobj::i2c::I2CSimDevice(addr)
+    {
+      memset(m_data, 0, sizeof(m_data));
+      memset(m_cfg, 0, sizeof(m_cfg));
+      memset(m_state, 0, sizeof(m_state));
+    }
+
+    PIC24FV32KA301Model::~PIC24FV32KA301Model()
+    {
+    }
+
+    bool PIC24FV32KA301Model::write(const uint8_t *data, uint8_t len)
+    {
+      if (len == 0)
+      {
+        return true;
+      }
+
+      if (len != 2 || data[0] >= N_SENS)
+      {
+        return false;
+      }
+
+      m_cfg[data[0]] = data[1];
+      m_state[data[0]] = (data[1] & 0x80) ? 0x01 : 0x00;
+
+      return true;
+    }
+
+    bool PIC24FV32KA301Model::read(uint8_t *data, uint8_t len)
+    {
+      uint8_t out[4 * N_SENS] =
+      {
+        (uint8_t) (m_data[RAD] >> 8), (uint8_t) m_data[RAD],
+        (uint8_t) (m_data[PM] >> 8), (uint8_t) m_data[PM],
+        m_cfg[RAD], m_cfg[PM],
+        m_state[RAD], m_state[PM]
+      };
+
+      for (uint8_t i = 0; i < len; i++)
+      {
+        data[i] = (i < sizeof(out)) ? out[i] : 0xFF;
+      }
+
+      return true;
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
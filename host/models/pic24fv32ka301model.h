@@ -0,0 +1,94 @@
+/**
+ * \file pic24fv32ka301model.h
+ * \brief PIC24FV32KA301Model is a model of the firmware of the PIC24FV32KA301 that acquires the
+ *        radiation and dust sensors (see smrtobj::i2c::PIC24FV32KA301).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef PIC24FV32KA301MODEL_H_
+#define PIC24FV32KA301MODEL_H_
+
+#include <Arduino.h>
+#include "bus/i2csimbus.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * The PIC24FV32KA301Model class models the i2c interface of the acquisition firmware:
+     *   - a write of 2 bytes sets a configuration register (0 radiation, 1 dust): bit 7 enables the
+     *     sensor, bits 4:0 are the sampling time. The state of the sensor follows the enable bit;
+     *   - a read gives 8 bytes: the data of the two sensors (MSB first), the two configuration
+     *     registers and the two state registers.
+     */
+    class PIC24FV32KA301Model : public smrtobj::i2c::I2CSimDevice
+    {
+      public:
+        //! Device address
+        static const uint8_t DEVICE_ADDRESS = 0x10;
+
+        //! Sensors
+        enum _sensor
+        {
+          RAD = 0,
+          PM = 1,
+          N_SENS = 2,
+        };
+
+        /**
+         * Constructor. The sensors are disabled.
+         *
+         * \param[in] addr device address
+         */
+        PIC24FV32KA301Model(uint8_t addr = DEVICE_ADDRESS);
+
+        /**
+         * Destructor.
+         */
+        virtual ~PIC24FV32KA301Model();
+
+        virtual bool write(const uint8_t *data, uint8_t len);
+
+        virtual bool read(uint8_t *data, uint8_t len);
+
+        /**
+         * Sets the data of a sensor.
+         *
+         * \param[in] code sensor
+         * \param[in] value data
+         */
+        void setData(uint8_t code, uint16_t value) { if (code < N_SENS) m_data[code] = value; }
+
+        /**
+         * Gets the configuration register of a sensor.
+         *
+         * \param[in] code sensor
+         *
+         * \return configuration
+         */
+        uint8_t cfg(uint8_t code) const { return (code < N_SENS) ? m_cfg[code] : 0; }
+
+        /**
+         * Gets the state register of a sensor.
+         *
+         * \param[in] code sensor
+         *
+         * \return state
+         */
+        uint8_t state(uint8_t code) const { return (code < N_SENS) ? m_state[code] : 0; }
+
+      private:
+        uint16_t m_data[N_SENS];
+        uint8_t m_cfg[N_SENS];
+        uint8_t m_state[N_SENS];
+    };
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* PIC24FV32KA301MODEL_H_ */
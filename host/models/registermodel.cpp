@@ -0,0 +1,116 @@
+/**
+ * \file registermodel.cpp
+ * \brief RegisterModel is a base class to model an i2c device with a file of registers and a register
+ *        pointer.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "registermodel.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    RegisterModel::RegisterModel(uint8_t addr, uint8_t size) :
+        smrtobj::i2c::I2CSimDevice(addr),
+        m_size( (size < MAX_REGISTERS) ? size : MAX_REGISTERS ),
+        m_pointer(0),
+        m_increment(true),
+        m_writes(0),
+        m_reads(0),
+        m_stored(0),
+        m_limit(-1)
+    {
+      memset(m_regs, 0, sizeof(m_regs));
+    }
+
+    RegisterModel::~RegisterModel()
+    {
+    }
+
+    bool RegisterModel::write(const uint8_t *data, uint8_t len)
+    {
+      m_writes++;
+
+      if (len == 0)
+      {
+        return true;
+      }
+
+      if ( !command(data[0]) )
+      {
+        return false;
+      }
+
+      for (uint8_t i = 1; i < len; i++)
+      {
+        if (m_limit == 0)
+        {
+          return false;
+        }
+
+        if (m_limit > 0)
+        {
+          m_limit--;
+        }
+
+        store(m_pointer, data[i]);
+        m_stored++;
+
+        if (m_increment)
+        {
+          m_pointer = next(m_pointer);
+        }
+      }
+
+      return true;
+    }
+
+    bool RegisterModel::read(uint8_t *data, uint8_t len)
+    {
+      m_reads++;
+
+      latch();
+
+      for (uint8_t i = 0; i < len; i++)
+      {
+        data[i] = load(m_pointer);
+
+        if (m_increment)
+        {
+          m_pointer = next(m_pointer);
+        }
+      }
+
+      return true;
+    }
+
+    bool RegisterModel::command(uint8_t cmd)
+    {
+      if (cmd >= m_size)
+      {
+        return false;
+      }
+
+      m_pointer = cmd;
+      m_increment = true;
+
+      return true;
+    }
+
+    void RegisterModel::store(uint8_t reg, uint8_t value)
+    {
+      m_regs[reg] = value;
+    }
+
+    uint8_t RegisterModel::load(uint8_t reg)
+    {
+      return m_regs[reg];
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
@@ -0,0 +1,197 @@
+/**
+ * \file registermodel.h
+ * \brief RegisterModel is a base class to model an i2c device with a file of registers and a register
+ *        pointer.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef REGISTERMODEL_H_
+#define REGISTERMODEL_H_
+
+#include <Arduino.h>
+#include "bus/i2csimbus.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * The RegisterModel class models the usual protocol of register based devices:
+     *   - the first byte written is a command that sets the register pointer (see command);
+     *   - the next bytes written are stored starting from the pointer;
+     *   - bytes are read starting from the pointer.
+     *
+     * The pointer is incremented after each byte, unless the command disables it, and it goes back to 0
+     * after the last register (see next). Derived classes change the behavior of single registers with
+     * load and store.
+     *
+     * Power failures are simulated by limiting the number of bytes stored (see setWriteLimit): when the
+     * limit is reached, the following bytes are lost and the write is not acknowledged.
+     */
+    class RegisterModel : public smrtobj::i2c::I2CSimDevice
+    {
+      public:
+        //! Maximum number of registers
+        static const uint8_t MAX_REGISTERS = 64;
+
+        /**
+         * Constructor. All registers are 0.
+         *
+         * \param[in] addr device address
+         * \param[in] size number of registers (at most MAX_REGISTERS)
+         */
+        RegisterModel(uint8_t addr, uint8_t size);
+
+        /**
+         * Destructor.
+         */
+        virtual ~RegisterModel();
+
+        /**
+         * Receives a command and the data to store.
+         *
+         * \param[in] data data written
+         * \param[in] len number of bytes
+         *
+         * \return false if the command is not valid or the write limit is reached, true otherwise
+         */
+        virtual bool write(const uint8_t *data, uint8_t len);
+
+        /**
+         * Gives the registers starting from the pointer.
+         *
+         * \param[out] data data read
+         * \param[in] len number of bytes
+         *
+         * \return always true
+         */
+        virtual bool read(uint8_t *data, uint8_t len);
+
+        /**
+         * Gets the content of a register, as stored (without calling load).
+         *
+         * \param[in] reg register
+         *
+         * \return value
+         */
+        uint8_t reg(uint8_t reg) const { return (reg < m_size) ? m_regs[reg] : 0; }
+
+        /**
+         * Sets the content of a register, without calling store.
+         *
+         * \param[in] reg register
+         * \param[in] value value
+         */
+        void setReg(uint8_t reg, uint8_t value) { if (reg < m_size) m_regs[reg] = value; }
+
+        /**
+         * Gets the register pointer.
+         *
+         * \return register
+         */
+        uint8_t pointer() const { return m_pointer; }
+
+        /**
+         * Gets the number of writes received (including the ones without data).
+         *
+         * \return number of writes
+         */
+        unsigned long writes() const { return m_writes; }
+
+        /**
+         * Gets the number of reads received.
+         *
+         * \return number of reads
+         */
+        unsigned long reads() const { return m_reads; }
+
+        /**
+         * Gets the number of bytes stored in the registers.
+         *
+         * \return number of bytes
+         */
+        unsigned long stored() const { return m_stored; }
+
+        /**
+         * Limits the number of bytes stored from now on.
+         *
+         * \param[in] n number of bytes, negative for no limit
+         */
+        void setWriteLimit(long n) { m_limit = n; }
+
+      protected:
+        /**
+         * Decodes the command byte. By default it is the address of the register and the pointer is
+         * incremented.
+         *
+         * \param[in] cmd command
+         *
+         * \return false if the command is not valid (the write is not acknowledged), true otherwise
+         */
+        virtual bool command(uint8_t cmd);
+
+        /**
+         * Stores a byte written by the master. By default the register is set.
+         *
+         * \param[in] reg register
+         * \param[in] value value
+         */
+        virtual void store(uint8_t reg, uint8_t value);
+
+        /**
+         * Gives a byte read by the master. By default it is the content of the register.
+         *
+         * \param[in] reg register
+         *
+         * \return value
+         */
+        virtual uint8_t load(uint8_t reg);
+
+        /**
+         * Called at the start of every read (e.g. to latch a counter).
+         */
+        virtual void latch() {}
+
+        /**
+         * Gets the register following another one. By default the registers wrap around.
+         *
+         * \param[in] reg register
+         *
+         * \return next register
+         */
+        virtual uint8_t next(uint8_t reg) { return (reg + 1 < m_size) ? reg + 1 : 0; }
+
+        //! Registers
+        uint8_t m_regs[MAX_REGISTERS];
+
+        //! Number of registers
+        uint8_t m_size;
+
+        //! Register pointer
+        uint8_t m_pointer;
+
+        //! Increment the pointer after each byte
+        bool m_increment;
+
+      private:
+        //! Number of writes
+        unsigned long m_writes;
+
+        //! Number of reads
+        unsigned long m_reads;
+
+        //! Number of bytes stored
+        unsigned long m_stored;
+
+        //! Bytes that can still be stored, negative for no limit
+        long m_limit;
+    };
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* REGISTERMODEL_H_ */
@@ -0,0 +1,87 @@
+/**
+ * \file t6713model.cpp
+ * \brief T6713Model is a model of the T6713 CO2 sensor (see smrtobj::i2c::T6713).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "t6713model.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    T6713Model::T6713Model(uint8_t addr) :
+        smrtobj::i2c::I2CSimDevice(addr),
+        m_ppm(0),
+        m_status(0),
+        m_firmware(0x0100),
+        m_commands(0)
+    {
+      memset(m_response, 0, sizeof(m_response));
+    }
+
+    T6713Model::~T6713Model()
+    {
+    }
+
+    bool T6713Model::write(const uint8_t *data, uint8_t len)
+    {
+      if (len == 0)
+      {
+        return true;
+      }
+
+      if (len != 5)
+      {
+        return false;
+      }
+
+      m_commands++;
+
+      uint16_t reg = (data[1] << 8) | data[2];
+      uint16_t count = (data[3] << 8) | data[4];
+      uint16_t value = 0;
+      bool valid = (data[0] == 0x04 && count == 1);
+
+      switch (reg)
+      {
+        case FIRMWARE: value = m_firmware; break;
+        case STATUS: value = m_status; break;
+        case GAS_PPM: value = m_ppm; break;
+        default: valid = false;
+      }
+
+      if (valid)
+      {
+        m_response[0] = 0x04;
+        m_response[1] = 0x02;
+        m_response[2] = value >> 8;
+        m_response[3] = value;
+      }
+      else
+      {
+        m_response[0] = data[0] | 0x80;
+        m_response[1] = 0x02;
+        m_response[2] = 0;
+        m_response[3] = 0;
+      }
+
+      return true;
+    }
+
+    bool T6713Model::read(uint8_t *data, uint8_t len)
+    {
+      for (uint8_t i = 0; i < len; i++)
+      {
+        data[i] = (i < 4) ? m_response[i] : 0xFF;
+      }
+
+      return true;
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
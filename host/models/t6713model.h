@@ -0,0 +1,102 @@
+/**
+ * \file t6713model.h
+ * \brief T6713Model is a model of the T6713 CO2 sensor (see smrtobj::i2c::T6713).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef T6713MODEL_H_
+#define T6713MODEL_H_
+
+#include <Arduino.h>
+#include "bus/i2csimbus.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * The T6713Model class models the Modbus-like protocol of a T6713:
+     *   - a command of 5 bytes (function code 0x04, register address, number of registers) selects the
+     *     register to read;
+     *   - a read gives the response: function code, number of bytes (2) and value, MSB first.
+     *
+     * Unknown functions and registers give an exception response (function code | 0x80, 0x02).
+     * Writes without data do not change the pending response.
+     */
+    class T6713Model : public smrtobj::i2c::I2CSimDevice
+    {
+      public:
+        //! Device address
+        static const uint8_t DEVICE_ADDRESS = 0x15;
+
+        //! Registers
+        enum _register
+        {
+          FIRMWARE = 0x1389,
+          STATUS = 0x138A,
+          GAS_PPM = 0x138B,
+        };
+
+        /**
+         * Constructor.
+         *
+         * \param[in] addr device address
+         */
+        T6713Model(uint8_t addr = DEVICE_ADDRESS);
+
+        /**
+         * Destructor.
+         */
+        virtual ~T6713Model();
+
+        virtual bool write(const uint8_t *data, uint8_t len);
+
+        virtual bool read(uint8_t *data, uint8_t len);
+
+        /**
+         * Sets the CO2 concentration.
+         *
+         * \param[in] ppm concentration (in ppm)
+         */
+        void setPpm(uint16_t ppm) { m_ppm = ppm; }
+
+        /**
+         * Sets the status register.
+         *
+         * \param[in] status status
+         */
+        void setStatus(uint16_t status) { m_status = status; }
+
+        /**
+         * Sets the firmware version.
+         *
+         * \param[in] version version
+         */
+        void setFirmware(uint16_t version) { m_firmware = version; }
+
+        /**
+         * Gets the number of commands received.
+         *
+         * \return number of commands
+         */
+        unsigned long commands() const { return m_commands; }
+
+      private:
+        uint16_t m_ppm;
+        uint16_t m_status;
+        uint16_t m_firmware;
+
+        //! Response to the last command
+        uint8_t m_response[4];
+
+        unsigned long m_commands;
+    };
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* T6713MODEL_H_ */
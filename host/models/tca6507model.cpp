@@ -0,0 +1,53 @@
+/**
+ * \file tca6507model.cpp
+ * \brief TCA6507Model is a register level model of the TCA6507 LED driver (see
+ *        smrtobj::i2c::TCA6507).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "tca6507model.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    TCA6507Model::TCA6507Model() :
+        RegisterModel(DEVICE_ADDRESS, REGISTERS)
+    {
+    }
+
+    TCA6507Model::~TCA6507Model()
+    {
+    }
+
+    bool TCA6507Model::command(uint8_t cmd)
+    {
+      uint8_t reg = cmd & 0x0F;
+
+      if (reg >= m_size)
+      {
+        return false;
+      }
+
+      m_pointer = reg;
+      m_increment = (cmd & 0x10);
+
+      return true;
+    }
+
+    uint8_t TCA6507Model::state(uint8_t pin) const
+    {
+      if (pin >= OUTPUTS)
+      {
+        return 0;
+      }
+
+      return ((m_regs[0] >> pin) & 0x01) | (((m_regs[1] >> pin) & 0x01) << 1) | (((m_regs[2] >> pin) & 0x01) << 2);
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
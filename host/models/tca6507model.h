@@ -0,0 +1,66 @@
+/**
+ * \file tca6507model.h
+ * \brief TCA6507Model is a register level model of the TCA6507 LED driver (see
+ *        smrtobj::i2c::TCA6507).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef TCA6507MODEL_H_
+#define TCA6507MODEL_H_
+
+#include "registermodel.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * The TCA6507Model class models the 11 registers of a TCA6507. The command byte has the auto
+     * increment bit (0x10) and the register address (bits 3:0); with auto increment the pointer goes
+     * back to 0 after the last register. Commands with an address above 0x0A are not acknowledged.
+     *
+     * The state of each output is given by its bits in the three select registers (see state).
+     */
+    class TCA6507Model : public RegisterModel
+    {
+      public:
+        //! Device address
+        static const uint8_t DEVICE_ADDRESS = 0x45;
+
+        //! Number of registers
+        static const uint8_t REGISTERS = 11;
+
+        //! Number of outputs
+        static const uint8_t OUTPUTS = 7;
+
+        /**
+         * Constructor. All registers are 0 (all outputs off).
+         */
+        TCA6507Model();
+
+        /**
+         * Destructor.
+         */
+        virtual ~TCA6507Model();
+
+        /**
+         * Gets the state of an output (e.g. 0 off, 4 fully on, 6 blinking with bank 0).
+         *
+         * \param[in] pin output (0 - 6)
+         *
+         * \return state (0 - 7)
+         */
+        uint8_t state(uint8_t pin) const;
+
+      protected:
+        virtual bool command(uint8_t cmd);
+    };
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* TCA6507MODEL_H_ */
@@ -0,0 +1,81 @@
+/**
+ * \file tcs34725model.cpp
+ * \brief TCS34725Model is a register level model of the TCS34725 color sensor (see
+ *        smrtobj::i2c::TCS34725).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "tcs34725model.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    TCS34725Model::TCS34725Model() :
+        RegisterModel(DEVICE_ADDRESS, 0x1C)
+    {
+      m_regs[ATIME] = 0xFF;
+      m_regs[WTIME] = 0xFF;
+      m_regs[ID] = 0x44;
+
+      memset(m_color, 0, sizeof(m_color));
+    }
+
+    TCS34725Model::~TCS34725Model()
+    {
+    }
+
+    void TCS34725Model::setColor(uint16_t clear, uint16_t red, uint16_t green, uint16_t blue)
+    {
+      m_color[0] = clear;
+      m_color[1] = red;
+      m_color[2] = green;
+      m_color[3] = blue;
+    }
+
+    bool TCS34725Model::command(uint8_t cmd)
+    {
+      uint8_t reg = cmd & 0x1F;
+
+      if ( !(cmd & 0x80) || reg >= m_size )
+      {
+        return false;
+      }
+
+      m_pointer = reg;
+      m_increment = ( ((cmd >> 5) & 0x03) == 0x01 );
+
+      return true;
+    }
+
+    void TCS34725Model::store(uint8_t reg, uint8_t value)
+    {
+      if (reg < ID)
+      {
+        m_regs[reg] = value;
+      }
+    }
+
+    void TCS34725Model::latch()
+    {
+      // PON and AEN
+      if ( (m_regs[ENABLE] & 0x03) != 0x03 )
+      {
+        return;
+      }
+
+      for (uint8_t i = 0; i < 4; i++)
+      {
+        m_regs[CDATAL + 2 * i] = (uint8_t) m_color[i];
+        m_regs[CDATAL + 2 * i + 1] = (uint8_t) (m_color[i] >> 8);
+      }
+
+      m_regs[STATUS] |= 0x01;
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
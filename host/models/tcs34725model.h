@@ -0,0 +1,85 @@
+/**
+ * \file tcs34725model.h
+ * \brief TCS34725Model is a register level model of the TCS34725 color sensor (see
+ *        smrtobj::i2c::TCS34725).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef TCS34725MODEL_H_
+#define TCS34725MODEL_H_
+
+#include "registermodel.h"
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * The TCS34725Model class models the registers of a TCS34725 (0x00 - 0x1B). The command byte has
+     * the command bit (0x80, writes without it are not acknowledged), the transaction type (bits 6:5,
+     * 01 for auto increment) and the register address (bits 4:0).
+     *
+     * The ID register (0x12) is 0x44 and the registers from 0x12 are read only. The color set by the
+     * test is copied in the data registers (clear, red, green and blue, LSB first) at every read, if
+     * the oscillator and the ADC are enabled (PON and AEN bits of the enable register); the valid bit
+     * of the status register is set too.
+     */
+    class TCS34725Model : public RegisterModel
+    {
+      public:
+        //! Device address
+        static const uint8_t DEVICE_ADDRESS = 0x29;
+
+        //! Registers
+        enum _register
+        {
+          ENABLE = 0x00,
+          ATIME = 0x01,
+          WTIME = 0x03,
+          CONFIG = 0x0D,
+          CONTROL = 0x0F,
+          ID = 0x12,
+          STATUS = 0x13,
+          CDATAL = 0x14,
+        };
+
+        /**
+         * Constructor. The device is disabled.
+         */
+        TCS34725Model();
+
+        /**
+         * Destructor.
+         */
+        virtual ~TCS34725Model();
+
+        /**
+         * Sets the light on the sensor.
+         *
+         * \param[in] clear clear channel
+         * \param[in] red red channel
+         * \param[in] green green channel
+         * \param[in] blue blue channel
+         */
+        void setColor(uint16_t clear, uint16_t red, uint16_t green, uint16_t blue);
+
+      protected:
+        virtual bool command(uint8_t cmd);
+
+        virtual void store(uint8_t reg, uint8_t value);
+
+        virtual void latch();
+
+      private:
+        //! Color (clear, red, green and blue)
+        uint16_t m_color[4];
+    };
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* TCS34725MODEL_H_ */
@@ -0,0 +1,203 @@
+/**
+ * \file Arduino.h
+ * \brief Arduino core for the host build: the subset of the Arduino API used by the SmrtObj libraries,
+ *        backed by the simulation of smrtobj::sim (pins, ADC, clock and serial port).
+ *
+ * Differences from an AVR board:
+ *   - int is 32 bits and long is 64 bits, so millis() and micros() do not roll over after 49 days
+ *     and 70 minutes;
+ *   - the AVR registers (ADCSRA, TWCR, SREG, ...) are not defined: the libraries use their portable
+ *     code paths (e.g. analogRead instead of ADCSampler, WireBus instead of TWIBus);
+ *   - PROGMEM data is kept in RAM;
+ *   - the EEPROM (1 KB, as the one of the ATmega328P) is kept in RAM and it is erased by
+ *     smrtobj::sim::reset.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef ARDUINO_H_
+#define ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+
+#include <avr/pgmspace.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define DEFAULT 1
+#define EXTERNAL 0
+#define INTERNAL 3
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+//! Digital pins of the simulated board (an Arduino Uno with A6 and A7)
+#define NUM_DIGITAL_PINS 22
+
+//! Analog inputs of the simulated board
+#define NUM_ANALOG_INPUTS 8
+
+//! Last address of the EEPROM of the simulated board (see avr/eeprom.h)
+#define E2END 0x3FF
+
+#define LED_BUILTIN 13
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+#define A6 20
+#define A7 21
+
+#define analogInputToDigitalPin(p) (((p) < NUM_ANALOG_INPUTS) ? (p) + A0 : -1)
+
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+
+#define bit(b) (1UL << (b))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+
+#ifndef _BV
+#define _BV(b) (1 << (b))
+#endif
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define sq(x) ((x) * (x))
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+
+#define interrupts()
+#define noInterrupts()
+
+template <class T, class U>
+inline T min(const T &a, const U &b) { return (b < a) ? b : a; }
+
+template <class T, class U>
+inline T max(const T &a, const U &b) { return (a < b) ? b : a; }
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogReference(uint8_t mode);
+void analogWrite(uint8_t pin, int val);
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+char *dtostrf(double val, signed char width, unsigned char prec, char *sout);
+
+inline bool isDigit(int c) { return isdigit(c) != 0; }
+inline bool isAlpha(int c) { return isalpha(c) != 0; }
+inline bool isAlphaNumeric(int c) { return isalnum(c) != 0; }
+inline bool isSpace(int c) { return isspace(c) != 0; }
+inline bool isWhitespace(int c) { return c == ' ' || c == '\t'; }
+inline bool isUpperCase(int c) { return isupper(c) != 0; }
+inline bool isLowerCase(int c) { return islower(c) != 0; }
+inline bool isHexadecimalDigit(int c) { return isxdigit(c) != 0; }
+inline bool isPrintable(int c) { return isprint(c) != 0; }
+
+/**
+ * Flash strings (see F()). In the host build they are ordinary strings.
+ */
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+/**
+ * Base class of the character outputs, as the one of the Arduino core.
+ */
+class Print
+{
+  public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t *buffer, size_t size);
+
+    size_t write(const char *str) { return str ? write((const uint8_t *) str, strlen(str)) : 0; }
+
+    size_t print(const __FlashStringHelper *s) { return write((const char *) s); }
+    size_t print(const char s[]) { return write(s); }
+    size_t print(char c) { return write((uint8_t) c); }
+    size_t print(unsigned char n, int base = DEC) { return print((unsigned long) n, base); }
+    size_t print(int n, int base = DEC) { return print((long) n, base); }
+    size_t print(unsigned int n, int base = DEC) { return print((unsigned long) n, base); }
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+
+    size_t println(void) { return write("\r\n"); }
+
+    template <class T>
+    size_t println(T value) { size_t n = print(value); return n + println(); }
+
+    template <class T>
+    size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+/**
+ * Serial port. Output goes to the standard output (see smrtobj::sim::setSerialEcho), input comes from
+ * a script (see smrtobj::sim::setSerialInput).
+ */
+class HardwareSerial : public Print
+{
+  public:
+    void begin(unsigned long baud) { (void) baud; }
+    void end() {}
+
+    int available(void);
+    int peek(void);
+    int read(void);
+    void flush(void) {}
+
+    float parseFloat();
+    long parseInt();
+
+    virtual size_t write(uint8_t c);
+
+    using Print::write;
+
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif /* ARDUINO_H_ */
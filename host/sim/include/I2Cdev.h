@@ -0,0 +1,40 @@
+/**
+ * \file I2Cdev.h
+ * \brief I2Cdev for the host build: the register accesses of the I2Cdev library (Arduino Wire
+ *        implementation), on the simulated Wire library.
+ *
+ * As the original, a register read longer than BUFFER_LENGTH is split in several transfers, and each
+ * transfer starts again from the first register.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef I2CDEV_H_
+#define I2CDEV_H_
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define I2CDEV_ARDUINO_WIRE 1
+#define I2CDEV_BUILTIN_NBWIRE 2
+#define I2CDEV_BUILTIN_FASTWIRE 3
+
+#define I2CDEV_IMPLEMENTATION I2CDEV_ARDUINO_WIRE
+
+#define I2CDEV_DEFAULT_READ_TIMEOUT 1000
+
+class I2Cdev
+{
+  public:
+    static int8_t readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t timeout = I2Cdev::readTimeout);
+    static int8_t readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, uint16_t timeout = I2Cdev::readTimeout);
+    static int8_t readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data, uint16_t timeout = I2Cdev::readTimeout);
+
+    static bool writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data);
+    static bool writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
+    static bool writeWord(uint8_t devAddr, uint8_t regAddr, uint16_t data);
+
+    static uint16_t readTimeout;
+};
+
+#endif /* I2CDEV_H_ */
@@ -0,0 +1,95 @@
+/**
+ * \file Wire.h
+ * \brief Wire library for the host build: transfers go to the device models connected to the
+ *        simulated I2C bus (see smrtobj::sim::attach).
+ *
+ * As the AVR library, a transfer holds at most BUFFER_LENGTH bytes.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef WIRE_H_
+#define WIRE_H_
+
+#include <Arduino.h>
+
+#define BUFFER_LENGTH 32
+
+//! Compatibility with the Arduino core
+#define WIRE_HAS_END 1
+
+/**
+ * The TwoWire class is the master side of the simulated I2C bus.
+ */
+class TwoWire
+{
+  public:
+    TwoWire();
+
+    void begin() {}
+    void begin(uint8_t address) { (void) address; }
+    void begin(int address) { (void) address; }
+    void end() {}
+    void setClock(uint32_t clock) { (void) clock; }
+
+    /**
+     * Starts a write to a device: the bytes are buffered until TwoWire::endTransmission.
+     *
+     * \param[in] address device address
+     */
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { beginTransmission((uint8_t) address); }
+
+    /**
+     * Sends the buffered bytes to the device.
+     *
+     * \param[in] sendStop ignored: the simulated bus has no other master
+     *
+     * \return 0 on success, 1 if more than BUFFER_LENGTH bytes were written (the bytes in excess are
+     *         lost), 2 if there is no device at the address, 3 if the device does not acknowledge the
+     *         data
+     */
+    uint8_t endTransmission(uint8_t sendStop);
+    uint8_t endTransmission(void) { return endTransmission((uint8_t) true); }
+
+    /**
+     * Reads bytes from a device. At most BUFFER_LENGTH bytes are read.
+     *
+     * \param[in] address device address
+     * \param[in] quantity number of bytes
+     * \param[in] sendStop ignored
+     *
+     * \return number of bytes read, 0 if there is no device or it does not give the bytes
+     */
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity) { return requestFrom(address, quantity, (uint8_t) true); }
+    uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t) address, (uint8_t) quantity, (uint8_t) true); }
+    uint8_t requestFrom(int address, int quantity, int sendStop) { return requestFrom((uint8_t) address, (uint8_t) quantity, (uint8_t) sendStop); }
+
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t quantity);
+    size_t write(int data) { return write((uint8_t) data); }
+
+    int available(void);
+    int read(void);
+    int peek(void);
+    void flush(void) {}
+
+    // Arduino 0023 and earlier
+    void send(uint8_t data) { write(data); }
+    uint8_t receive(void) { return (uint8_t) read(); }
+
+  private:
+    uint8_t m_tx_address;
+    uint8_t m_tx[BUFFER_LENGTH];
+    uint8_t m_tx_length;
+    bool m_tx_overflow;
+
+    uint8_t m_rx[BUFFER_LENGTH];
+    uint8_t m_rx_length;
+    uint8_t m_rx_index;
+};
+
+extern TwoWire Wire;
+
+#endif /* WIRE_H_ */
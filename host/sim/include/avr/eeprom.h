@@ -0,0 +1,44 @@
+/**
+ * \file eeprom.h
+ * \brief EEPROM access for the host build: the subset of avr-libc used by the SmrtObj libraries, backed by
+ *        the EEPROM of the simulated board (see smrtobj::sim::eeprom).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+#include <stdint.h>
+
+extern "C"
+{
+
+/**
+ * Reads a byte. Addresses wrap around the size of the EEPROM, as on the boards.
+ *
+ * \param[in] p address
+ *
+ * \return value
+ */
+uint8_t eeprom_read_byte(const uint8_t *p);
+
+/**
+ * Writes a byte.
+ *
+ * \param[in] p address
+ * \param[in] value value
+ */
+void eeprom_write_byte(uint8_t *p, uint8_t value);
+
+/**
+ * Writes a byte only if it is changed.
+ *
+ * \param[in] p address
+ * \param[in] value value
+ */
+void eeprom_update_byte(uint8_t *p, uint8_t value);
+
+}
+
+#endif /* EEPROM_H_ */
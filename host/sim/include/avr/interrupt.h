@@ -0,0 +1,17 @@
+/**
+ * \file interrupt.h
+ * \brief Interrupts for the host build: there are no interrupts, so the global enable and disable
+ *        are empty and ISR declares an ordinary function.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef INTERRUPT_H_
+#define INTERRUPT_H_
+
+#define sei()
+#define cli()
+
+#define ISR(vector, ...) extern "C" void vector(void)
+
+#endif /* INTERRUPT_H_ */
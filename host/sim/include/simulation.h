@@ -0,0 +1,379 @@
+/**
+ * \file simulation.h
+ * \brief Control of the simulated board of the host build: clock, pins, ADC, serial port, I2C bus and
+ *        EEPROM.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef SIMULATION_H_
+#define SIMULATION_H_
+
+#include <Arduino.h>
+#include "bus/i2csimbus.h"
+
+namespace smrtobj
+{
+
+  /**
+   * The simulation namespace drives the board seen by the libraries in the host build:
+   *   - clock: millis() and micros() follow a virtual time, advanced by the test (see advance) and by
+   *     delay(). The oscillator of the board can have an error (see setDrift), so the time seen by the
+   *     board differs from the true time of the device models (see trueMicros);
+   *   - pins: levels written by the libraries are recorded (see output), input levels are set by the
+   *     test (see setInput);
+   *   - ADC: each channel gives a constant value or follows a waveform (see setAnalog, setSine, ...);
+   *   - serial port: output is recorded (see serialOutput), input comes from a script (see
+   *     setSerialInput);
+   *   - I2C bus: Wire and I2Cdev transfers go to the device models attached to the bus (see attach);
+   *   - EEPROM: the bytes written by the libraries (see avr/eeprom.h) can be read and changed by the
+   *     test (see eeprom, setEEPROM).
+   *
+   * \code{.cpp}
+   * smrtobj::sim::reset();
+   * smrtobj::sim::setSine(0, 512, 200, 1000);   // A0: 1 Hz sine around mid scale
+   * smrtobj::sim::advanceMillis(250);
+   * int v = analogRead(A0);                      // 712
+   * \endcode
+   */
+  namespace sim
+  {
+
+    /**
+     * Resets the simulation: time 0 without drift, pins as inputs, ADC channels at 0, serial port
+     * empty, no devices on the bus and EEPROM erased.
+     */
+    void reset();
+
+    /**************************************************************************
+     * Clock
+     **************************************************************************/
+
+    /**
+     * Gets the true time, that is the time of the device models.
+     *
+     * \return time from the reset (in microseconds)
+     */
+    unsigned long long trueMicros();
+
+    /**
+     * Advances the true time. The board time (millis(), micros()) advances according to its drift.
+     *
+     * \param[in] us time (in microseconds)
+     */
+    void advance(unsigned long long us);
+
+    /**
+     * Advances the true time.
+     *
+     * \param[in] ms time (in milliseconds)
+     */
+    inline void advanceMillis(unsigned long long ms) { advance(ms * 1000ULL); }
+
+    /**
+     * Sets the error of the oscillator of the board from now on: with a positive drift millis() and
+     * micros() run faster than the true time.
+     *
+     * \param[in] ppm error (in parts per million)
+     */
+    void setDrift(long ppm);
+
+    /**
+     * Sets the true time added at every call of millis() and micros(), so that the loops waiting for a
+     * time (or for a device) end. By default the time is advanced only by the test and by delay().
+     *
+     * \param[in] us time (in microseconds)
+     */
+    void setAutoStep(unsigned long us);
+
+    /**
+     * Sets the value of micros() from now on (e.g. to start near a given time). millis() is changed
+     * accordingly.
+     *
+     * \param[in] us board time (in microseconds)
+     */
+    void setMicros(unsigned long long us);
+
+    /**************************************************************************
+     * Pins
+     **************************************************************************/
+
+    /**
+     * Sets the level of a pin driven from outside the board (used by digitalRead if the pin is an
+     * input).
+     *
+     * \param[in] pin pin number
+     * \param[in] level HIGH or LOW
+     */
+    void setInput(uint8_t pin, uint8_t level);
+
+    /**
+     * Gets the mode of a pin.
+     *
+     * \param[in] pin pin number
+     *
+     * \return INPUT, OUTPUT or INPUT_PULLUP
+     */
+    uint8_t mode(uint8_t pin);
+
+    /**
+     * Gets the level written on a pin by digitalWrite.
+     *
+     * \param[in] pin pin number
+     *
+     * \return HIGH or LOW
+     */
+    uint8_t output(uint8_t pin);
+
+    /**
+     * Gets the duty cycle written on a pin by analogWrite.
+     *
+     * \param[in] pin pin number
+     *
+     * \return duty cycle (0 - 255)
+     */
+    int pwm(uint8_t pin);
+
+    /**
+     * Gets the number of changes of the level written on a pin.
+     *
+     * \param[in] pin pin number
+     *
+     * \return number of changes from the reset
+     */
+    unsigned long toggles(uint8_t pin);
+
+    /**************************************************************************
+     * ADC
+     **************************************************************************/
+
+    /**
+     * Function giving the value of an ADC channel.
+     *
+     * \param[in] channel channel
+     * \param[in] us true time (in microseconds)
+     * \param[in] context user data
+     *
+     * \return value (clipped to 0 - 1023)
+     */
+    typedef int (*waveform_t)(uint8_t channel, unsigned long long us, void *context);
+
+    /**
+     * Sets a constant value on an ADC channel.
+     *
+     * \param[in] channel channel (0 - 7) or analog pin (A0 - A7)
+     * \param[in] value value (0 - 1023)
+     */
+    void setAnalog(uint8_t channel, int value);
+
+    /**
+     * Sets a sine wave on an ADC channel.
+     *
+     * \param[in] channel channel (0 - 7) or analog pin (A0 - A7)
+     * \param[in] offset mean value
+     * \param[in] amplitude amplitude
+     * \param[in] period period (in milliseconds)
+     */
+    void setSine(uint8_t channel, int offset, int amplitude, unsigned long period);
+
+    /**
+     * Sets a saw tooth wave on an ADC channel: the value goes from \e from to \e to in a period, then it
+     * starts again.
+     *
+     * \param[in] channel channel (0 - 7) or analog pin (A0 - A7)
+     * \param[in] from value at the start of the period
+     * \param[in] to value at the end of the period
+     * \param[in] period period (in milliseconds)
+     */
+    void setRamp(uint8_t channel, int from, int to, unsigned long period);
+
+    /**
+     * Sets a square wave on an ADC channel, with duty cycle 50 %.
+     *
+     * \param[in] channel channel (0 - 7) or analog pin (A0 - A7)
+     * \param[in] low value in the first half of the period
+     * \param[in] high value in the second half of the period
+     * \param[in] period period (in milliseconds)
+     */
+    void setSquare(uint8_t channel, int low, int high, unsigned long period);
+
+    /**
+     * Sets a sequence of values on an ADC channel: each conversion gives the next value, and the
+     * sequence starts again after the last one. The values are not copied.
+     *
+     * \param[in] channel channel (0 - 7) or analog pin (A0 - A7)
+     * \param[in] samples values
+     * \param[in] n number of values
+     */
+    void setSamples(uint8_t channel, const int *samples, unsigned int n);
+
+    /**
+     * Sets a waveform computed by a function on an ADC channel.
+     *
+     * \param[in] channel channel (0 - 7) or analog pin (A0 - A7)
+     * \param[in] f function
+     * \param[in] context user data passed to the function
+     */
+    void setWaveform(uint8_t channel, waveform_t f, void *context = 0);
+
+    /**
+     * Adds a uniform noise to the values of an ADC channel.
+     *
+     * \param[in] channel channel (0 - 7) or analog pin (A0 - A7)
+     * \param[in] amplitude maximum deviation (0 for no noise)
+     */
+    void setNoise(uint8_t channel, int amplitude);
+
+    /**
+     * Gets the number of conversions of an ADC channel.
+     *
+     * \param[in] channel channel (0 - 7) or analog pin (A0 - A7)
+     *
+     * \return number of conversions from the reset
+     */
+    unsigned long conversions(uint8_t channel);
+
+    /**
+     * Gets the reference of the ADC set by analogReference.
+     *
+     * \return DEFAULT, INTERNAL or EXTERNAL
+     */
+    uint8_t reference();
+
+    /**************************************************************************
+     * Serial port
+     **************************************************************************/
+
+    /**
+     * Adds characters to the input of the serial port.
+     *
+     * \param[in] str characters
+     */
+    void setSerialInput(const char *str);
+
+    /**
+     * Copies the output of the serial port to the standard output.
+     *
+     * \param[in] echo true to copy the output
+     */
+    void setSerialEcho(bool echo);
+
+    /**
+     * Gets the output of the serial port (the last 4095 characters).
+     *
+     * \return output
+     */
+    const char * serialOutput();
+
+    /**
+     * Deletes the recorded output of the serial port.
+     */
+    void clearSerialOutput();
+
+    /**************************************************************************
+     * I2C bus
+     **************************************************************************/
+
+    /**
+     * The I2CSimMux class models a multiplexer: besides answering at its own address, it connects to
+     * the bus the devices of its enabled channels.
+     */
+    class I2CSimMux : public smrtobj::i2c::I2CSimDevice
+    {
+      public:
+        /**
+         * Constructor.
+         *
+         * \param[in] addr device address
+         */
+        I2CSimMux(uint8_t addr) : smrtobj::i2c::I2CSimDevice(addr) {}
+
+        /**
+         * Looks for a device on the enabled channels.
+         *
+         * \param[in] addr device address
+         *
+         * \return device, 0 if there is no device at the address
+         */
+        virtual smrtobj::i2c::I2CSimDevice * find(uint8_t addr) = 0;
+    };
+
+    //! Maximum number of devices on the bus
+    const uint8_t MAX_DEVICES = 16;
+
+    /**
+     * Connects a device to the bus used by Wire and I2Cdev.
+     *
+     * \param[in] d device
+     *
+     * \return false if there are already MAX_DEVICES devices, true otherwise
+     */
+    bool attach(smrtobj::i2c::I2CSimDevice &d);
+
+    /**
+     * Connects a multiplexer to the bus used by Wire and I2Cdev.
+     *
+     * \param[in] m multiplexer
+     *
+     * \return false if there are already MAX_DEVICES devices, true otherwise
+     */
+    bool attach(I2CSimMux &m);
+
+    /**
+     * Disconnects a device from the bus: the following transfers to its address are not acknowledged.
+     *
+     * \param[in] d device
+     */
+    void detach(smrtobj::i2c::I2CSimDevice &d);
+
+    /**
+     * Looks for the device answering at an address: the devices connected to the bus first, then the
+     * ones on the enabled channels of the multiplexers.
+     *
+     * \param[in] addr device address
+     *
+     * \return device, 0 if there is no device at the address
+     */
+    smrtobj::i2c::I2CSimDevice * find(uint8_t addr);
+
+    /**
+     * Gets the number of transfers on the bus (writes and reads, including the ones not acknowledged).
+     *
+     * \return number of transfers from the reset
+     */
+    unsigned long transfers();
+
+    /**************************************************************************
+     * EEPROM
+     **************************************************************************/
+
+    /**
+     * Gets a byte of the EEPROM (0xFF if it has never been written).
+     *
+     * \param[in] address address (0 - E2END)
+     *
+     * \return value
+     */
+    uint8_t eeprom(uint16_t address);
+
+    /**
+     * Changes a byte of the EEPROM without counting a write (e.g. to corrupt a record).
+     *
+     * \param[in] address address (0 - E2END)
+     * \param[in] value value
+     */
+    void setEEPROM(uint16_t address, uint8_t value);
+
+    /**
+     * Gets the number of bytes written in the EEPROM by the libraries (eeprom_update_byte does not
+     * write the bytes not changed).
+     *
+     * \return number of writes from the reset
+     */
+    unsigned long eepromWrites();
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* SIMULATION_H_ */
@@ -0,0 +1,86 @@
+/**
+ * \file i2cdev.cpp
+ * \brief I2Cdev for the host build: the register accesses of the I2Cdev library (Arduino Wire
+ *        implementation), on the simulated Wire library.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <I2Cdev.h>
+
+uint16_t I2Cdev::readTimeout = I2CDEV_DEFAULT_READ_TIMEOUT;
+
+int8_t I2Cdev::readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t timeout)
+{
+  return readBytes(devAddr, regAddr, 1, data, timeout);
+}
+
+int8_t I2Cdev::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data, uint16_t timeout)
+{
+  int8_t count = 0;
+
+  // unsigned long as millis() (uint32_t on the board): the timeout must not break when millis() passes 2^32
+  unsigned long t1 = millis();
+
+  // As the original, every chunk starts again from regAddr
+  for (uint8_t k = 0; k < length; k += min((int) length, BUFFER_LENGTH))
+  {
+    Wire.beginTransmission(devAddr);
+    Wire.write(regAddr);
+    Wire.endTransmission();
+    Wire.beginTransmission(devAddr);
+    Wire.requestFrom(devAddr, (uint8_t) min(length - k, BUFFER_LENGTH));
+
+    for (; Wire.available() && (timeout == 0 || millis() - t1 < timeout); count++)
+    {
+      data[count] = Wire.read();
+    }
+  }
+
+  // Timeout
+  if (timeout > 0 && millis() - t1 >= timeout && count < length)
+  {
+    count = -1;
+  }
+
+  return count;
+}
+
+int8_t I2Cdev::readWord(uint8_t devAddr, uint8_t regAddr, uint16_t *data, uint16_t timeout)
+{
+  uint8_t buf[2];
+  int8_t count = readBytes(devAddr, regAddr, 2, buf, timeout);
+
+  if (count == 2)
+  {
+    *data = (buf[0] << 8) | buf[1];
+    return 1;
+  }
+
+  return (count < 0) ? count : 0;
+}
+
+bool I2Cdev::writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data)
+{
+  return writeBytes(devAddr, regAddr, 1, &data);
+}
+
+bool I2Cdev::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data)
+{
+  Wire.beginTransmission(devAddr);
+  Wire.write(regAddr);
+
+  for (uint8_t i = 0; i < length; i++)
+  {
+    Wire.write(data[i]);
+  }
+
+  return (Wire.endTransmission() == 0);
+}
+
+bool I2Cdev::writeWord(uint8_t devAddr, uint8_t regAddr, uint16_t data)
+{
+  uint8_t buf[2] = { (uint8_t) (data >> 8), (uint8_t) data };
+
+  return writeBytes(devAddr, regAddr, 2, buf);
+}
@@ -0,0 +1,143 @@
+/**
+ * \file print.cpp
+ * \brief Formatting functions of the Arduino core for the host build: Print, dtostrf, map and random.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <Arduino.h>
+
+#include <stdio.h>
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+  size_t n = 0;
+
+  while (size--)
+  {
+    if ( !write(*buffer++) )
+    {
+      break;
+    }
+    n++;
+  }
+
+  return n;
+}
+
+size_t Print::print(long n, int base)
+{
+  if (base == DEC && n < 0)
+  {
+    return print('-') + print(0UL - (unsigned long) n, base);
+  }
+
+  return print((unsigned long) n, base);
+}
+
+size_t Print::print(unsigned long n, int base)
+{
+  char buf[8 * sizeof(long) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+
+  if (base < 2)
+  {
+    base = DEC;
+  }
+
+  *str = '\0';
+  do
+  {
+    char c = n % base;
+    n /= base;
+
+    *--str = (c < 10) ? c + '0' : c + 'A' - 10;
+  } while (n);
+
+  return write(str);
+}
+
+size_t Print::print(double number, int digits)
+{
+  if (isnan(number))
+  {
+    return write("nan");
+  }
+
+  if (isinf(number))
+  {
+    return write("inf");
+  }
+
+  if (number > 4294967040.0 || number < -4294967040.0)
+  {
+    return write("ovf");
+  }
+
+  size_t n = 0;
+
+  if (number < 0.0)
+  {
+    n += print('-');
+    number = -number;
+  }
+
+  // Round as the Arduino core: add 0.5 at the last digit printed
+  double rounding = 0.5;
+  for (int i = 0; i < digits; i++)
+  {
+    rounding /= 10.0;
+  }
+  number += rounding;
+
+  unsigned long int_part = (unsigned long) number;
+  double remainder = number - (double) int_part;
+
+  n += print(int_part);
+
+  if (digits > 0)
+  {
+    n += print('.');
+  }
+
+  while (digits-- > 0)
+  {
+    remainder *= 10.0;
+
+    unsigned int digit = (unsigned int) remainder;
+    n += print(digit);
+    remainder -= digit;
+  }
+
+  return n;
+}
+
+char *dtostrf(double val, signed char width, unsigned char prec, char *sout)
+{
+  sprintf(sout, "%*.*f", width, prec, val);
+
+  return sout;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+long random(long howbig)
+{
+  return (howbig > 0) ? ::random() % howbig : 0;
+}
+
+long random(long howsmall, long howbig)
+{
+  return (howsmall < howbig) ? random(howbig - howsmall) + howsmall : howsmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+  if (seed != 0)
+  {
+    srandom(seed);
+  }
+}
@@ -0,0 +1,703 @@
+/**
+ * \file simulation.cpp
+ * \brief Control of the simulated board of the host build: clock, pins, ADC, serial port, I2C bus and
+ *        EEPROM.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "simulation.h"
+#include "simulation_p.h"
+
+#include <avr/eeprom.h>
+
+#include <stdio.h>
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    namespace
+    {
+      /**************************************************************************
+       * State of the board
+       **************************************************************************/
+
+      //! Size of the input buffer of the serial port
+      const unsigned int SERIAL_INPUT_LENGTH = 1024;
+
+      //! Size of the recorded output of the serial port
+      const unsigned int SERIAL_OUTPUT_LENGTH = 4096;
+
+      //! Level of an input pin not driven by the test
+      const uint8_t FLOATING = 0xFF;
+
+      //! Type of the value of an ADC channel
+      enum _waveform
+      {
+        CONSTANT, SINE, RAMP, SQUARE, SAMPLES, FUNCTION
+      };
+
+      //! ADC channel
+      struct Channel
+      {
+        uint8_t type;
+        int a;
+        int b;
+        unsigned long long period;
+        const int *samples;
+        unsigned int n;
+        unsigned int index;
+        waveform_t f;
+        void *context;
+        int noise;
+        unsigned long conversions;
+      };
+
+      //! True time (in microseconds)
+      unsigned long long g_true_us = 0;
+
+      //! True time of the last change of the board clock
+      unsigned long long g_true_base = 0;
+
+      //! Board time at the last change of the board clock
+      unsigned long long g_board_base = 0;
+
+      //! Oscillator error (in ppm)
+      long g_drift = 0;
+
+      //! Time added at every read of the clock
+      unsigned long g_auto_step = 0;
+
+      //! Pins
+      uint8_t g_mode[NUM_DIGITAL_PINS];
+      uint8_t g_output[NUM_DIGITAL_PINS];
+      uint8_t g_input[NUM_DIGITAL_PINS];
+      int g_pwm[NUM_DIGITAL_PINS];
+      unsigned long g_toggles[NUM_DIGITAL_PINS];
+
+      //! ADC
+      Channel g_adc[NUM_ANALOG_INPUTS];
+      uint8_t g_reference = DEFAULT;
+      uint32_t g_noise_seed = 1;
+
+      //! Serial port
+      char g_serial_in[SERIAL_INPUT_LENGTH];
+      unsigned int g_serial_in_head = 0;
+      unsigned int g_serial_in_tail = 0;
+      char g_serial_out[SERIAL_OUTPUT_LENGTH];
+      unsigned int g_serial_out_length = 0;
+      bool g_serial_echo = true;
+
+      //! I2C bus
+      smrtobj::i2c::I2CSimDevice *g_devices[MAX_DEVICES];
+      I2CSimMux *g_muxes[MAX_DEVICES];
+      uint8_t g_ndevices = 0;
+      unsigned long g_transfers = 0;
+
+      //! EEPROM
+      uint8_t g_eeprom[E2END + 1];
+      unsigned long g_eeprom_writes = 0;
+
+      unsigned long long boardMicros()
+      {
+        long long elapsed = (long long) (g_true_us - g_true_base);
+
+        return g_board_base + elapsed + (elapsed * g_drift) / 1000000LL;
+      }
+
+      uint8_t channel(uint8_t pin)
+      {
+        return (pin >= A0) ? pin - A0 : pin;
+      }
+
+      Channel * adc(uint8_t pin)
+      {
+        uint8_t ch = channel(pin);
+
+        return (ch < NUM_ANALOG_INPUTS) ? &g_adc[ch] : 0;
+      }
+
+      Channel * setChannel(uint8_t pin, uint8_t type, int a, int b, unsigned long period)
+      {
+        Channel *c = adc(pin);
+
+        if (c)
+        {
+          c->type = type;
+          c->a = a;
+          c->b = b;
+          c->period = (period > 0) ? period * 1000ULL : 1;
+          c->index = 0;
+        }
+
+        return c;
+      }
+
+      int value(uint8_t ch, Channel &c)
+      {
+        unsigned long long t = g_true_us % c.period;
+        int v = 0;
+
+        switch (c.type)
+        {
+          case CONSTANT:
+            v = c.a;
+            break;
+
+          case SINE:
+            v = c.a + (int) lround(c.b * sin(TWO_PI * t / c.period));
+            break;
+
+          case RAMP:
+            v = c.a + (int) (((long long) (c.b - c.a) * (long long) t) / (long long) c.period);
+            break;
+
+          case SQUARE:
+            v = (t < c.period / 2) ? c.a : c.b;
+            break;
+
+          case SAMPLES:
+            if (c.n > 0)
+            {
+              v = c.samples[c.index];
+              c.index = (c.index + 1) % c.n;
+            }
+            break;
+
+          case FUNCTION:
+            v = c.f ? c.f(ch, g_true_us, c.context) : 0;
+            break;
+        }
+
+        if (c.noise > 0)
+        {
+          // Linear congruential generator: the noise is the same at every run
+          g_noise_seed = g_noise_seed * 1103515245UL + 12345UL;
+          v += (int) ((g_noise_seed >> 16) % (2 * c.noise + 1)) - c.noise;
+        }
+
+        return constrain(v, 0, 1023);
+      }
+
+      void wait(unsigned long long us)
+      {
+        unsigned long long target = boardMicros() + us;
+
+        // True time needed by the board to count the delay
+        g_true_us += (us * 1000000ULL) / (unsigned long long) (1000000LL + g_drift);
+
+        while (boardMicros() < target)
+        {
+          g_true_us++;
+        }
+      }
+
+      unsigned long long readClock()
+      {
+        g_true_us += g_auto_step;
+
+        return boardMicros();
+      }
+
+      //! The board is reset before the sketch starts
+      struct PowerOn
+      {
+        PowerOn() { reset(); }
+      } g_power_on;
+    }
+
+    void reset()
+    {
+      g_true_us = 0;
+      g_true_base = 0;
+      g_board_base = 0;
+      g_drift = 0;
+      g_auto_step = 0;
+
+      for (uint8_t i = 0; i < NUM_DIGITAL_PINS; i++)
+      {
+        g_mode[i] = INPUT;
+        g_output[i] = LOW;
+        g_input[i] = FLOATING;
+        g_pwm[i] = 0;
+        g_toggles[i] = 0;
+      }
+
+      memset(g_adc, 0, sizeof(g_adc));
+      for (uint8_t i = 0; i < NUM_ANALOG_INPUTS; i++)
+      {
+        g_adc[i].period = 1;
+      }
+      g_reference = DEFAULT;
+      g_noise_seed = 1;
+
+      g_serial_in_head = 0;
+      g_serial_in_tail = 0;
+      g_serial_out_length = 0;
+      g_serial_out[0] = '\0';
+
+      g_ndevices = 0;
+      g_transfers = 0;
+
+      memset(g_eeprom, 0xFF, sizeof(g_eeprom));
+      g_eeprom_writes = 0;
+    }
+
+    /**************************************************************************
+     * Clock
+     **************************************************************************/
+    unsigned long long trueMicros()
+    {
+      return g_true_us;
+    }
+
+    void advance(unsigned long long us)
+    {
+      g_true_us += us;
+    }
+
+    void setDrift(long ppm)
+    {
+      g_board_base = boardMicros();
+      g_true_base = g_true_us;
+      g_drift = ppm;
+    }
+
+    void setAutoStep(unsigned long us)
+    {
+      g_auto_step = us;
+    }
+
+    void setMicros(unsigned long long us)
+    {
+      g_board_base = us;
+      g_true_base = g_true_us;
+    }
+
+    /**************************************************************************
+     * Pins
+     **************************************************************************/
+    void setInput(uint8_t pin, uint8_t level)
+    {
+      if (pin < NUM_DIGITAL_PINS)
+      {
+        g_input[pin] = level ? HIGH : LOW;
+      }
+    }
+
+    uint8_t mode(uint8_t pin)
+    {
+      return (pin < NUM_DIGITAL_PINS) ? g_mode[pin] : INPUT;
+    }
+
+    uint8_t output(uint8_t pin)
+    {
+      return (pin < NUM_DIGITAL_PINS) ? g_output[pin] : LOW;
+    }
+
+    int pwm(uint8_t pin)
+    {
+      return (pin < NUM_DIGITAL_PINS) ? g_pwm[pin] : 0;
+    }
+
+    unsigned long toggles(uint8_t pin)
+    {
+      return (pin < NUM_DIGITAL_PINS) ? g_toggles[pin] : 0;
+    }
+
+    /**************************************************************************
+     * ADC
+     **************************************************************************/
+    void setAnalog(uint8_t channel, int value)
+    {
+      setChannel(channel, CONSTANT, value, 0, 0);
+    }
+
+    void setSine(uint8_t channel, int offset, int amplitude, unsigned long period)
+    {
+      setChannel(channel, SINE, offset, amplitude, period);
+    }
+
+    void setRamp(uint8_t channel, int from, int to, unsigned long period)
+    {
+      setChannel(channel, RAMP, from, to, period);
+    }
+
+    void setSquare(uint8_t channel, int low, int high, unsigned long period)
+    {
+      setChannel(channel, SQUARE, low, high, period);
+    }
+
+    void setSamples(uint8_t channel, const int *samples, unsigned int n)
+    {
+      Channel *c = setChannel(channel, SAMPLES, 0, 0, 0);
+
+      if (c)
+      {
+        c->samples = samples;
+        c->n = samples ? n : 0;
+      }
+    }
+
+    void setWaveform(uint8_t channel, waveform_t f, void *context)
+    {
+      Channel *c = setChannel(channel, FUNCTION, 0, 0, 0);
+
+      if (c)
+      {
+        c->f = f;
+        c->context = context;
+      }
+    }
+
+    void setNoise(uint8_t channel, int amplitude)
+    {
+      Channel *c = adc(channel);
+
+      if (c)
+      {
+        c->noise = (amplitude > 0) ? amplitude : 0;
+      }
+    }
+
+    unsigned long conversions(uint8_t channel)
+    {
+      Channel *c = adc(channel);
+
+      return c ? c->conversions : 0;
+    }
+
+    uint8_t reference()
+    {
+      return g_reference;
+    }
+
+    /**************************************************************************
+     * Serial port
+     **************************************************************************/
+    void setSerialInput(const char *str)
+    {
+      for (; str && *str; str++)
+      {
+        unsigned int next = (g_serial_in_tail + 1) % SERIAL_INPUT_LENGTH;
+
+        if (next == g_serial_in_head)
+        {
+          break;
+        }
+
+        g_serial_in[g_serial_in_tail] = *str;
+        g_serial_in_tail = next;
+      }
+    }
+
+    void setSerialEcho(bool echo)
+    {
+      g_serial_echo = echo;
+    }
+
+    const char * serialOutput()
+    {
+      return g_serial_out;
+    }
+
+    void clearSerialOutput()
+    {
+      g_serial_out_length = 0;
+      g_serial_out[0] = '\0';
+    }
+
+    /**************************************************************************
+     * I2C bus
+     **************************************************************************/
+    bool attach(smrtobj::i2c::I2CSimDevice &d)
+    {
+      if (g_ndevices >= MAX_DEVICES)
+      {
+        return false;
+      }
+
+      g_devices[g_ndevices] = &d;
+      g_muxes[g_ndevices] = 0;
+      g_ndevices++;
+
+      return true;
+    }
+
+    bool attach(I2CSimMux &m)
+    {
+      if ( !attach((smrtobj::i2c::I2CSimDevice &) m) )
+      {
+        return false;
+      }
+
+      g_muxes[g_ndevices - 1] = &m;
+
+      return true;
+    }
+
+    void detach(smrtobj::i2c::I2CSimDevice &d)
+    {
+      for (uint8_t i = 0; i < g_ndevices; i++)
+      {
+        if (g_devices[i] == &d)
+        {
+          g_ndevices--;
+          for (; i < g_ndevices; i++)
+          {
+            g_devices[i] = g_devices[i + 1];
+            g_muxes[i] = g_muxes[i + 1];
+          }
+          break;
+        }
+      }
+    }
+
+    smrtobj::i2c::I2CSimDevice * find(uint8_t addr)
+    {
+      for (uint8_t i = 0; i < g_ndevices; i++)
+      {
+        if (g_devices[i]->address() == addr)
+        {
+          return g_devices[i];
+        }
+      }
+
+      for (uint8_t i = 0; i < g_ndevices; i++)
+      {
+        smrtobj::i2c::I2CSimDevice *d = g_muxes[i] ? g_muxes[i]->find(addr) : 0;
+
+        if (d)
+        {
+          return d;
+        }
+      }
+
+      return 0;
+    }
+
+    unsigned long transfers()
+    {
+      return g_transfers;
+    }
+
+    void countTransfer()
+    {
+      g_transfers++;
+    }
+
+    /**************************************************************************
+     * EEPROM
+     **************************************************************************/
+    uint8_t eeprom(uint16_t address)
+    {
+      return g_eeprom[address & E2END];
+    }
+
+    void setEEPROM(uint16_t address, uint8_t value)
+    {
+      g_eeprom[address & E2END] = value;
+    }
+
+    unsigned long eepromWrites()
+    {
+      return g_eeprom_writes;
+    }
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+/******************************************************************************
+ * Arduino core
+ ******************************************************************************/
+using namespace smrtobj::sim;
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (pin < NUM_DIGITAL_PINS)
+  {
+    g_mode[pin] = mode;
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  if (pin < NUM_DIGITAL_PINS)
+  {
+    val = val ? HIGH : LOW;
+    if (g_output[pin] != val)
+    {
+      g_toggles[pin]++;
+    }
+    g_output[pin] = val;
+  }
+}
+
+int digitalRead(uint8_t pin)
+{
+  if (pin >= NUM_DIGITAL_PINS)
+  {
+    return LOW;
+  }
+
+  if (g_mode[pin] == OUTPUT)
+  {
+    return g_output[pin];
+  }
+
+  if (g_input[pin] == FLOATING)
+  {
+    return (g_mode[pin] == INPUT_PULLUP) ? HIGH : LOW;
+  }
+
+  return g_input[pin];
+}
+
+int analogRead(uint8_t pin)
+{
+  Channel *c = adc(pin);
+
+  if (!c)
+  {
+    return 0;
+  }
+
+  c->conversions++;
+
+  return value(channel(pin), *c);
+}
+
+void analogReference(uint8_t mode)
+{
+  g_reference = mode;
+}
+
+void analogWrite(uint8_t pin, int val)
+{
+  if (pin < NUM_DIGITAL_PINS)
+  {
+    g_pwm[pin] = constrain(val, 0, 255);
+    digitalWrite(pin, (val > 127) ? HIGH : LOW);
+  }
+}
+
+unsigned long millis(void)
+{
+  return (unsigned long) (readClock() / 1000ULL);
+}
+
+unsigned long micros(void)
+{
+  return (unsigned long) readClock();
+}
+
+void delay(unsigned long ms)
+{
+  wait(ms * 1000ULL);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  wait(us);
+}
+
+/******************************************************************************
+ * Serial port
+ ******************************************************************************/
+HardwareSerial Serial;
+
+int HardwareSerial::available(void)
+{
+  return (g_serial_in_tail + SERIAL_INPUT_LENGTH - g_serial_in_head) % SERIAL_INPUT_LENGTH;
+}
+
+int HardwareSerial::peek(void)
+{
+  return (g_serial_in_head == g_serial_in_tail) ? -1 : (uint8_t) g_serial_in[g_serial_in_head];
+}
+
+int HardwareSerial::read(void)
+{
+  int c = peek();
+
+  if (c >= 0)
+  {
+    g_serial_in_head = (g_serial_in_head + 1) % SERIAL_INPUT_LENGTH;
+  }
+
+  return c;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  if (g_serial_echo)
+  {
+    putchar(c);
+  }
+
+  if (g_serial_out_length + 1 >= SERIAL_OUTPUT_LENGTH)
+  {
+    // Keep the newest half
+    const unsigned int half = SERIAL_OUTPUT_LENGTH / 2;
+
+    memmove(g_serial_out, g_serial_out + g_serial_out_length - half, half);
+    g_serial_out_length = half;
+  }
+
+  g_serial_out[g_serial_out_length++] = (char) c;
+  g_serial_out[g_serial_out_length] = '\0';
+
+  return 1;
+}
+
+float HardwareSerial::parseFloat()
+{
+  char buf[32];
+  uint8_t n = 0;
+  int c;
+
+  // As Stream::parseFloat, skip the characters before the number; the input does not time out
+  while ( (c = peek()) >= 0 && !isdigit(c) && c != '-' && c != '.' )
+  {
+    read();
+  }
+
+  while ( (c = peek()) >= 0 && (isdigit(c) || c == '-' || c == '.') && n < sizeof(buf) - 1 )
+  {
+    buf[n++] = (char) read();
+  }
+  buf[n] = '\0';
+
+  return (float) atof(buf);
+}
+
+long HardwareSerial::parseInt()
+{
+  return (long) parseFloat();
+}
+
+/******************************************************************************
+ * EEPROM
+ ******************************************************************************/
+uint8_t eeprom_read_byte(const uint8_t *p)
+{
+  return g_eeprom[(uintptr_t) p & E2END];
+}
+
+void eeprom_write_byte(uint8_t *p, uint8_t value)
+{
+  g_eeprom[(uintptr_t) p & E2END] = value;
+  g_eeprom_writes++;
+}
+
+void eeprom_update_byte(uint8_t *p, uint8_t value)
+{
+  if (eeprom_read_byte(p) != value)
+  {
+    eeprom_write_byte(p, value);
+  }
+}
@@ -0,0 +1,26 @@
+/**
+ * \file simulation_p.h
+ * \brief Functions shared by the sources of the simulated board.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef SIMULATION_P_H_
+#define SIMULATION_P_H_
+
+namespace smrtobj
+{
+
+  namespace sim
+  {
+
+    /**
+     * Counts a transfer on the I2C bus (see smrtobj::sim::transfers).
+     */
+    void countTransfer();
+
+  } /* namespace sim */
+
+} /* namespace smrtobj */
+
+#endif /* SIMULATION_P_H_ */
@@ -0,0 +1,214 @@
+/**
+ * \file time.cpp
+ * \brief Time library (TimeLib) for the host build: calendar conversions and a system time that
+ *        follows millis().
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <Time.h>
+
+namespace
+{
+  //! Days of the months of a non leap year
+  const uint8_t MONTH_DAYS[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+  //! Leap year, Y is the offset from 1970
+  bool leap(unsigned int Y)
+  {
+    unsigned int y = 1970 + Y;
+
+    return (y % 4 == 0) && ((y % 100 != 0) || (y % 400 == 0));
+  }
+
+  //! System time at the last set
+  time_t g_sys_time = 0;
+
+  //! millis() at the last update of the system time
+  unsigned long g_prev_millis = 0;
+
+  timeStatus_t g_status = timeNotSet;
+
+  //! Last time decomposed
+  time_t g_cache_time = 0;
+  tmElements_t g_cache_tm = { 0, 0, 0, 5, 1, 1, 0 };
+
+  void refreshCache(time_t t)
+  {
+    if (t != g_cache_time)
+    {
+      breakTime(t, g_cache_tm);
+      g_cache_time = t;
+    }
+  }
+}
+
+void breakTime(time_t timeInput, tmElements_t &tm)
+{
+  unsigned long time = (unsigned long) timeInput;
+
+  tm.Second = time % 60;
+  time /= 60;
+  tm.Minute = time % 60;
+  time /= 60;
+  tm.Hour = time % 24;
+  time /= 24;
+
+  // Sunday is day 1, 1/1/1970 was a Thursday
+  tm.Wday = ((time + 4) % 7) + 1;
+
+  unsigned int year = 0;
+  unsigned long days = 0;
+
+  while ((days += (leap(year) ? 366 : 365)) <= time)
+  {
+    year++;
+  }
+  tm.Year = year;
+
+  days -= leap(year) ? 366 : 365;
+  time -= days;
+
+  uint8_t month = 0;
+  for (; month < 12; month++)
+  {
+    uint8_t length = (month == 1 && leap(year)) ? 29 : MONTH_DAYS[month];
+
+    if (time < length)
+    {
+      break;
+    }
+
+    time -= length;
+  }
+
+  tm.Month = month + 1;
+  tm.Day = time + 1;
+}
+
+time_t makeTime(const tmElements_t &tm)
+{
+  unsigned long seconds = tm.Year * (SECS_PER_DAY * 365);
+
+  for (unsigned int i = 0; i < tm.Year; i++)
+  {
+    if (leap(i))
+    {
+      seconds += SECS_PER_DAY;
+    }
+  }
+
+  for (unsigned int i = 1; i < tm.Month; i++)
+  {
+    if (i == 2 && leap(tm.Year))
+    {
+      seconds += SECS_PER_DAY * 29;
+    }
+    else
+    {
+      seconds += SECS_PER_DAY * MONTH_DAYS[i - 1];
+    }
+  }
+
+  seconds += (tm.Day - 1) * SECS_PER_DAY;
+  seconds += tm.Hour * SECS_PER_HOUR;
+  seconds += tm.Minute * SECS_PER_MIN;
+  seconds += tm.Second;
+
+  return (time_t) seconds;
+}
+
+time_t now()
+{
+  unsigned long ms = millis();
+
+  while (ms - g_prev_millis >= 1000)
+  {
+    g_sys_time++;
+    g_prev_millis += 1000;
+  }
+
+  return g_sys_time;
+}
+
+void setTime(time_t t)
+{
+  g_sys_time = t;
+  g_prev_millis = millis();
+  g_status = timeSet;
+}
+
+void setTime(int hr, int min, int sec, int dy, int mnth, int yr)
+{
+  tmElements_t tm;
+
+  // Years can be given as offset from 2000 or as the full year
+  if (yr > 99)
+  {
+    yr = yr - 1970;
+  }
+  else
+  {
+    yr += 30;
+  }
+
+  tm.Year = yr;
+  tm.Month = mnth;
+  tm.Day = dy;
+  tm.Hour = hr;
+  tm.Minute = min;
+  tm.Second = sec;
+
+  setTime(makeTime(tm));
+}
+
+void adjustTime(long adjustment)
+{
+  g_sys_time += adjustment;
+}
+
+timeStatus_t timeStatus()
+{
+  now();
+
+  return g_status;
+}
+
+int hour() { return hour(now()); }
+int hour(time_t t) { refreshCache(t); return g_cache_tm.Hour; }
+
+int hourFormat12() { return hourFormat12(now()); }
+int hourFormat12(time_t t)
+{
+  refreshCache(t);
+
+  if (g_cache_tm.Hour == 0)
+  {
+    return 12;
+  }
+
+  return (g_cache_tm.Hour > 12) ? g_cache_tm.Hour - 12 : g_cache_tm.Hour;
+}
+
+uint8_t isAM() { return !isPM(now()); }
+uint8_t isAM(time_t t) { return !isPM(t); }
+uint8_t isPM() { return isPM(now()); }
+uint8_t isPM(time_t t) { return (hour(t) >= 12); }
+
+int minute() { return minute(now()); }
+int minute(time_t t) { refreshCache(t); return g_cache_tm.Minute; }
+
+int second() { return second(now()); }
+int second(time_t t) { refreshCache(t); return g_cache_tm.Second; }
+
+int day() { return day(now()); }
+int day(time_t t) { refreshCache(t); return g_cache_tm.Day; }
+
+int weekday() { return weekday(now()); }
+int weekday(time_t t) { refreshCache(t); return g_cache_tm.Wday; }
+
+int month() { return month(now()); }
+int month(time_t t) { refreshCache(t); return g_cache_tm.Month; }
+
+int year() { return year(now()); }
+int year(time_t t) { refreshCache(t); return tmYearToCalendar(g_cache_tm.Year); }
@@ -0,0 +1,122 @@
+/**
+ * \file wire.cpp
+ * \brief Wire library for the host build: transfers go to the device models connected to the
+ *        simulated I2C bus (see smrtobj::sim::attach).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <Wire.h>
+
+#include "simulation.h"
+#include "simulation_p.h"
+
+TwoWire Wire;
+
+TwoWire::TwoWire() :
+    m_tx_address(0),
+    m_tx_length(0),
+    m_tx_overflow(false),
+    m_rx_length(0),
+    m_rx_index(0)
+{
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+  m_tx_address = address;
+  m_tx_length = 0;
+  m_tx_overflow = false;
+}
+
+uint8_t TwoWire::endTransmission(uint8_t sendStop)
+{
+  (void) sendStop;
+
+  smrtobj::sim::countTransfer();
+
+  smrtobj::i2c::I2CSimDevice *d = smrtobj::sim::find(m_tx_address);
+
+  uint8_t length = m_tx_length;
+  bool overflow = m_tx_overflow;
+
+  m_tx_length = 0;
+  m_tx_overflow = false;
+
+  if (!d)
+  {
+    return 2;
+  }
+
+  if ( !d->write(m_tx, length) )
+  {
+    return 3;
+  }
+
+  return overflow ? 1 : 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop)
+{
+  (void) sendStop;
+
+  smrtobj::sim::countTransfer();
+
+  m_rx_length = 0;
+  m_rx_index = 0;
+
+  if (quantity > BUFFER_LENGTH)
+  {
+    quantity = BUFFER_LENGTH;
+  }
+
+  smrtobj::i2c::I2CSimDevice *d = smrtobj::sim::find(address);
+
+  if ( !d || quantity == 0 || !d->read(m_rx, quantity) )
+  {
+    return 0;
+  }
+
+  m_rx_length = quantity;
+
+  return quantity;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+  if (m_tx_length >= BUFFER_LENGTH)
+  {
+    m_tx_overflow = true;
+    return 0;
+  }
+
+  m_tx[m_tx_length++] = data;
+
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity)
+{
+  size_t n = 0;
+
+  for (; n < quantity && write(data[n]); n++)
+  {
+  }
+
+  return n;
+}
+
+int TwoWire::available(void)
+{
+  return m_rx_length - m_rx_index;
+}
+
+int TwoWire::read(void)
+{
+  return (m_rx_index < m_rx_length) ? m_rx[m_rx_index++] : -1;
+}
+
+int TwoWire::peek(void)
+{
+  return (m_rx_index < m_rx_length) ? m_rx[m_rx_index] : -1;
+}
@@ -0,0 +1,80 @@
+/**
+ * \file check.h
+ * \brief Checks of the host tests: a failed check prints its position and the test program returns an
+ *        error to ctest.
+ *
+ * \code{.cpp}
+ * int main()
+ * {
+ *   CHECK(adc.read());
+ *   CHECK_EQUAL(adc.value(), 16384);
+ *   CHECK_NEAR(adc.measure(), 2.5, 0.001);
+ *
+ *   return report();
+ * }
+ * \endcode
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef CHECK_H_
+#define CHECK_H_
+
+#include <stdio.h>
+#include <math.h>
+
+//! Number of checks done
+static unsigned long g_checks = 0;
+
+//! Number of failed checks
+static unsigned long g_failures = 0;
+
+/**
+ * Records the result of a check.
+ *
+ * \param[in] ok result
+ * \param[in] expr text of the check
+ * \param[in] file source file
+ * \param[in] line source line
+ *
+ * \return result
+ */
+static inline bool check(bool ok, const char *expr, const char *file, int line)
+{
+  g_checks++;
+
+  if (!ok)
+  {
+    g_failures++;
+    printf("%s:%d: check failed: %s\n", file, line, expr);
+  }
+
+  return ok;
+}
+
+/**
+ * Prints the number of failed checks.
+ *
+ * \return exit code of the test program: 0 if all checks passed, 1 otherwise
+ */
+static inline int report()
+{
+  printf("%lu checks, %lu failed\n", g_checks, g_failures);
+
+  return (g_failures == 0) ? 0 : 1;
+}
+
+//! Checks that an expression is true
+#define CHECK(expr) check((expr), #expr, __FILE__, __LINE__)
+
+//! Checks that two integer values are equal
+#define CHECK_EQUAL(a, b) \
+  (check((long long) (a) == (long long) (b), #a " == " #b, __FILE__, __LINE__) \
+    || (printf("  %lld != %lld\n", (long long) (a), (long long) (b)), false))
+
+//! Checks that two real values differ at most by tol
+#define CHECK_NEAR(a, b, tol) \
+  (check(fabs((double) (a) - (double) (b)) <= (tol), #a " ~ " #b, __FILE__, __LINE__) \
+    || (printf("  %g != %g\n", (double) (a), (double) (b)), false))
+
+#endif /* CHECK_H_ */
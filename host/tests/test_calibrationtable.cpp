@@ -0,0 +1,303 @@
+/**
+ * \file test_calibrationtable.cpp
+ * \brief Tests of CalibrationTable: interpolation and extrapolation of the piecewise-linear tables,
+ *        polynomials, records saved to and loaded from the EEPROM of the simulated board and rejection of
+ *        corrupted records.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <smrtobjio.h>
+#include <simulation.h>
+
+#include "check.h"
+
+using namespace smrtobj;
+using namespace smrtobj::io;
+
+/**
+ * Flips a byte of a record in EEPROM, keeping the checksum valid if required.
+ */
+static void corrupt(const CalibrationTable &t, uint16_t address, uint16_t offset, uint8_t mask,
+    bool checksum)
+{
+  sim::setEEPROM(address + offset, sim::eeprom(address + offset) ^ mask);
+
+  if (checksum)
+  {
+    uint16_t last = address + t.storageSize() - 1;
+
+    sim::setEEPROM(last, sim::eeprom(last) ^ mask);
+  }
+}
+
+static void testEmpty()
+{
+  CalibrationTable t;
+  float in[3] = { -1.5, 0, 1e6 };
+  float out[3] = { 0, 0, 0 };
+
+  CHECK_EQUAL(t.type(), CalibrationTable::NONE);
+  CHECK_EQUAL(t.count(), 0);
+  CHECK_NEAR(t.apply(12.25), 12.25, 0);
+
+  t.apply(in, out, 3);
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    CHECK_NEAR(out[i], in[i], 0);
+  }
+}
+
+static void testLinear()
+{
+  CalibrationTable t;
+
+  float x[3] = { 0, 10, 20 };
+  float y[3] = { 1, 21, 31 };
+
+  CHECK(t.setPoints(x, y, 3));
+  CHECK_EQUAL(t.type(), CalibrationTable::LINEAR);
+  CHECK_EQUAL(t.count(), 3);
+
+  // Points and interpolation
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    CHECK_NEAR(t.apply(x[i]), y[i], 1e-5);
+  }
+  CHECK_NEAR(t.apply(5), 11, 1e-5);
+  CHECK_NEAR(t.apply(15), 26, 1e-5);
+  CHECK_NEAR(t.apply(19.5), 30.5, 1e-5);
+
+  // Extrapolation with the first and the last segments
+  CHECK_NEAR(t.apply(-10), -19, 1e-5);
+  CHECK_NEAR(t.apply(30), 41, 1e-5);
+
+  // Largest table: y = x^2 on the points, linear in between
+  float xs[CalibrationTable::MAX_POINTS];
+  float ys[CalibrationTable::MAX_POINTS];
+
+  for (uint8_t i = 0; i < CalibrationTable::MAX_POINTS; i++)
+  {
+    xs[i] = i;
+    ys[i] = i * i;
+  }
+
+  CHECK(t.setPoints(xs, ys, CalibrationTable::MAX_POINTS));
+
+  for (uint8_t i = 0; i + 1 < CalibrationTable::MAX_POINTS; i++)
+  {
+    CHECK_NEAR(t.apply(i), i * i, 1e-4);
+    CHECK_NEAR(t.apply(i + 0.5), (i * i + (i + 1) * (i + 1)) / 2.0, 1e-4);
+  }
+  CHECK_NEAR(t.apply(8), 49 + 13, 1e-4);
+  CHECK_NEAR(t.apply(-1), -1, 1e-4);
+
+  // Bulk conversion, also in place
+  float in[20];
+  float out[20];
+
+  for (uint8_t i = 0; i < 20; i++)
+  {
+    in[i] = -2 + i * 0.5;
+  }
+
+  t.apply(in, out, 20);
+  for (uint8_t i = 0; i < 20; i++)
+  {
+    CHECK_NEAR(out[i], t.apply(in[i]), 0);
+  }
+
+  t.apply(in, in, 20);
+  for (uint8_t i = 0; i < 20; i++)
+  {
+    CHECK_NEAR(in[i], out[i], 0);
+  }
+
+  // Invalid tables are rejected and the table is not changed
+  float same[3] = { 0, 10, 10 };
+  float decreasing[3] = { 0, 10, 5 };
+
+  CHECK(!t.setPoints(x, y, 1));
+  CHECK(!t.setPoints(xs, ys, CalibrationTable::MAX_POINTS + 1));
+  CHECK(!t.setPoints(same, y, 3));
+  CHECK(!t.setPoints(decreasing, y, 3));
+  CHECK_EQUAL(t.count(), CalibrationTable::MAX_POINTS);
+  CHECK_NEAR(t.apply(2.5), 6.5, 1e-4);
+
+  t.clear();
+  CHECK_EQUAL(t.type(), CalibrationTable::NONE);
+  CHECK_NEAR(t.apply(2.5), 2.5, 0);
+}
+
+static void testPolynomial()
+{
+  CalibrationTable t;
+
+  // y = 1 + 2x + 3x^2
+  float c[3] = { 1, 2, 3 };
+
+  CHECK(t.setPolynomial(c, 3));
+  CHECK_EQUAL(t.type(), CalibrationTable::POLYNOMIAL);
+  CHECK_NEAR(t.apply(0), 1, 1e-6);
+  CHECK_NEAR(t.apply(2), 17, 1e-5);
+  CHECK_NEAR(t.apply(-1.5), 1 - 3 + 6.75, 1e-5);
+
+  // Offset only
+  CHECK(t.setPolynomial(c, 1));
+  CHECK_NEAR(t.apply(123), 1, 0);
+
+  // Largest polynomial: y = x^7
+  float p[CalibrationTable::MAX_POINTS] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+  CHECK(t.setPolynomial(p, CalibrationTable::MAX_POINTS));
+  CHECK_NEAR(t.apply(2), 128, 1e-4);
+  CHECK_NEAR(t.apply(-1), -1, 1e-6);
+
+  CHECK(!t.setPolynomial(c, 0));
+  CHECK(!t.setPolynomial(p, CalibrationTable::MAX_POINTS + 1));
+  CHECK_EQUAL(t.count(), CalibrationTable::MAX_POINTS);
+}
+
+static void testSaveLoad()
+{
+  sim::reset();
+
+  float x[3] = { 0, 10, 20 };
+  float y[3] = { 1, 21, 31 };
+  float c[2] = { -0.5, 1.01 };
+
+  CalibrationTable linear, polynomial, empty;
+
+  CHECK(linear.setPoints(x, y, 3));
+  CHECK(polynomial.setPolynomial(c, 2));
+
+  CHECK_EQUAL(linear.storageSize(), 4 + 3 * 8);
+  CHECK_EQUAL(polynomial.storageSize(), 4 + 2 * 4);
+  CHECK_EQUAL(empty.storageSize(), 4);
+
+  // Erased EEPROM: nothing to load
+  CalibrationTable t;
+
+  CHECK(!t.load(0));
+  CHECK_EQUAL(t.type(), CalibrationTable::NONE);
+
+  // Records one after the other
+  uint16_t a0 = 0;
+  uint16_t a1 = a0 + linear.storageSize();
+  uint16_t a2 = a1 + polynomial.storageSize();
+
+  CHECK(linear.save(a0));
+  CHECK(polynomial.save(a1));
+  CHECK(empty.save(a2));
+
+  CHECK_EQUAL(sim::eeprom(a0), CalibrationTable::MAGIC);
+  CHECK_EQUAL(sim::eeprom(a0 + 1), CalibrationTable::LINEAR);
+  CHECK_EQUAL(sim::eeprom(a0 + 2), 3);
+  CHECK_EQUAL(sim::eeprom(a1), CalibrationTable::MAGIC);
+  CHECK_EQUAL(sim::eeprom(a1 + 1), CalibrationTable::POLYNOMIAL);
+  CHECK_EQUAL(sim::eeprom(a2 + 1), CalibrationTable::NONE);
+  CHECK_EQUAL(sim::eeprom(a2 + empty.storageSize()), 0xFF);
+
+  // Saving the same table again does not write the EEPROM
+  unsigned long writes = sim::eepromWrites();
+
+  CHECK(linear.save(a0));
+  CHECK_EQUAL(sim::eepromWrites(), writes);
+
+  CalibrationTable l, p, e;
+
+  CHECK(l.load(a0));
+  CHECK(p.load(a1));
+  CHECK(e.setPolynomial(c, 2));
+  CHECK(e.load(a2));
+
+  CHECK_EQUAL(l.type(), CalibrationTable::LINEAR);
+  CHECK_EQUAL(l.count(), 3);
+  CHECK_EQUAL(p.type(), CalibrationTable::POLYNOMIAL);
+  CHECK_EQUAL(p.count(), 2);
+  CHECK_EQUAL(e.type(), CalibrationTable::NONE);
+
+  for (float v = -30; v <= 30; v += 0.75)
+  {
+    CHECK_NEAR(l.apply(v), linear.apply(v), 0);
+    CHECK_NEAR(p.apply(v), polynomial.apply(v), 0);
+  }
+}
+
+static void testCorrupted()
+{
+  sim::reset();
+
+  float x[3] = { 0, 10, 20 };
+  float y[3] = { 1, 21, 31 };
+  float c[2] = { -0.5, 1.01 };
+
+  CalibrationTable linear;
+
+  CHECK(linear.setPoints(x, y, 3));
+  CHECK(linear.save(0));
+
+  // The table loaded before is kept when a record is rejected
+  CalibrationTable t;
+
+  CHECK(t.setPolynomial(c, 2));
+
+  uint16_t checksum = linear.storageSize() - 1;
+
+  // Checksum
+  corrupt(linear, 0, checksum, 0x01, false);
+  CHECK(!t.load(0));
+  corrupt(linear, 0, checksum, 0x01, false);
+  CHECK(t.load(0));
+  CHECK(t.setPolynomial(c, 2));
+
+  // Points
+  for (uint16_t offset = 3; offset < checksum; offset += 5)
+  {
+    corrupt(linear, 0, offset, 0x40, false);
+    CHECK(!t.load(0));
+    corrupt(linear, 0, offset, 0x40, false);
+  }
+
+  // Magic byte, also with a valid checksum
+  corrupt(linear, 0, 0, 0x80, false);
+  CHECK(!t.load(0));
+  corrupt(linear, 0, 0, 0x80, false);
+
+  corrupt(linear, 0, 0, 0x80, true);
+  CHECK(!t.load(0));
+  corrupt(linear, 0, 0, 0x80, true);
+
+  // Type and number of points not valid, with a valid checksum
+  corrupt(linear, 0, 1, 0x07, true);
+  CHECK(!t.load(0));
+  corrupt(linear, 0, 1, 0x07, true);
+
+  corrupt(linear, 0, 2, 0x08, true);
+  CHECK(!t.load(0));
+  corrupt(linear, 0, 2, 0x08, true);
+
+  // Points not increasing, with a valid checksum: x[1] = -10
+  corrupt(linear, 0, 3 + 8 + 3, 0x80, true);
+  CHECK(!t.load(0));
+  corrupt(linear, 0, 3 + 8 + 3, 0x80, true);
+
+  CHECK_EQUAL(t.type(), CalibrationTable::POLYNOMIAL);
+  CHECK_NEAR(t.apply(10), 9.6, 1e-5);
+
+  // The record restored is valid
+  CHECK(t.load(0));
+  CHECK_EQUAL(t.type(), CalibrationTable::LINEAR);
+  CHECK_NEAR(t.apply(5), 11, 1e-5);
+}
+
+int main()
+{
+  testEmpty();
+  testLinear();
+  testPolynomial();
+  testSaveLoad();
+  testCorrupted();
+
+  return report();
+}
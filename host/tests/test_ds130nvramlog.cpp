@@ -0,0 +1,280 @@
+/**
+ * \file test_ds130nvramlog.cpp
+ * \brief Tests of DS130NVRAMLog against the RAM of the DS1307 model.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <smrtobji2ctime.h>
+#include <devices/DS130NVRAMLog.h>
+#include <simulation.h>
+#include <models.h>
+
+#include "check.h"
+
+using namespace smrtobj;
+using namespace smrtobj::i2c;
+
+/**
+ * Fills the RAM of the model with a value (the content of the RAM at the first power on).
+ */
+static void fill(sim::DS1307Model &model, uint8_t value)
+{
+  for (uint8_t reg = sim::DS1307Model::RAM_START; reg < sim::DS1307Model::REGISTERS; reg++)
+  {
+    model.setReg(reg, value);
+  }
+}
+
+/**
+ * Checks that the newest records of a log are the last \e k values appended (record i is filled with
+ * the value i).
+ */
+static bool newest(DS130NVRAMLog &log, int k, uint8_t n)
+{
+  uint8_t data[DS130NVRAMLog::MAX_RECORD];
+
+  for (uint8_t j = 0; j < n && j < log.count(); j++)
+  {
+    if ( !log.get(j, data) || data[0] != (uint8_t) (k - j) || data[log.size() - 1] != (uint8_t) (k - j) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void testFormat()
+{
+  sim::reset();
+
+  sim::DS1307Model model;
+  sim::attach(model);
+  fill(model, 0xEE);
+
+  DS130NVRAMLog log(4);
+
+  CHECK(log.isConnected());
+  CHECK(log.initialize());
+  CHECK_EQUAL(log.size(), 4);
+  CHECK_EQUAL(log.capacity(), (DS130NVRAMLog::NVRAM_SIZE - DS130NVRAMLog::HEADER_LENGTH) / 5);
+  CHECK_EQUAL(log.count(), 0);
+  CHECK_EQUAL(log.sequence(), 0);
+  CHECK_EQUAL(model.reg(DS130NVRAMLog::NVRAM_START), DS130NVRAMLog::MARKER);
+  CHECK_EQUAL(model.reg(DS130NVRAMLog::NVRAM_START + 1), 4);
+
+  uint8_t data[4];
+  CHECK(!log.get(0, data));
+
+  // A log with another record size formats the RAM again
+  uint8_t record[4] = { 1, 2, 3, 4 };
+  CHECK(log.append(record));
+  CHECK(log.flush());
+
+  DS130NVRAMLog other(2);
+  CHECK(other.initialize());
+  CHECK_EQUAL(other.count(), 0);
+  CHECK_EQUAL(model.reg(DS130NVRAMLog::NVRAM_START + 1), 2);
+
+  CHECK(other.append(record));
+  CHECK(other.clear());
+  CHECK_EQUAL(other.count(), 0);
+  CHECK(!other.get(0, data));
+
+  // The time registers are never written
+  CHECK(!model.halted());
+}
+
+/**
+ * Appends 300 records of each size, with flushes at random times, and reloads the log from the RAM
+ * through a new object.
+ */
+static void testRing(uint8_t size)
+{
+  sim::reset();
+
+  sim::DS1307Model model;
+  sim::attach(model);
+  fill(model, 0xEE);
+
+  DS130NVRAMLog log(size);
+  CHECK(log.initialize());
+
+  unsigned long failures = 0;
+  uint8_t data[DS130NVRAMLog::MAX_RECORD];
+
+  for (int k = 1; k <= 300; k++)
+  {
+    memset(data, k, size);
+    CHECK(log.append(data));
+
+    if (k % 7 == 0)
+    {
+      CHECK(log.flush());
+    }
+
+    if ( !newest(log, k, 5) )
+    {
+      failures++;
+    }
+
+    if (k % 13 == 0)
+    {
+      CHECK(log.flush());
+
+      DS130NVRAMLog copy(size);
+
+      if ( !copy.initialize() || copy.count() != log.count() || copy.sequence() != log.sequence()
+           || !newest(copy, k, copy.count()) )
+      {
+        failures++;
+      }
+    }
+  }
+
+  CHECK_EQUAL(failures, 0);
+  CHECK_EQUAL(log.count(), log.capacity());
+  CHECK(!model.halted());
+}
+
+/**
+ * Checks that a log reloaded from the RAM holds only complete records, consecutive and starting from a
+ * value between \e first and \e last.
+ */
+static bool consistent(uint8_t size, int first, int last)
+{
+  DS130NVRAMLog copy(size);
+  uint8_t data[DS130NVRAMLog::MAX_RECORD];
+
+  if ( !copy.initialize() || copy.count() == 0 || !copy.get(0, data) )
+    return false;
+
+  int k = data[0];
+
+  if ( k < first || k > last || !newest(copy, k, copy.count()) )
+    return false;
+
+  // The sequence goes on from the newest record
+  memset(data, k + 1, size);
+
+  if ( !copy.append(data) || !copy.flush() )
+    return false;
+
+  DS130NVRAMLog reloaded(size);
+
+  return reloaded.initialize() && reloaded.count() >= copy.count() && newest(reloaded, k + 1, reloaded.count());
+}
+
+/**
+ * Cuts the power after each byte of a flush and of a clear: the records not written completely are
+ * lost, the others are kept.
+ */
+static void testPowerFail(uint8_t size)
+{
+  unsigned long failures = 0;
+  uint8_t data[DS130NVRAMLog::MAX_RECORD];
+
+  for (long limit = 0; ; limit++)
+  {
+    sim::reset();
+
+    sim::DS1307Model model;
+    sim::attach(model);
+    fill(model, 0xEE);
+
+    DS130NVRAMLog log(size);
+    CHECK(log.initialize());
+
+    // Full ring, then up to 3 records in the buffer
+    int k = 1;
+    for (; k <= log.capacity() + 5; k++)
+    {
+      memset(data, k, size);
+      CHECK(log.append(data));
+    }
+    CHECK(log.flush());
+
+    int last = k - 1;
+    for (uint8_t i = 0; i < 3 && (i + 2) * (size + 1) <= DS130NVRAMLog::TRANSFER_LENGTH; i++, k++)
+    {
+      memset(data, k, size);
+      CHECK(log.append(data));
+    }
+
+    unsigned long stored = model.stored();
+    model.setWriteLimit(limit);
+    bool ok = log.flush();
+    model.setWriteLimit(-1);
+    unsigned long written = model.stored() - stored;
+
+    if ( !consistent(size, last, k - 1) )
+    {
+      printf("  size %u: inconsistent log after %ld bytes of a flush\n", size, limit);
+      failures++;
+    }
+
+    // The whole flush is written: one byte per slot to empty it, then the records
+    if (ok)
+    {
+      CHECK_EQUAL(written, limit);
+      break;
+    }
+  }
+
+  for (long limit = 0; ; limit++)
+  {
+    sim::reset();
+
+    sim::DS1307Model model;
+    sim::attach(model);
+    fill(model, 0xEE);
+
+    DS130NVRAMLog log(size);
+    CHECK(log.initialize());
+
+    for (int k = 1; k <= 10; k++)
+    {
+      memset(data, k, size);
+      CHECK(log.append(data));
+    }
+    CHECK(log.flush());
+
+    model.setWriteLimit(limit);
+    bool ok = log.clear();
+    model.setWriteLimit(-1);
+
+    // Either the log is empty or it is not changed
+    DS130NVRAMLog copy(size);
+    CHECK(copy.initialize());
+
+    if ( copy.count() != 0 && !(copy.count() == ((log.capacity() < 10) ? log.capacity() : 10) && newest(copy, 10, copy.count())) )
+    {
+      printf("  size %u: inconsistent log after %ld bytes of a clear\n", size, limit);
+      failures++;
+    }
+
+    if (ok)
+    {
+      CHECK_EQUAL(copy.count(), 0);
+      break;
+    }
+  }
+
+  CHECK_EQUAL(failures, 0);
+}
+
+int main()
+{
+  testFormat();
+
+  static const uint8_t sizes[] = { 1, 2, 4, 7, 16 };
+
+  for (unsigned int i = 0; i < sizeof(sizes); i++)
+  {
+    testRing(sizes[i]);
+    testPowerFail(sizes[i]);
+  }
+
+  return report();
+}
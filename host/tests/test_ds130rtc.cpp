@@ -0,0 +1,183 @@
+/**
+ * \file test_ds130rtc.cpp
+ * \brief Tests of DS130RTC against the DS1307 model: registers, and the clock computed from millis()
+ *        with an oscillator drift.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <smrtobji2ctime.h>
+#include <simulation.h>
+#include <models.h>
+
+#include "check.h"
+
+using namespace smrtobj;
+using namespace smrtobj::i2c;
+
+//! 2020-02-29 23:59:50
+static const time_t START = 1583020790UL;
+
+static void testRegisters()
+{
+  sim::reset();
+
+  sim::DS1307Model model;
+  sim::attach(model);
+
+  DS130RTC rtc;
+
+  model.setTime(START);
+  CHECK(rtc.isConnected());
+  CHECK_EQUAL(rtc.time(), START);
+
+  // Leap day to 1 March
+  sim::advanceMillis(15000);
+  CHECK(rtc.read());
+  CHECK_EQUAL(rtc.time(), START + 15);
+
+  CHECK(rtc.write(START + 86400L * 365));
+  CHECK_EQUAL(model.time(), START + 86400L * 365);
+  CHECK(!model.halted());
+  CHECK(rtc.read());
+  CHECK_EQUAL(rtc.time(), START + 86400L * 365);
+}
+
+/**
+ * Runs the clock for three days with a board oscillator error of \e ppm, checking now() every
+ * 250 ms. The board starts at \e board milliseconds, so millis() can roll over during the run.
+ */
+static void testClock(long ppm, unsigned long long board = 0)
+{
+  sim::reset();
+
+  sim::DS1307Model model;
+  sim::attach(model);
+
+  DS130RTC rtc;
+
+  model.setTime(START);
+  sim::setMicros(board * 1000ULL);
+  sim::advanceMillis(437);
+  sim::setDrift(ppm);
+
+  sim::setAutoStep(100);
+  CHECK(rtc.startClock());
+  sim::setAutoStep(0);
+  CHECK(rtc.isClockRunning());
+
+  unsigned long reads = model.reads();
+  unsigned long mismatches = 0;
+  unsigned long steps = 0;
+  long error = 0;
+
+  for (unsigned long t = 0; t < 3UL * 86400 * 1000; t += 250, steps++)
+  {
+    sim::advanceMillis(250);
+
+    long e = (long) (rtc.now() - model.time());
+
+    if (labs(e) > labs(error))
+    {
+      error = e;
+    }
+
+    if (e != 0)
+    {
+      mismatches++;
+    }
+  }
+
+  printf("drift %5ld ppm: measured %5ld ppm, %lu reads, max error %ld s, %.2f %% seconds mismatched\n",
+         ppm, rtc.drift(), model.reads() - reads, error, 100.0 * mismatches / steps);
+
+  // Between two syncs the phase error can grow up to DRIFT_ACCURACY ppm of the interval (180 ms)
+  CHECK(labs(error) <= 1);
+  CHECK(mismatches * 5 < steps);
+  CHECK_NEAR((double) rtc.drift(), -ppm * 1e6 / (1e6 + ppm), 20);
+
+  // The RTC is read once per sync interval, once the drift is measured
+  CHECK(model.reads() - reads < 3UL * 24 + 60 * 2);
+}
+
+/**
+ * Disconnects the RTC while the clock is running: a failed sync is tried again once per interval, and
+ * the clock keeps running meanwhile.
+ */
+static void testFailedSync()
+{
+  sim::reset();
+
+  sim::DS1307Model model;
+  sim::attach(model);
+
+  DS130RTC rtc;
+
+  model.setTime(START);
+  sim::setAutoStep(100);
+  CHECK(rtc.startClock());
+  sim::setAutoStep(0);
+
+  // Until the drift is measured the RTC is read every SYNC_INTERVAL_START seconds
+  const unsigned long interval = DS130RTC::SYNC_INTERVAL_START * 1000;
+
+  sim::detach(model);
+  sim::advanceMillis(interval);
+
+  unsigned long transfers = sim::transfers();
+  CHECK_EQUAL(rtc.now(), model.time());
+  unsigned long attempt = sim::transfers() - transfers;
+  CHECK(attempt > 0);
+
+  // No bus access until the next interval
+  for (unsigned long t = 10; t < interval; t += 10)
+  {
+    sim::advanceMillis(10);
+    rtc.now();
+  }
+  CHECK_EQUAL(sim::transfers(), transfers + attempt);
+  CHECK(labs((long) (rtc.now() - model.time())) <= 1);
+
+  sim::advanceMillis(10);
+  rtc.now();
+  CHECK_EQUAL(sim::transfers(), transfers + 2 * attempt);
+
+  // The RTC is back: the next attempt syncs the clock
+  sim::attach(model);
+  sim::advanceMillis(interval);
+  transfers = sim::transfers();
+  CHECK(labs((long) (rtc.now() - model.time())) <= 1);
+  CHECK(sim::transfers() > transfers);
+
+  transfers = sim::transfers();
+  for (unsigned long t = 0; t < interval - 1000; t += 10)
+  {
+    sim::advanceMillis(10);
+    CHECK(labs((long) (rtc.now() - model.time())) <= 1);
+  }
+  CHECK_EQUAL(sim::transfers(), transfers);
+}
+
+int main()
+{
+  testRegisters();
+  testFailedSync();
+
+  static const long drifts[] = { -5000, -500, 0, 100, 2000 };
+
+  for (unsigned int i = 0; i < sizeof(drifts) / sizeof(drifts[0]); i++)
+  {
+    testClock(drifts[i]);
+  }
+
+  // millis() rolls over after one day (with a 32 bit long, see SMRTOBJ_HOST_M32)
+  if (sizeof(unsigned long) > 4)
+  {
+    printf("long is %u bits: millis() does not roll over\n", (unsigned int) sizeof(unsigned long) * 8);
+  }
+
+  testClock(-500, 0x100000000ULL - 86400000ULL);
+  testClock(2000, 0x100000000ULL - 86400000ULL);
+
+  return report();
+}
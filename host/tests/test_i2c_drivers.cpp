@@ -0,0 +1,389 @@
+/**
+ * \file test_i2c_drivers.cpp
+ * \brief Tests of the i2c drivers of SmrtObjI2C against the device models: blocking functions
+ *        (Wire and I2Cdev), queued transactions (I2CSimBus and WireBus) and multiplexer routing.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <smrtobji2c.h>
+#include <simulation.h>
+#include <models.h>
+
+#include "check.h"
+
+using namespace smrtobj;
+using namespace smrtobj::i2c;
+
+/**
+ * Polls a transaction of a driver until it ends.
+ */
+template <class T>
+static int8_t finish(T &driver)
+{
+  int8_t status;
+
+  while ( (status = driver.poll()) == I2CTransaction::QUEUED || status == I2CTransaction::RUNNING )
+  {
+  }
+
+  return status;
+}
+
+static void testADS1100()
+{
+  sim::reset();
+
+  sim::ADS1100Model model;
+  sim::attach(model);
+
+  ADS1100 adc;
+
+  model.setVoltage(2.5);
+  CHECK(adc.initialize());
+  CHECK(adc.isConnected());
+  CHECK_EQUAL(adc.value(), 16384);
+  CHECK_NEAR(adc.measure(), 2.5, 0.001);
+
+  model.setVoltage(1.0);
+  CHECK(adc.read());
+  CHECK_EQUAL(adc.value(), model.code());
+  CHECK_NEAR(adc.measure(), 1.0, 0.001);
+
+  sim::detach(model);
+  CHECK(!adc.read());
+}
+
+static void testHIH7121()
+{
+  sim::reset();
+
+  sim::HIH7121Model model;
+  sim::attach(model);
+
+  HIH7121 hih;
+
+  model.setHumidity(45.0);
+  model.setTemperature(21.5);
+
+  // The first read gets the data of the previous measurement and requests a new one
+  CHECK(hih.read());
+  CHECK_EQUAL(hih.status(), 1);
+  CHECK_EQUAL(model.conversions(), 1);
+
+  sim::advance(sim::HIH7121Model::MEASUREMENT_TIME);
+  CHECK(hih.read());
+  CHECK_EQUAL(hih.status(), 0);
+  CHECK_NEAR(hih.humidity(), 45.0, 0.01);
+  CHECK_NEAR(hih.temperature(), 21.5, 0.02);
+
+  // Read too early: the data is not fresh
+  CHECK(hih.read());
+  CHECK_EQUAL(hih.status(), 1);
+
+  // Queued read of a completed measurement
+  sim::advance(sim::HIH7121Model::MEASUREMENT_TIME);
+
+  I2CSimBus bus(2);
+  bus.attach(model);
+  I2CQueue::setBus(bus);
+
+  model.setHumidity(60.0);
+  CHECK(hih.begin());
+  CHECK_EQUAL(finish(hih), I2CTransaction::DONE);
+  CHECK_EQUAL(hih.status(), 0);
+  CHECK_NEAR(hih.humidity(), 45.0, 0.01);
+  CHECK_EQUAL(bus.transactions(), 1);
+
+  HIH7121 missing(0x30);
+  CHECK(missing.begin());
+  CHECK_EQUAL(finish(missing), I2CTransaction::ERROR_ADDRESS);
+}
+
+static void testIAQ2000()
+{
+  sim::reset();
+
+  sim::IAQ2000Model model;
+  sim::attach(model);
+
+  IAQ2000 iaq;
+
+  model.set(1200, 310, 250000, sim::IAQ2000Model::OK);
+  CHECK(iaq.isConnected());
+  CHECK_EQUAL(iaq.value(), 1200);
+  CHECK_EQUAL(iaq.tVOC(), 310);
+  CHECK_EQUAL(iaq.resistance(), 250000);
+  CHECK_EQUAL(iaq.status(), sim::IAQ2000Model::OK);
+  CHECK_NEAR(iaq.measure(), 1200, 0.001);
+
+  model.set(400, 0, 0, sim::IAQ2000Model::RUNIN);
+  CHECK(!iaq.isConnected());
+  CHECK_EQUAL(iaq.status(), sim::IAQ2000Model::RUNIN);
+
+  // Queued read through Wire
+  WireBus bus;
+  I2CQueue::setBus(bus);
+
+  model.set(800, 150, 120000, sim::IAQ2000Model::BUSY);
+  CHECK(iaq.begin());
+  CHECK_EQUAL(finish(iaq), I2CTransaction::DONE);
+  CHECK_EQUAL(iaq.value(), 800);
+  CHECK_EQUAL(iaq.tVOC(), 150);
+  CHECK_EQUAL(iaq.status(), sim::IAQ2000Model::BUSY);
+}
+
+static void testT6713()
+{
+  sim::reset();
+
+  sim::T6713Model model;
+  sim::attach(model);
+
+  T6713 co2;
+
+  model.setPpm(612);
+  CHECK(co2.isConnected());
+  CHECK_EQUAL(co2.rgstr(), 612);
+  CHECK_NEAR(co2.measure(), 612, 0.001);
+
+  model.setStatus(T6713::ERROR | T6713::CALIBRATION_ERROR);
+  CHECK(co2.readStatus());
+  CHECK_EQUAL(co2.rgstr(), T6713::ERROR | T6713::CALIBRATION_ERROR);
+
+  // Queued command and response, on both buses
+  I2CSimBus sim_bus(3);
+  sim_bus.attach(model);
+  I2CQueue::setBus(sim_bus);
+
+  model.setPpm(980);
+  unsigned long n = model.commands();
+  CHECK(co2.begin());
+  CHECK_EQUAL(finish(co2), I2CTransaction::DONE);
+  CHECK_EQUAL(co2.rgstr(), 980);
+  CHECK_EQUAL(model.commands(), n + 1);
+
+  WireBus wire_bus;
+  I2CQueue::setBus(wire_bus);
+
+  model.setPpm(1500);
+  CHECK(co2.begin());
+  CHECK_EQUAL(finish(co2), I2CTransaction::DONE);
+  CHECK_EQUAL(co2.rgstr(), 1500);
+
+  CHECK(co2.begin(T6713::FIRMWARE));
+  CHECK_EQUAL(finish(co2), I2CTransaction::DONE);
+  CHECK_EQUAL(co2.rgstr(), 0x0100);
+}
+
+static void testTCS34725()
+{
+  sim::reset();
+
+  sim::TCS34725Model model;
+  sim::attach(model);
+
+  TCS34725 color;
+
+  CHECK(color.isConnected());
+  CHECK(color.initialize());
+  CHECK_EQUAL(model.reg(TCS34725::ENABLE_ADDR) & 0x03, 0x03);
+  CHECK_EQUAL(model.reg(TCS34725::CONFIG_ADDR), 2);
+
+  model.setColor(4000, 1200, 2300, 500);
+  CHECK(color.read());
+  CHECK_EQUAL(color.clear_color(), 4000);
+  CHECK_EQUAL(color.red_color(), 1200);
+  CHECK_EQUAL(color.green_color(), 2300);
+  CHECK_EQUAL(color.blue_color(), 500);
+}
+
+static void testPCA9548A()
+{
+  sim::reset();
+
+  sim::PCA9548AModel model;
+  sim::attach(model);
+
+  PCA9548A mux;
+
+  CHECK(mux.isConnected());
+  CHECK(mux.setChannels(0x81));
+  CHECK_EQUAL(model.control(), 0x81);
+  CHECK(mux.setChannel(3, true));
+  CHECK_EQUAL(model.control(), 0x89);
+  CHECK(mux.read());
+  CHECK_EQUAL(mux.registerCtrl(), 0x89);
+
+  // The selection of a channel is cached
+  unsigned long n = model.selections();
+  CHECK(mux.select(5));
+  CHECK(mux.select(5));
+  CHECK(mux.isSelected(5));
+  CHECK_EQUAL(model.control(), 0x20);
+  CHECK_EQUAL(model.selections(), n + 1);
+}
+
+static void testTCA6507()
+{
+  sim::reset();
+
+  sim::TCA6507Model model;
+  sim::attach(model);
+
+  TCA6507 led;
+
+  CHECK(led.initialize());
+  CHECK(led.isConnected());
+
+  led.pinSetState(TCA6507::P2, TCA6507::LED_ON);
+  CHECK_EQUAL(model.state(2), TCA6507::LED_ON);
+  CHECK(led.pinsSetState(0x41, TCA6507::LED_BLINK_BANK1));
+  CHECK_EQUAL(model.state(0), TCA6507::LED_BLINK_BANK1);
+  CHECK_EQUAL(model.state(6), TCA6507::LED_BLINK_BANK1);
+  CHECK_EQUAL(model.state(2), TCA6507::LED_ON);
+  CHECK_EQUAL(led.pinState(6), TCA6507::LED_BLINK_BANK1);
+
+  // The shadow copy skips writes that change nothing
+  unsigned long n = model.writes();
+  CHECK(led.pinsSetState(0x41, TCA6507::LED_BLINK_BANK1));
+  CHECK_EQUAL(model.writes(), n);
+
+  const uint8_t states[7] =
+  {
+    TCA6507::LED_OFF, TCA6507::LED_ON, TCA6507::LED_ON_PWM0, TCA6507::LED_ON_PWM1,
+    TCA6507::LED_ON_ONE_SHOT, TCA6507::LED_BLINK_BANK0, TCA6507::LED_OFF
+  };
+  CHECK(led.pinsSetState(states));
+  for (uint8_t pin = 0; pin < sim::TCA6507Model::OUTPUTS; pin++)
+  {
+    CHECK_EQUAL(model.state(pin), states[pin]);
+  }
+
+  CHECK(led.RAWRegDrv(TCA6507::MAXIMUM_INTENSITY, 0x77));
+  CHECK_EQUAL(model.reg(TCA6507::MAXIMUM_INTENSITY), 0x77);
+
+  model.setReg(TCA6507::ONE_SHOT, 0x0C);
+  CHECK(led.read());
+  CHECK_EQUAL(led.readReg(TCA6507::ONE_SHOT), 0x0C);
+  CHECK_EQUAL(led.readReg(TCA6507::MAXIMUM_INTENSITY), 0x77);
+}
+
+static void testPIC24FV32KA301()
+{
+  sim::reset();
+
+  sim::PIC24FV32KA301Model model;
+  sim::attach(model);
+
+  PIC24FV32KA301 pic;
+
+  CHECK(pic.setCfgReg(PIC24FV32KA301::RAD, true, 12));
+  CHECK(pic.setCfgReg(PIC24FV32KA301::PM, false, 3));
+  CHECK(!pic.setCfgReg(PIC24FV32KA301::PM, false, PIC24FV32KA301::T_MAX + 1));
+  CHECK(pic.initialize());
+  CHECK_EQUAL(model.cfg(PIC24FV32KA301::RAD), 0x8C);
+  CHECK_EQUAL(model.cfg(PIC24FV32KA301::PM), 0x03);
+
+  model.setData(PIC24FV32KA301::RAD, 0x1234);
+  model.setData(PIC24FV32KA301::PM, 875);
+  CHECK(pic.isConnected());
+  CHECK_EQUAL(pic.getDataReg(PIC24FV32KA301::RAD), 0x1234);
+  CHECK_EQUAL(pic.getDataReg(PIC24FV32KA301::PM), 875);
+  CHECK_EQUAL(pic.getCfgReg(PIC24FV32KA301::RAD), 0x8C);
+  CHECK(pic.isEnabled(PIC24FV32KA301::RAD));
+  CHECK(!pic.isEnabled(PIC24FV32KA301::PM));
+}
+
+static void testMultiplexer()
+{
+  sim::reset();
+
+  // Same sensor on four channels
+  sim::PCA9548AModel model;
+  sim::HIH7121Model models[4];
+  sim::attach(model);
+
+  PCA9548A mux;
+  HIH7121 sensors[4];
+
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    model.attach(i * 2, models[i]);
+    models[i].setHumidity(10.0 * (i + 1));
+    CHECK(sensors[i].setPath(&mux, i * 2));
+  }
+
+  // Blocking reads: request and read each measurement
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    CHECK(sensors[i].read());
+  }
+  sim::advance(sim::HIH7121Model::MEASUREMENT_TIME);
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    CHECK(sensors[i].read());
+    CHECK_EQUAL(sensors[i].status(), 0);
+    CHECK_NEAR(sensors[i].humidity(), 10.0 * (i + 1), 0.01);
+    CHECK_EQUAL(models[i].conversions(), 2);
+  }
+  CHECK_EQUAL(model.selections(), 8);
+
+  // Repeated reads of the same channel do not select it again
+  CHECK(sensors[3].read());
+  CHECK(sensors[3].read());
+  CHECK_EQUAL(model.selections(), 8);
+
+  // Queued reads through Wire: the channel is selected before each transaction
+  WireBus bus;
+  I2CQueue::setBus(bus);
+
+  sim::advance(sim::HIH7121Model::MEASUREMENT_TIME);
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    models[i].setHumidity(50.0 + i);
+    CHECK(sensors[i].read());
+  }
+  sim::advance(sim::HIH7121Model::MEASUREMENT_TIME);
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    CHECK(sensors[i].begin());
+  }
+  while ( !I2CQueue::isIdle() )
+  {
+    I2CQueue::poll();
+  }
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    CHECK_EQUAL(sensors[i].poll(), I2CTransaction::DONE);
+    CHECK_EQUAL(sensors[i].status(), 0);
+    CHECK_NEAR(sensors[i].humidity(), 50.0 + i, 0.01);
+  }
+  CHECK_EQUAL(model.control(), 0x40);
+
+  // Missing multiplexer
+  PCA9548A missing(0x71);
+  HIH7121 lost;
+  CHECK(lost.setPath(&missing, 2));
+  CHECK(!lost.read());
+  CHECK(lost.begin());
+  CHECK(finish(lost) < 0);
+  CHECK(I2CQueue::isIdle());
+}
+
+int main()
+{
+  sim::setSerialEcho(false);
+
+  testADS1100();
+  testHIH7121();
+  testIAQ2000();
+  testT6713();
+  testTCS34725();
+  testPCA9548A();
+  testTCA6507();
+  testPIC24FV32KA301();
+  testMultiplexer();
+
+  return report();
+}
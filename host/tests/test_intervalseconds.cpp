@@ -0,0 +1,105 @@
+/**
+ * \file test_intervalseconds.cpp
+ * \brief Tests of IntervalSeconds::getTimeAsString against gmtime() on the full 32 bits range.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <smrtobjtime.h>
+#include <time.h>
+
+#include "check.h"
+
+using namespace smrtobj::timer;
+
+//! strftime() formats of IntervalSeconds
+static const char *FORMATS[4] =
+{
+  "%d/%m/%Y %H:%M:%S",
+  "%m/%d/%Y %H:%M:%S",
+  "%m/%d/%Y %H:%M",
+  "%Y-%m-%dT%H:%M:%S",
+};
+
+static uint32_t g_seed = 1;
+
+static uint32_t next()
+{
+  g_seed = g_seed * 1103515245UL + 12345UL;
+
+  return g_seed;
+}
+
+/**
+ * Formats a time and compares it with gmtime().
+ */
+static bool same(IntervalSeconds &s, uint32_t t, byte format)
+{
+  s.reset(t);
+
+  const char *str = s.getTimeAsString(format);
+
+  time_t x = t;
+  struct tm g;
+  char ref[32];
+
+  gmtime_r(&x, &g);
+  strftime(ref, sizeof(ref), FORMATS[format], &g);
+
+  if (strcmp(str, ref) != 0)
+  {
+    printf("  %lu format %u: %s instead of %s\n", (unsigned long) t, format, str, ref);
+    return false;
+  }
+
+  return true;
+}
+
+int main()
+{
+  IntervalSeconds s(0UL);
+  unsigned long errors = 0;
+
+  for (unsigned long i = 0; i < 200000; i++)
+  {
+    uint32_t t;
+
+    if (i < 100000)
+    {
+      // Sweep of the range: each step moves all the fields
+      t = (uint32_t) (i * 42949UL + 1);
+    }
+    else if (i % 5 == 0)
+    {
+      // Last days before the wrap in 2106
+      t = 0xFFFFFFFFUL - (next() >> 12);
+    }
+    else
+    {
+      t = next() ^ (next() >> 16);
+    }
+
+    byte format = (byte) ((next() >> 16) % 4);
+
+    // The same minute again (cached fields) and the next seconds
+    for (uint8_t k = 0; k < 3; k++)
+    {
+      uint32_t tk = t + ( (k > 0) ? (next() >> 16) % 70 : 0 );
+
+      if (tk > 0 && !same(s, tk, format))
+      {
+        errors++;
+      }
+    }
+
+    // Same time with another format
+    if ( !same(s, t ? t : 1, (format + 1) % 4) )
+    {
+      errors++;
+    }
+  }
+
+  CHECK_EQUAL(errors, 0);
+
+  return report();
+}
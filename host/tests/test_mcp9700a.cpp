@@ -0,0 +1,85 @@
+/**
+ * \file test_mcp9700a.cpp
+ * \brief Tests of the fixed point conversion of MCP9700A and of AnalogInput::inputMillivolts, against
+ *        the floating point formulas, on every ADC value.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <smrtobjio.h>
+#include <simulation.h>
+
+#include "check.h"
+
+using namespace smrtobj;
+using namespace smrtobj::io;
+
+int main()
+{
+  static const float references[3] = { 5.0, 3.3, 2.5 };
+  static const float calibrations[3][2] = { { 0.5, 0.01 }, { 0.4, 0.0195 }, { 0.0, 0.004 } };
+
+  double max_error = 0;
+
+  sim::reset();
+
+  for (uint8_t r = 0; r < 3; r++)
+  {
+    for (uint8_t c = 0; c < 3; c++)
+    {
+      for (uint8_t bits = 0; bits <= 6; bits += 2)
+      {
+        AnalogInput::setReference(references[r]);
+
+        MCP9700A t;
+        CHECK(t.setCalibration(calibrations[c][0], calibrations[c][1]));
+        t.init(A0);
+        t.setOversampling(bits);
+
+        unsigned long millivolt_errors = 0;
+
+        for (int a = 0; a < 1024; a++)
+        {
+          sim::setAnalog(A0, a);
+
+          long centi = t.readCentiCelsius();
+          double v = (double) ((long) a << bits) * references[r] / (1L << (10 + bits));
+          double ref = (v - calibrations[c][0]) / calibrations[c][1] * 100;
+          double e = fabs(centi - ref);
+
+          if (e > max_error)
+          {
+            max_error = e;
+          }
+
+          if (fabs(t.inputMillivolts() - v * 1000) > 0.51)
+          {
+            millivolt_errors++;
+          }
+        }
+
+        CHECK_EQUAL(millivolt_errors, 0);
+
+        // The floating point values come from the last conversion (hundredths of degree)
+        sim::setAnalog(A0, 512);
+        float celsius = t.read();
+        double v = references[r] / 2;
+
+        CHECK_NEAR(celsius, (v - calibrations[c][0]) / calibrations[c][1], 0.016);
+        CHECK_NEAR(t.celsius(), celsius, 0.0001);
+        CHECK_NEAR(t.kelvin(), celsius + 273.15, 0.01);
+        CHECK_NEAR(t.farenheit(), celsius * 1.8 + 32, 0.01);
+      }
+    }
+  }
+
+  // Rounding to hundredths of degree and error of the fixed point gain
+  printf("maximum error %.4f centi degrees\n", max_error);
+  CHECK(max_error < 1.51);
+
+  // Calibrations that overflow the fixed point gain are rejected
+  MCP9700A t;
+  CHECK(!t.setCalibration(0.5, 0.0));
+
+  return report();
+}
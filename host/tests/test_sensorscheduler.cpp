@@ -0,0 +1,375 @@
+/**
+ * \file test_sensorscheduler.cpp
+ * \brief Tests of SensorScheduler: timing of the drivers, order of the acquisitions, latency, overruns,
+ *        removal of jobs from a callback and roll over of millis().
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <smrtobjio.h>
+#include <smrtobji2c.h>
+#include <simulation.h>
+
+#include "check.h"
+
+using namespace smrtobj;
+using namespace smrtobj::io;
+
+/**
+ * Sensor converting for a given time after the start of an acquisition.
+ */
+class TestSensor : public Sensor
+{
+  public:
+    TestSensor(unsigned long conversion = 0, unsigned long warmup = 0, unsigned long latency = 0) :
+        m_conversion(conversion),
+        m_warmup(warmup),
+        m_latency(latency),
+        m_start(0),
+        m_first_poll(0),
+        m_polls(0),
+        m_value(0),
+        m_fail(false)
+    {
+    }
+
+    virtual float measure() { return m_value; }
+
+    virtual unsigned long warmup() { return m_warmup; }
+
+    virtual unsigned long latency() { return m_latency; }
+
+    virtual bool startAcquisition()
+    {
+      if (m_fail)
+      {
+        return false;
+      }
+
+      m_start = millis();
+      m_polls = 0;
+      m_value++;
+
+      return true;
+    }
+
+    virtual int8_t pollAcquisition()
+    {
+      if (m_polls++ == 0)
+      {
+        m_first_poll = millis() - m_start;
+      }
+
+      return (millis() - m_start >= m_conversion) ? ACQUISITION_DONE : ACQUISITION_PENDING;
+    }
+
+    //! Conversion time (in milliseconds)
+    unsigned long m_conversion;
+
+    //! Warm up time (in milliseconds)
+    unsigned long m_warmup;
+
+    //! Latency (in milliseconds)
+    unsigned long m_latency;
+
+    //! Start of the last acquisition
+    unsigned long m_start;
+
+    //! Time of the first poll of the last acquisition, from its start
+    unsigned long m_first_poll;
+
+    //! Polls of the last acquisition
+    unsigned long m_polls;
+
+    //! Number of acquisitions
+    long m_value;
+
+    //! Acquisitions are not started
+    bool m_fail;
+};
+
+//! Measurements published: name of the job and timestamp
+static const unsigned int LOG_SIZE = 64;
+static char g_names[LOG_SIZE];
+static unsigned long g_timestamps[LOG_SIZE];
+static unsigned int g_count = 0;
+
+static void publish(SensorJob &job)
+{
+  if (g_count < LOG_SIZE)
+  {
+    g_names[g_count] = *((const char *) job.context());
+    g_timestamps[g_count] = job.timestamp();
+  }
+
+  g_count++;
+}
+
+/**
+ * Advances the board time and polls the scheduler every millisecond.
+ */
+static void run(SensorScheduler &s, unsigned long ms)
+{
+  for (unsigned long i = 0; i < ms; i++)
+  {
+    sim::advanceMillis(1);
+    s.poll();
+  }
+}
+
+static void testDrivers()
+{
+  i2c::HIH7121 hih;
+  i2c::IAQ2000 iaq;
+  i2c::T6713 t6713;
+  i2c::ADS1100 ads;
+
+  SensorJob jh(hih, 5000);
+  CHECK_EQUAL(jh.warmup(), 60);
+  CHECK_EQUAL(jh.latency(), 37);
+
+  SensorJob ji(iaq, 1000);
+  CHECK_EQUAL(ji.warmup(), 300000UL);
+  CHECK_EQUAL(ji.latency(), 0);
+
+  SensorJob jt(t6713, 2000);
+  CHECK_EQUAL(jt.warmup(), 120000UL);
+  CHECK_EQUAL(jt.latency(), 0);
+
+  SensorJob ja(ads, 250);
+  CHECK_EQUAL(ja.warmup(), 125);
+  CHECK_EQUAL(ja.latency(), 0);
+
+  // The timing follows the sensor
+  ja.setSensor(hih);
+  CHECK_EQUAL(ja.warmup(), 60);
+  CHECK_EQUAL(ja.latency(), 37);
+
+  // Copies keep the timing set by the user
+  jh.setLatency(45);
+  SensorJob copy(jh);
+  CHECK_EQUAL(copy.latency(), 45);
+  CHECK(!copy.isScheduled());
+}
+
+static void testOrder()
+{
+  sim::reset();
+  g_count = 0;
+
+  TestSensor a(0, 10), b(0, 5), c(0, 26);
+  SensorScheduler s;
+
+  SensorJob ja(a, 30, publish, (void *) "a");
+  SensorJob jb(b, 20, publish, (void *) "b");
+  SensorJob jc(c, 0, publish, (void *) "c");
+
+  CHECK(s.add(ja));
+  CHECK(s.add(jb));
+  CHECK(s.add(jc));
+  CHECK_EQUAL(s.count(), 3);
+
+  run(s, 100);
+
+  // Every job is acquired at its deadline, in order of deadline
+  static const char names[] = "babcabbaba";
+  static const unsigned long times[] = { 5, 10, 25, 26, 40, 45, 65, 70, 85, 100 };
+
+  CHECK_EQUAL(g_count, 10);
+  for (unsigned int i = 0; i < 10 && i < g_count; i++)
+  {
+    CHECK_EQUAL(g_names[i], names[i]);
+    CHECK_EQUAL(g_timestamps[i], times[i]);
+  }
+
+  // The single acquisition is not repeated
+  CHECK_EQUAL(c.m_value, 1);
+  CHECK_EQUAL(s.wheel().count(), 2);
+}
+
+static void testLatency()
+{
+  sim::reset();
+  g_count = 0;
+
+  TestSensor d(5, 3, 8);
+  SensorScheduler s;
+  SensorJob jd(d, 50, publish, (void *) "d");
+
+  CHECK_EQUAL(jd.warmup(), 3);
+  CHECK_EQUAL(jd.latency(), 8);
+  CHECK(s.add(jd));
+
+  run(s, 10);
+
+  // Started at 3, not checked before 11
+  CHECK(jd.isPending());
+  CHECK_EQUAL(d.m_polls, 0);
+
+  run(s, 1);
+
+  CHECK(!jd.isPending());
+  CHECK_EQUAL(d.m_first_poll, 8);
+  CHECK_EQUAL(d.m_polls, 1);
+  CHECK_EQUAL(g_count, 1);
+  CHECK_EQUAL(jd.timestamp(), 3);
+  CHECK_NEAR(jd.value(), 1, 0);
+}
+
+static void testOverruns()
+{
+  sim::reset();
+  g_count = 0;
+
+  TestSensor e(25, 10);
+  SensorScheduler s;
+  SensorJob je(e, 10, publish, (void *) "e");
+
+  CHECK(s.add(je));
+
+  run(s, 100);
+
+  // Started at 10, 40, 70 and 100: the deadlines in between are skipped
+  CHECK_EQUAL(e.m_value, 4);
+  CHECK_EQUAL(je.overruns(), 6);
+  CHECK_EQUAL(je.errors(), 0);
+  CHECK(je.isPending());
+
+  CHECK_EQUAL(g_count, 3);
+  for (unsigned int i = 0; i < 3 && i < g_count; i++)
+  {
+    CHECK_EQUAL(g_timestamps[i], 10 + 30 * i);
+  }
+
+  // Acquisitions not started are errors, not overruns
+  run(s, 25);
+  e.m_fail = true;
+  run(s, 20);
+
+  CHECK_EQUAL(je.errors(), 2);
+  CHECK_EQUAL(je.overruns(), 8);
+  CHECK(!je.isPending());
+}
+
+//! Jobs of testRemove
+static SensorScheduler *g_scheduler = 0;
+static SensorJob *g_victims[2] = { 0, 0 };
+
+static void removeJobs(SensorJob &job)
+{
+  publish(job);
+
+  if (g_count == 1)
+  {
+    // A pending job still converting and a job completed in the same poll
+    CHECK(g_scheduler->remove(*g_victims[0]));
+    CHECK(g_scheduler->remove(*g_victims[1]));
+    CHECK(!g_scheduler->remove(*g_victims[1]));
+  }
+  else if (g_count == 3)
+  {
+    CHECK(g_scheduler->remove(job));
+  }
+}
+
+static void testRemove()
+{
+  sim::reset();
+  g_count = 0;
+
+  TestSensor slow(100, 4), remover(3, 5), fast(2, 6);
+  SensorScheduler s;
+
+  SensorJob jslow(slow, 5, publish, (void *) "s");
+  SensorJob jremover(remover, 5, removeJobs, (void *) "r");
+  SensorJob jfast(fast, 5, publish, (void *) "f");
+
+  g_scheduler = &s;
+  g_victims[0] = &jslow;
+  g_victims[1] = &jfast;
+
+  CHECK(s.add(jslow));
+  CHECK(s.add(jremover));
+  CHECK(s.add(jfast));
+
+  run(s, 7);
+
+  // Pending in order of start
+  CHECK(jslow.isPending());
+  CHECK(jremover.isPending());
+  CHECK(jfast.isPending());
+
+  // At 8 the remover and the fast job complete: the fast one is removed before its callback
+  run(s, 1);
+
+  CHECK_EQUAL(g_count, 1);
+  CHECK(!jslow.isPending());
+  CHECK(!jslow.isScheduled());
+  CHECK(!jfast.isPending());
+  CHECK(!jfast.isScheduled());
+  CHECK_EQUAL(s.count(), 1);
+
+  run(s, 50);
+
+  // The remover removes itself at its third measurement
+  CHECK_EQUAL(g_count, 3);
+  for (unsigned int i = 0; i < 3 && i < g_count; i++)
+  {
+    CHECK_EQUAL(g_names[i], 'r');
+  }
+
+  CHECK_EQUAL(slow.m_value, 1);
+  CHECK_EQUAL(fast.m_value, 1);
+  CHECK(!jremover.isScheduled());
+  CHECK_EQUAL(s.count(), 0);
+  CHECK_EQUAL(s.wheel().count(), 0);
+
+  // Removed jobs can be added again
+  CHECK(s.add(jfast));
+  run(s, 10);
+  CHECK_EQUAL(g_count, 4);
+  CHECK_EQUAL(g_names[3], 'f');
+}
+
+static void testRollOver()
+{
+  sim::reset();
+  g_count = 0;
+
+  // 50 ms before the roll over of millis() (with a 32 bit long)
+  sim::setMicros((0x100000000ULL - 50) * 1000ULL);
+
+  TestSensor w(3, 10, 2);
+  SensorScheduler s;
+  SensorJob jw(w, 20, publish, (void *) "w");
+
+  CHECK(s.add(jw));
+
+  run(s, 200);
+
+  CHECK_EQUAL(g_count, 10);
+  CHECK_EQUAL(jw.overruns(), 0);
+  CHECK_EQUAL(jw.errors(), 0);
+
+  for (unsigned int i = 1; i < 10 && i < g_count; i++)
+  {
+    CHECK_EQUAL((unsigned long) (g_timestamps[i] - g_timestamps[i - 1]), 20);
+  }
+}
+
+int main()
+{
+  testDrivers();
+  testOrder();
+  testLatency();
+  testOverruns();
+  testRemove();
+  testRollOver();
+
+  if (sizeof(long) > 4)
+  {
+    printf("long is %u bits: millis() does not roll over\n", (unsigned) (sizeof(long) * 8));
+  }
+
+  return report();
+}
@@ -0,0 +1,257 @@
+/**
+ * \file test_sim.cpp
+ * \brief Tests of the simulated board: clock, pins, ADC, serial port and I2C bus.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <Arduino.h>
+#include <Wire.h>
+#include <simulation.h>
+#include <models.h>
+
+#include "check.h"
+
+using namespace smrtobj;
+
+static int triangle(uint8_t channel, unsigned long long us, void *context)
+{
+  (void) channel;
+
+  int peak = *(int *) context;
+  int t = (int) ((us / 1000ULL) % 200);
+
+  return (t < 100) ? peak * t / 100 : peak * (200 - t) / 100;
+}
+
+static void testClock()
+{
+  sim::reset();
+
+  CHECK_EQUAL(millis(), 0);
+  sim::advanceMillis(1500);
+  CHECK_EQUAL(millis(), 1500);
+  CHECK_EQUAL(micros(), 1500000);
+  CHECK_EQUAL(sim::trueMicros(), 1500000);
+
+  // delay() counts the board time
+  delay(250);
+  CHECK_EQUAL(millis(), 1750);
+  delayMicroseconds(40);
+  CHECK_EQUAL(micros(), 1750040);
+
+  // A fast oscillator: the board counts 1010 ms in 1 s
+  sim::setDrift(10000);
+  sim::advanceMillis(1000);
+  CHECK_EQUAL(millis(), 2760);
+  CHECK_EQUAL(sim::trueMicros(), 2750040);
+
+  // delay() takes less true time
+  unsigned long long t0 = sim::trueMicros();
+  delay(1010);
+  CHECK_NEAR((double) (sim::trueMicros() - t0), 1000000, 1);
+
+  // A slow oscillator
+  sim::setDrift(-5000);
+  unsigned long m0 = millis();
+  sim::advanceMillis(10000);
+  CHECK_EQUAL(millis() - m0, 9950);
+
+  // Waiting loops end with the auto step
+  sim::setDrift(0);
+  sim::setAutoStep(100);
+  unsigned long start = millis();
+  unsigned long polls = 0;
+  while (millis() - start < 10)
+  {
+    polls++;
+  }
+  CHECK(polls >= 95 && polls <= 100);
+  sim::setAutoStep(0);
+
+  sim::setMicros(4000000000ULL);
+  CHECK_EQUAL(micros(), 4000000000ULL);
+  CHECK_EQUAL(millis(), 4000000);
+}
+
+static void testPins()
+{
+  sim::reset();
+
+  CHECK_EQUAL(sim::mode(7), INPUT);
+  CHECK_EQUAL(digitalRead(7), LOW);
+
+  pinMode(7, INPUT_PULLUP);
+  CHECK_EQUAL(digitalRead(7), HIGH);
+  sim::setInput(7, LOW);
+  CHECK_EQUAL(digitalRead(7), LOW);
+
+  pinMode(13, OUTPUT);
+  CHECK_EQUAL(sim::mode(13), OUTPUT);
+  digitalWrite(13, HIGH);
+  digitalWrite(13, HIGH);
+  digitalWrite(13, LOW);
+  CHECK_EQUAL(sim::output(13), LOW);
+  CHECK_EQUAL(sim::toggles(13), 2);
+  CHECK_EQUAL(digitalRead(13), LOW);
+
+  analogWrite(9, 200);
+  CHECK_EQUAL(sim::pwm(9), 200);
+  CHECK_EQUAL(sim::output(9), HIGH);
+}
+
+static void testAdc()
+{
+  sim::reset();
+
+  CHECK_EQUAL(analogRead(A0), 0);
+  sim::setAnalog(A0, 700);
+  CHECK_EQUAL(analogRead(A0), 700);
+  CHECK_EQUAL(analogRead(0), 700);
+  sim::setAnalog(1, 2000);
+  CHECK_EQUAL(analogRead(A1), 1023);
+
+  sim::setSine(A2, 512, 200, 1000);
+  CHECK_EQUAL(analogRead(A2), 512);
+  sim::advanceMillis(250);
+  CHECK_EQUAL(analogRead(A2), 712);
+  sim::advanceMillis(500);
+  CHECK_EQUAL(analogRead(A2), 312);
+
+  sim::reset();
+  sim::setRamp(A3, 0, 1000, 100);
+  sim::advanceMillis(25);
+  CHECK_EQUAL(analogRead(A3), 250);
+  sim::advanceMillis(100);
+  CHECK_EQUAL(analogRead(A3), 250);
+
+  sim::setSquare(A4, 10, 900, 20);
+  CHECK_EQUAL(analogRead(A4), 10);
+  sim::advanceMillis(10);
+  CHECK_EQUAL(analogRead(A4), 900);
+
+  static const int samples[3] = { 1, 2, 3 };
+  sim::setSamples(A5, samples, 3);
+  CHECK_EQUAL(analogRead(A5), 1);
+  CHECK_EQUAL(analogRead(A5), 2);
+  CHECK_EQUAL(analogRead(A5), 3);
+  CHECK_EQUAL(analogRead(A5), 1);
+  CHECK_EQUAL(sim::conversions(A5), 4);
+
+  int peak = 800;
+  sim::reset();
+  sim::setWaveform(A6, triangle, &peak);
+  sim::advanceMillis(50);
+  CHECK_EQUAL(analogRead(A6), 400);
+  sim::advanceMillis(100);
+  CHECK_EQUAL(analogRead(A6), 400);
+
+  sim::setAnalog(A7, 500);
+  sim::setNoise(A7, 3);
+  bool changed = false;
+  for (int i = 0; i < 100; i++)
+  {
+    int v = analogRead(A7);
+
+    CHECK(v >= 497 && v <= 503);
+    changed = changed || (v != 500);
+  }
+  CHECK(changed);
+
+  analogReference(INTERNAL);
+  CHECK_EQUAL(sim::reference(), INTERNAL);
+}
+
+static void testSerial()
+{
+  sim::reset();
+  sim::setSerialEcho(false);
+
+  Serial.print("t=");
+  Serial.print(12);
+  Serial.print(' ');
+  Serial.print(255, HEX);
+  Serial.print(' ');
+  Serial.println(2.5);
+  CHECK(strcmp(sim::serialOutput(), "t=12 FF 2.50\r\n") == 0);
+
+  sim::clearSerialOutput();
+  CHECK(strcmp(sim::serialOutput(), "") == 0);
+
+  sim::setSerialInput("ab 42");
+  CHECK_EQUAL(Serial.available(), 5);
+  CHECK_EQUAL(Serial.read(), 'a');
+  CHECK_EQUAL(Serial.peek(), 'b');
+  CHECK_EQUAL(Serial.parseInt(), 42);
+  CHECK_EQUAL(Serial.available(), 0);
+  CHECK_EQUAL(Serial.read(), -1);
+}
+
+static void testBus()
+{
+  sim::reset();
+
+  sim::TCA6507Model led;
+  sim::PCA9548AModel mux;
+  sim::HIH7121Model h0;
+  sim::HIH7121Model h1;
+
+  CHECK(sim::attach(led));
+  CHECK(sim::attach(mux));
+  CHECK(mux.attach(0, h0));
+  CHECK(mux.attach(1, h1));
+
+  // Register write with auto increment, then read back
+  Wire.beginTransmission(sim::TCA6507Model::DEVICE_ADDRESS);
+  Wire.write(0x13);
+  Wire.write(0x55);
+  Wire.write(0x66);
+  CHECK_EQUAL(Wire.endTransmission(), 0);
+  CHECK_EQUAL(led.reg(3), 0x55);
+  CHECK_EQUAL(led.reg(4), 0x66);
+
+  Wire.beginTransmission(sim::TCA6507Model::DEVICE_ADDRESS);
+  Wire.write(0x03);
+  CHECK_EQUAL(Wire.endTransmission(false), 0);
+  CHECK_EQUAL(Wire.requestFrom((uint8_t) sim::TCA6507Model::DEVICE_ADDRESS, (uint8_t) 1), 1);
+  CHECK_EQUAL(Wire.read(), 0x55);
+  CHECK_EQUAL(Wire.available(), 0);
+
+  // Devices behind the multiplexer are seen only on enabled channels
+  CHECK(sim::find(sim::HIH7121Model::DEVICE_ADDRESS) == 0);
+  Wire.beginTransmission(sim::PCA9548AModel::DEVICE_ADDRESS);
+  Wire.write(0x02);
+  CHECK_EQUAL(Wire.endTransmission(), 0);
+  CHECK(sim::find(sim::HIH7121Model::DEVICE_ADDRESS) == &h1);
+  CHECK_EQUAL(mux.selections(), 1);
+
+  // Missing device
+  Wire.beginTransmission(0x33);
+  CHECK_EQUAL(Wire.endTransmission(), 2);
+  CHECK_EQUAL(Wire.requestFrom((uint8_t) 0x33, (uint8_t) 1), 0);
+
+  // Wire buffer overflow
+  Wire.beginTransmission(sim::TCA6507Model::DEVICE_ADDRESS);
+  for (int i = 0; i < BUFFER_LENGTH + 1; i++)
+  {
+    Wire.write(0x10);
+  }
+  CHECK_EQUAL(Wire.endTransmission(), 1);
+
+  unsigned long n = sim::transfers();
+  sim::detach(led);
+  Wire.beginTransmission(sim::TCA6507Model::DEVICE_ADDRESS);
+  CHECK_EQUAL(Wire.endTransmission(), 2);
+  CHECK_EQUAL(sim::transfers(), n + 1);
+}
+
+int main()
+{
+  testClock();
+  testPins();
+  testAdc();
+  testSerial();
+  testBus();
+
+  return report();
+}
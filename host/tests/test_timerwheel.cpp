@@ -0,0 +1,368 @@
+/**
+ * \file test_timerwheel.cpp
+ * \brief Tests of TimerWheel: one-shot and periodic tasks, cascades across the wheels, delays beyond the
+ *        last wheel, missed periods, resolution, changes inside the callbacks and roll over of millis().
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include <smrtobjtime.h>
+#include <simulation.h>
+
+#include "check.h"
+
+using namespace smrtobj;
+using namespace smrtobj::timer;
+
+/**
+ * Calls of a task.
+ */
+struct Calls
+{
+  //! Number of calls
+  unsigned long count;
+
+  //! Time of the first call, from the origin of the test
+  unsigned long first;
+
+  //! Time of the last call, from the origin of the test
+  unsigned long last;
+
+  //! Task stopped by the call (if any)
+  TimerTask *stop;
+
+  //! Delay of the restart of a one-shot task (0 for none)
+  unsigned long restart;
+};
+
+//! Wheel of the test
+static TimerWheel *g_wheel = 0;
+
+//! Start time of the test
+static unsigned long g_origin = 0;
+
+static void record(TimerTask &t)
+{
+  Calls *c = (Calls *) t.context();
+  unsigned long now = g_wheel->time() - g_origin;
+
+  if (c->count == 0)
+  {
+    c->first = now;
+  }
+
+  c->last = now;
+  c->count++;
+
+  if (c->stop)
+  {
+    g_wheel->stop(*c->stop);
+  }
+
+  if (c->restart)
+  {
+    g_wheel->start(t, c->restart);
+  }
+}
+
+/**
+ * Starts a test: new wheel at the current board time.
+ */
+static void begin(TimerWheel &w)
+{
+  g_wheel = &w;
+  g_origin = w.time();
+}
+
+/**
+ * Advances the board time and ticks the wheel every millisecond.
+ */
+static void run(unsigned long ms)
+{
+  for (unsigned long i = 0; i < ms; i++)
+  {
+    sim::advanceMillis(1);
+    g_wheel->tick();
+  }
+}
+
+static void testOneShot()
+{
+  sim::reset();
+
+  TimerWheel w;
+  begin(w);
+
+  Calls c0 = { 0 }, c1 = { 0 }, c5 = { 0 }, again = { 0 };
+  TimerTask t0(record, &c0), t1(record, &c1), t5(record, &c5), tr(record, &again);
+
+  CHECK(w.start(t0, 0));
+  CHECK(w.start(t1, 1));
+  CHECK(w.start(t5, 5));
+  CHECK_EQUAL(w.count(), 3);
+
+  // A one-shot task restarted by its callback
+  again.restart = 4;
+  CHECK(w.start(tr, 2));
+
+  run(20);
+
+  // A delay of 0 expires at the next tick
+  CHECK_EQUAL(c0.count, 1);
+  CHECK_EQUAL(c0.first, 1);
+  CHECK_EQUAL(c1.count, 1);
+  CHECK_EQUAL(c1.first, 1);
+  CHECK_EQUAL(c5.count, 1);
+  CHECK_EQUAL(c5.first, 5);
+  CHECK(!t5.isScheduled());
+
+  CHECK_EQUAL(again.count, 5);
+  CHECK_EQUAL(again.first, 2);
+  CHECK_EQUAL(again.last, 18);
+  CHECK(tr.isScheduled());
+  CHECK_EQUAL(w.count(), 1);
+
+  // Stopped tasks are not called
+  CHECK(w.stop(tr));
+  CHECK(!w.stop(tr));
+  CHECK(!w.stop(t5));
+  run(20);
+  CHECK_EQUAL(again.count, 5);
+  CHECK_EQUAL(w.count(), 0);
+
+  // A restarted task expires from the last tick
+  CHECK(w.start(t5, 10));
+  run(5);
+  CHECK(w.start(t5, 10));
+  run(20);
+  CHECK_EQUAL(c5.count, 2);
+  CHECK_EQUAL(c5.last, 55);
+
+  // Delays of 2^31 ticks or more are rejected
+  CHECK(!w.start(t5, 0x80000000UL));
+  CHECK(!w.start(t5, 10, 0x80000000UL));
+  CHECK(!t5.isScheduled());
+}
+
+static void testPeriodic()
+{
+  sim::reset();
+
+  TimerWheel w;
+  begin(w);
+
+  Calls c = { 0 }, far = { 0 };
+  TimerTask t(record, &c), tf(record, &far);
+
+  CHECK(w.start(t, 3, 7));
+  CHECK_EQUAL(t.period(), 7);
+
+  // Period beyond the last wheel
+  CHECK(w.start(tf, 100, 70000));
+
+  run(100);
+
+  CHECK_EQUAL(c.count, 14);
+  CHECK_EQUAL(c.first, 3);
+  CHECK_EQUAL(c.last, 94);
+
+  run(150000);
+
+  CHECK_EQUAL(far.count, 3);
+  CHECK_EQUAL(far.first, 100);
+  CHECK_EQUAL(far.last, 140100);
+
+  CHECK(w.stop(t));
+  unsigned long count = c.count;
+  run(100);
+  CHECK_EQUAL(c.count, count);
+  CHECK_EQUAL(w.count(), 1);
+}
+
+static void testCascade()
+{
+  // Boundaries of the wheels (16, 256, 4096 and 65536 ticks) and beyond the last one
+  static const unsigned long delays[] =
+  {
+    15, 16, 17, 31, 32, 255, 256, 257, 4095, 4096, 4097, 65535, 65536, 65537, 100000, 131072, 200001
+  };
+  static const unsigned int N = sizeof(delays) / sizeof(delays[0]);
+
+  // Start at several phases of the wheels
+  static const unsigned long phases[] = { 0, 1, 15, 1234, 65535 };
+
+  for (unsigned int p = 0; p < sizeof(phases) / sizeof(phases[0]); p++)
+  {
+    sim::reset();
+
+    TimerWheel w;
+    begin(w);
+    run(phases[p]);
+    g_origin = w.time();
+
+    Calls calls[N];
+    TimerTask tasks[N];
+
+    for (unsigned int i = 0; i < N; i++)
+    {
+      Calls c = { 0 };
+
+      calls[i] = c;
+      tasks[i].setCallback(record, &calls[i]);
+      CHECK(w.start(tasks[i], delays[i]));
+    }
+
+    run(200010);
+
+    for (unsigned int i = 0; i < N; i++)
+    {
+      if ( !CHECK_EQUAL(calls[i].count, 1) || !CHECK_EQUAL(calls[i].first, delays[i]) )
+      {
+        printf("  delay %lu, phase %lu\n", delays[i], phases[p]);
+      }
+    }
+
+    CHECK_EQUAL(w.count(), 0);
+  }
+}
+
+static void testLateLoop()
+{
+  sim::reset();
+
+  TimerWheel w;
+  begin(w);
+
+  Calls c = { 0 };
+  TimerTask t(record, &c);
+
+  CHECK(w.start(t, 10, 10));
+  run(20);
+  CHECK_EQUAL(c.count, 2);
+
+  // The loop is stopped for 55 ms: one call, then the phase is kept
+  sim::advanceMillis(55);
+  w.tick();
+  CHECK_EQUAL(c.count, 3);
+  CHECK_EQUAL(c.last, 75);
+
+  run(25);
+  CHECK_EQUAL(c.count, 6);
+  CHECK_EQUAL(c.last, 100);
+
+  // Calls with an external reference time
+  w.tick(w.time() + 10);
+  CHECK_EQUAL(c.count, 7);
+  CHECK_EQUAL(c.last, 110);
+}
+
+static void testResolution()
+{
+  sim::reset();
+
+  TimerWheel w(10);
+  begin(w);
+
+  CHECK_EQUAL(w.resolution(), 10);
+
+  Calls once = { 0 }, c = { 0 };
+  TimerTask t1(record, &once), t(record, &c);
+
+  // Times are rounded up to the next tick
+  CHECK(w.start(t1, 25));
+  CHECK(w.start(t, 0, 25));
+
+  run(9);
+  CHECK_EQUAL(w.time() - g_origin, 0);
+
+  run(91);
+  CHECK_EQUAL(once.count, 1);
+  CHECK_EQUAL(once.first, 30);
+
+  // Due at start (executed at the next tick), then every 3 ticks from the start
+  CHECK_EQUAL(c.first, 10);
+  CHECK_EQUAL(c.last, 90);
+  CHECK_EQUAL(c.count, 4);
+}
+
+static void testStopInCallback()
+{
+  sim::reset();
+
+  TimerWheel w;
+  begin(w);
+
+  // Two tasks of the same slot stopping each other: only the first one is called
+  Calls a = { 0 }, b = { 0 };
+  TimerTask ta(record, &a), tb(record, &b);
+
+  a.stop = &tb;
+  b.stop = &ta;
+
+  CHECK(w.start(ta, 10, 10));
+  CHECK(w.start(tb, 10, 10));
+
+  run(50);
+
+  CHECK_EQUAL(a.count + b.count, 5);
+  CHECK(a.count == 0 || b.count == 0);
+  CHECK_EQUAL(w.count(), 1);
+
+  // A periodic task stopping itself
+  Calls self = { 0 };
+  TimerTask ts(record, &self);
+
+  self.stop = &ts;
+  CHECK(w.start(ts, 5, 5));
+  run(50);
+
+  CHECK_EQUAL(self.count, 1);
+  CHECK(!ts.isScheduled());
+  CHECK_EQUAL(w.count(), 1);
+}
+
+static void testRollOver()
+{
+  sim::reset();
+
+  // 1 second before the roll over of millis() (with a 32 bit long)
+  sim::setMicros((0x100000000ULL - 1000) * 1000ULL);
+
+  TimerWheel w;
+  begin(w);
+
+  Calls once = { 0 }, c = { 0 }, far = { 0 };
+  TimerTask t1(record, &once), t(record, &c), tf(record, &far);
+
+  CHECK(w.start(t1, 1500));
+  CHECK(w.start(t, 300, 300));
+  CHECK(w.start(tf, 70000));
+
+  run(75000);
+
+  CHECK_EQUAL(once.count, 1);
+  CHECK_EQUAL(once.first, 1500);
+  CHECK_EQUAL(c.count, 250);
+  CHECK_EQUAL(c.first, 300);
+  CHECK_EQUAL(c.last, 75000);
+  CHECK_EQUAL(far.count, 1);
+  CHECK_EQUAL(far.first, 70000);
+}
+
+int main()
+{
+  testOneShot();
+  testPeriodic();
+  testCascade();
+  testLateLoop();
+  testResolution();
+  testStopInCallback();
+  testRollOver();
+
+  if (sizeof(long) > 4)
+  {
+    printf("long is %u bits: millis() does not roll over\n", (unsigned) (sizeof(long) * 8));
+  }
+
+  return report();
+}
@@ -0,0 +1,66 @@
+/*
+ * GPSFix.ino
+ * Example showing how store a GPS position in binary format and calculate distance and bearing.
+ * This program sets two GPS positions and prints distance and bearing between them on serial monitor.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <gpsposition.h>
+#include <gpsfix.h>
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(9600);
+  
+  smrtobj::data::GPSPosition p;
+  smrtobj::data::GPSFix from;
+  smrtobj::data::GPSFix to;
+  int err = 0;
+
+  // Position as string
+  p.setLatitude((const char *) "45.065670");
+  p.setLongitude((const char *) "7.658086");
+  p.setAltitude((const char *) "253");
+
+  // Convert it in binary format (12 bytes)
+  if ((err = from.set(p)) < 0)
+  {
+    Serial.print("Error: invalid form!!  ");
+    Serial.println(err);
+  }
+
+  // Position without altitude (e.g. from RMC sentences): altitude is 0
+  smrtobj::data::GPSPosition q;
+
+  q.setLatitude((const char *) "45.070432");
+  q.setLongitude((const char *) "7.686554");
+
+  if ((err = to.set(q)) < 0)
+  {
+    Serial.print("Error: invalid form!!  ");
+    Serial.println(err);
+  }
+
+  Serial.print("latitude (1e-7 degrees): ");
+  Serial.println(from.latitude());
+  Serial.print("longitude (1e-7 degrees): ");
+  Serial.println(from.longitude());
+  Serial.print("altitude (cm): ");
+  Serial.println(from.altitude());
+  Serial.print("altitude without value (cm): ");
+  Serial.println(to.altitude());
+
+  Serial.print("distance (m): ");
+  Serial.println(from.distanceTo(to));
+  Serial.print("fast distance (m): ");
+  Serial.println(from.fastDistanceTo(to));
+  Serial.print("bearing (degrees): ");
+  Serial.println(from.bearingTo(to));
+}
+
+void loop() {
+  // put your main code here, to run repeatedly: 
+  
+}
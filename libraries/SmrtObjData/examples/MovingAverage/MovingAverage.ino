@@ -0,0 +1,38 @@
+/*
+ * MovingAverage.ino
+ * Example showing how to smooth an analog input with a simple moving average
+ * over the last 16 samples.
+ * Samples are ADC counts (uint16_t), so the average is calculated without floating point operations.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <movingaverage.h> 
+
+uint16_t value = 0;
+
+smrtobj::data::MovingAverage<uint16_t, 16> avg;
+
+void setup() {
+  Serial.begin(9600);
+  Serial.println("Calculate average of the last 16 samples of analog input A0");
+}
+
+void loop() {
+  // Read a sample
+  value = analogRead(A0);
+  
+  // Update average
+  avg.push(value);
+  
+  // Print data
+  Serial.print( "samples = " );
+  Serial.println( avg.index() );
+  Serial.print( "value   = " );
+  Serial.println( value );
+  Serial.print( "avg     = " );
+  Serial.println( avg.value() );
+
+  delay(1000);  
+}
@@ -0,0 +1,58 @@
+/*
+ * NMEAParser.ino
+ * Example showing how decode the NMEA sentences of a GPS receiver.
+ * This program reads the GPS receiver connected to the serial port one character at a time
+ * and prints the position on serial monitor every time a GGA or RMC sentence is received.
+ * Sentences are decoded into a scratch position, copied to the current one only when the checksum is
+ * valid: fields of a corrupted sentence are discarded.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <gpsposition.h>
+#include <nmeaparser.h>
+
+// Last valid position
+smrtobj::data::GPSPosition p;
+
+// Position being decoded
+smrtobj::data::GPSPosition scratch;
+smrtobj::data::NMEAParser nmea(scratch);
+
+void setup() {
+  // GPS receiver and serial monitor share the serial port
+  Serial.begin(9600);
+}
+
+void loop() {
+  while ( Serial.available() )
+  {
+    char c = Serial.read();
+
+    // A new sentence starts from the last valid position, whatever the previous one left
+    if (c == '$')
+    {
+      scratch = p;
+    }
+
+    int ret = nmea.encode(c);
+
+    if ( ret == smrtobj::data::NMEAParser::SENTENCE_VALID )
+    {
+      p = scratch;
+
+      Serial.print("latitude: ");
+      Serial.println(p.latitude());
+      Serial.print("longitude: ");
+      Serial.println(p.longitude());
+      Serial.print("altitude: ");
+      Serial.println(p.altitude());
+    }
+    else if ( ret < 0 )
+    {
+      Serial.print("Error: invalid sentence!!  ");
+      Serial.println(ret);
+    }
+  }
+}
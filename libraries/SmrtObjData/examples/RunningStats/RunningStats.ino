@@ -0,0 +1,51 @@
+/*
+ * RunningStats.ino
+ * Example showing how to calculate statistics of a stream of samples.
+ * Mean, standard deviation, minimum and maximum of the samples read in a minute
+ * are printed and then reset.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <runningstats.h> 
+
+float value = 0;
+uint8_t index = 0;
+
+smrtobj::data::RunningStats stats;
+
+void setup() {
+  Serial.begin(9600);
+  Serial.println("Calculate statistics of the values read every second");
+}
+
+void loop() {
+  // Create a random value
+  value = random(300);
+  value /= 10;
+  
+  // Update statistics
+  stats.push(value);
+
+  // Print data and reset statistics after 60 values
+  index++;
+  if ( index == 60 )
+  {
+    Serial.print( "samples = " );
+    Serial.println( stats.count() );
+    Serial.print( "mean    = " );
+    Serial.println( stats.mean() );
+    Serial.print( "stddev  = " );
+    Serial.println( stats.stddev() );
+    Serial.print( "min     = " );
+    Serial.println( stats.minimum() );
+    Serial.print( "max     = " );
+    Serial.println( stats.maximum() );
+
+    stats.reset();
+    index = 0;  
+  }
+    
+  delay(1000);  
+}
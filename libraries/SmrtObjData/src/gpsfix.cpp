@@ -0,0 +1,266 @@
+/**
+ * \file gpsfix.cpp
+ * \brief Arduino library to model a GPS position in binary (fixed-point) format: latitude and
+ *        longitude in units of 1e-7 degrees and altitude in centimeters. It provides functions to
+ *        compute distance and bearing between two positions.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "gpsfix.h"
+
+namespace smrtobj
+{
+
+  namespace data
+  {
+
+    //! Radians per unit of latitude and longitude (1e-7 degrees)
+    static const float RAD_PER_UNIT = DEG_TO_RAD * 1e-7;
+
+    GPSFix::GPSFix() :
+      m_lat(0),
+      m_lon(0),
+      m_alt(0)
+    {
+    }
+
+    GPSFix::GPSFix(long lat, long lon, long alt) :
+      m_lat(lat),
+      m_lon(lon),
+      m_alt(alt)
+    {
+    }
+
+    GPSFix::GPSFix(const GPSFix& p)
+    {
+      m_lat = p.m_lat;
+      m_lon = p.m_lon;
+      m_alt = p.m_alt;
+    }
+
+    GPSFix& GPSFix::operator=(const GPSFix& p)
+    {
+      m_lat = p.m_lat;
+      m_lon = p.m_lon;
+      m_alt = p.m_alt;
+
+      return (*this);
+    }
+
+    int GPSFix::parse(const char *str, byte decimals, long max, long &value)
+    {
+      byte i = 0;
+      byte nInt = 0;
+      byte nDec = 0;
+      bool neg = false;
+      long integer = 0;
+      long fraction = 0;
+
+      if (str[0] == '-' || str[0] == '+')
+      {
+        neg = (str[0] == '-');
+        i++;
+      }
+
+      // Integer part
+      for (; str[i] >= '0' && str[i] <= '9'; i++)
+      {
+        if (i >= GPSPosition::COODINATE_LENGTH - 1)
+        {
+          return GPSPosition::INVALID_COORD_LEN;
+        }
+
+        integer = integer * 10 + (str[i] - '0');
+        nInt++;
+
+        if ( max > 0 && integer > max )
+        {
+          return GPSPosition::INVALID_COORD_VALUE;
+        }
+      }
+
+      if (nInt == 0)
+      {
+        return GPSPosition::INVALID_COORD_STRING_FORMAT;
+      }
+
+      // Decimal part: digits beyond the resolution are truncated
+      if (str[i] == '.')
+      {
+        byte first = ++i;
+
+        for (; str[i] >= '0' && str[i] <= '9'; i++)
+        {
+          if (i >= GPSPosition::COODINATE_LENGTH - 1)
+          {
+            return GPSPosition::INVALID_COORD_LEN;
+          }
+
+          if (nDec < decimals)
+          {
+            fraction = fraction * 10 + (str[i] - '0');
+            nDec++;
+          }
+
+          if ( max > 0 && integer == max && str[i] != '0' )
+          {
+            return GPSPosition::INVALID_COORD_VALUE;
+          }
+        }
+
+        if (i == first)
+        {
+          return GPSPosition::INVALID_COORD_STRING_FORMAT;
+        }
+      }
+
+      if (str[i] != '\0')
+      {
+        return GPSPosition::INVALID_COORD_STRING_FORMAT;
+      }
+
+      for (; nDec < decimals; nDec++)
+      {
+        fraction *= 10;
+      }
+
+      for (byte j = 0; j < decimals; j++)
+      {
+        integer *= 10;
+      }
+
+      value = integer + fraction;
+      if (neg)
+      {
+        value = -value;
+      }
+
+      return GPSPosition::NO_ERROR;
+    }
+
+    int GPSFix::setLatitude(const char *coord)
+    {
+      return parse(coord, COORDINATE_DECIMALS, LATITUDE_MAX, m_lat);
+    }
+
+    int GPSFix::setLongitude(const char *coord)
+    {
+      return parse(coord, COORDINATE_DECIMALS, LONGITUDE_MAX, m_lon);
+    }
+
+    int GPSFix::setAltitude(const char *coord)
+    {
+      // 20000 km in centimeters fit in a long
+      return parse(coord, ALTITUDE_DECIMALS, 20000000L, m_alt);
+    }
+
+    int GPSFix::set(const GPSPosition& p)
+    {
+      GPSFix f;
+      int err = GPSPosition::NO_ERROR;
+
+      if ( (err = f.setLatitude(p.latitude())) < 0 )
+      {
+        return err;
+      }
+
+      if ( (err = f.setLongitude(p.longitude())) < 0 )
+      {
+        return err;
+      }
+
+      // Positions without altitude (e.g. from RMC sentences) have altitude 0
+      if ( p.altitude()[0] != '\0' && (err = f.setAltitude(p.altitude())) < 0 )
+      {
+        return err;
+      }
+
+      (*this) = f;
+
+      return GPSPosition::NO_ERROR;
+    }
+
+    float GPSFix::deltaLongitude(long from, long to)
+    {
+      float d = 0;
+
+      // The difference of two values with opposite sign can overflow a long
+      if ( (from >= 0) == (to >= 0) )
+      {
+        d = (float) (to - from);
+      }
+      else
+      {
+        d = (float) to - (float) from;
+      }
+
+      if (d > 1800000000.0)
+      {
+        d -= 3600000000.0;
+      }
+      else if (d < -1800000000.0)
+      {
+        d += 3600000000.0;
+      }
+
+      return d;
+    }
+
+    float GPSFix::distanceTo(const GPSFix& p) const
+    {
+      float lat1 = m_lat * RAD_PER_UNIT;
+      float lat2 = p.m_lat * RAD_PER_UNIT;
+      float sdLat = sin( (p.m_lat - m_lat) * RAD_PER_UNIT / 2 );
+      float sdLon = sin( deltaLongitude(m_lon, p.m_lon) * RAD_PER_UNIT / 2 );
+
+      float h = sdLat * sdLat + cos(lat1) * cos(lat2) * sdLon * sdLon;
+
+      if (h > 1.0)
+      {
+        h = 1.0;
+      }
+
+      return 2 * EARTH_RADIUS * asin( sqrt(h) );
+    }
+
+    float GPSFix::fastDistanceTo(const GPSFix& p) const
+    {
+      float x = deltaLongitude(m_lon, p.m_lon) * RAD_PER_UNIT;
+      float y = (p.m_lat - m_lat) * RAD_PER_UNIT;
+
+      // Mean latitude, computed as an integer to keep precision
+      x *= cos( (m_lat / 2 + p.m_lat / 2) * RAD_PER_UNIT );
+
+      return EARTH_RADIUS * sqrt(x * x + y * y);
+    }
+
+    float GPSFix::bearingTo(const GPSFix& p) const
+    {
+      float lat1 = m_lat * RAD_PER_UNIT;
+      float lat2 = p.m_lat * RAD_PER_UNIT;
+      float dLon = deltaLongitude(m_lon, p.m_lon) * RAD_PER_UNIT;
+
+      float y = sin(dLon) * cos(lat2);
+      float x = cos(lat1) * sin(lat2) - sin(lat1) * cos(lat2) * cos(dLon);
+
+      float b = atan2(y, x) * RAD_TO_DEG;
+
+      return (b < 0) ? b + 360 : b;
+    }
+
+    float GPSFix::fastBearingTo(const GPSFix& p) const
+    {
+      float x = deltaLongitude(m_lon, p.m_lon);
+      float y = (float) (p.m_lat - m_lat);
+
+      x *= cos( (m_lat / 2 + p.m_lat / 2) * RAD_PER_UNIT );
+
+      float b = atan2(x, y) * RAD_TO_DEG;
+
+      return (b < 0) ? b + 360 : b;
+    }
+
+  } /* namespace data */
+
+} /* namespace smrtobj */
@@ -0,0 +1,243 @@
+/**
+ * \file gpsfix.h
+ * \brief Arduino library to model a GPS position in binary (fixed-point) format: latitude and
+ *        longitude in units of 1e-7 degrees and altitude in centimeters. It provides functions to
+ *        compute distance and bearing between two positions.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+
+#ifndef GPSFIX_H_
+#define GPSFIX_H_
+
+
+#if ARDUINO >= 100
+#include "Arduino.h"       // for delayMicroseconds, digitalPinToBitMask, etc
+#else
+#include "WProgram.h"      // for delayMicroseconds
+#include "pins_arduino.h"  // for digitalPinToBitMask, etc
+#endif
+
+#include "gpsposition.h"
+
+namespace smrtobj
+{
+
+  namespace data
+  {
+
+    /**
+     * The GPSFix class stores a GPS position in 12 bytes instead of the 44 characters used by
+     * smrtobj::data::GPSPosition, so it can be used to keep position histories in SRAM:
+     *   - latitude in units of 1e-7 degrees (positive values mean North);
+     *   - longitude in units of 1e-7 degrees (positive values mean East);
+     *   - altitude in centimeters.
+     *
+     * Values can be set from the same strings accepted by smrtobj::data::GPSPosition (decimal degrees
+     * and meters) or from a GPSPosition object. Decimals beyond the resolution are truncated.
+     *
+     * Distances are in meters and bearings in degrees (0 - 360, clockwise from North) and they are
+     * calculated on a spherical Earth. The \e fast functions use the equirectangular approximation,
+     * which is accurate for distances up to some kilometers and avoids most trigonometric functions.
+     *
+     * \b Note: \n
+     * The class has no virtual functions, to keep its size to 12 bytes.
+     *
+     * \code{.cpp}
+     * smrtobj::data::GPSFix home;
+     * smrtobj::data::GPSFix p;
+     *
+     * home.setLatitude("45.065670");
+     * home.setLongitude("7.658086");
+     * ...
+     * float meters = p.fastDistanceTo(home);
+     * \endcode
+     */
+    class GPSFix
+    {
+      public:
+        /**
+         * Limits of the fixed-point format.
+         */
+        enum _fix_limits
+        {
+          //! Number of decimals of latitude and longitude
+          COORDINATE_DECIMALS = 7,
+
+          //! Number of decimals of the altitude (meters)
+          ALTITUDE_DECIMALS = 2,
+
+          //! Maximum absolute value of latitude (degrees)
+          LATITUDE_MAX = 90,
+
+          //! Maximum absolute value of longitude (degrees)
+          LONGITUDE_MAX = 180,
+        };
+
+        //! Mean radius of the Earth (meters)
+        static const float EARTH_RADIUS = 6371008.8;
+
+        /**
+         * Default Constructor
+         * It sets all values to 0.
+         */
+        GPSFix();
+
+        /**
+         * Constructor
+         *
+         * \param[in] lat latitude in units of 1e-7 degrees
+         * \param[in] lon longitude in units of 1e-7 degrees
+         * \param[in] alt altitude in centimeters
+         */
+        GPSFix(long lat, long lon, long alt = 0);
+
+        /**
+         * Copy Constructor
+         *
+         * \param[in] p GPS fix
+         */
+        GPSFix(const GPSFix& p);
+
+        /**
+         * Overload operator = . It copies latitude, longitude and altitude values
+         *
+         */
+        GPSFix& operator=(const GPSFix& p);
+
+        /**
+         * Sets latitude from a string in decimal degrees (between -90 and 90).
+         *
+         * \param[in] coord latitude value (in decimal degree)
+         *
+         * \return NO_ERROR: if no errors, code errors (from GPSPosition::_gps_error enum) otherwise
+         */
+        int setLatitude(const char *coord);
+
+        /**
+         * Sets longitude from a string in decimal degrees (between -180 and 180).
+         *
+         * \param[in] coord longitude value (in decimal degree)
+         *
+         * \return NO_ERROR: if no errors, code errors (from GPSPosition::_gps_error enum) otherwise
+         */
+        int setLongitude(const char *coord);
+
+        /**
+         * Sets altitude from a string in meters. Decimals (centimeters) are allowed.
+         *
+         * \param[in] coord altitude value (meters)
+         *
+         * \return NO_ERROR: if no errors, code errors (from GPSPosition::_gps_error enum) otherwise
+         */
+        int setAltitude(const char *coord);
+
+        /**
+         * Sets latitude, longitude and altitude from a GPS position. If any value is not valid, the
+         * fix is not changed. An empty altitude (e.g. a position decoded from RMC sentences only) is
+         * set to 0.
+         *
+         * \param[in] p GPS position
+         *
+         * \return NO_ERROR: if no errors, code errors (from GPSPosition::_gps_error enum) otherwise
+         */
+        int set(const GPSPosition& p);
+
+        /**
+         * Gets latitude.
+         *
+         * \return latitude in units of 1e-7 degrees
+         */
+        long latitude() const { return m_lat; }
+
+        /**
+         * Gets longitude.
+         *
+         * \return longitude in units of 1e-7 degrees
+         */
+        long longitude() const { return m_lon; }
+
+        /**
+         * Gets altitude.
+         *
+         * \return altitude in centimeters
+         */
+        long altitude() const { return m_alt; }
+
+        /**
+         * Calculates the great-circle distance to an other position using the haversine formula.
+         *
+         * \param[in] p destination
+         *
+         * \return distance in meters
+         */
+        float distanceTo(const GPSFix& p) const;
+
+        /**
+         * Calculates the distance to an other position using the equirectangular approximation.
+         *
+         * \param[in] p destination
+         *
+         * \return distance in meters
+         */
+        float fastDistanceTo(const GPSFix& p) const;
+
+        /**
+         * Calculates the initial bearing of the great-circle path to an other position.
+         *
+         * \param[in] p destination
+         *
+         * \return bearing in degrees (0 - 360, clockwise from North)
+         */
+        float bearingTo(const GPSFix& p) const;
+
+        /**
+         * Calculates the bearing to an other position using the equirectangular approximation.
+         *
+         * \param[in] p destination
+         *
+         * \return bearing in degrees (0 - 360, clockwise from North)
+         */
+        float fastBearingTo(const GPSFix& p) const;
+
+      private:
+        /**
+         * Parses a decimal number with at most \e decimals decimals and returns it as an integer scaled by
+         * 10^decimals. Its format is the one of smrtobj::data::GPSPosition coordinates: optional sign,
+         * integer part and optional decimal part.
+         *
+         * \param[in] str string to parse
+         * \param[in] decimals number of decimals of the result
+         * \param[in] max maximum absolute value of the integer part, 0 for no limits
+         * \param[out] value scaled value
+         *
+         * \return NO_ERROR: if no errors, code errors (from GPSPosition::_gps_error enum) otherwise
+         */
+        static int parse(const char *str, byte decimals, long max, long &value);
+
+        /**
+         * Gets the difference in longitude between two positions, in the range -180 / +180 degrees.
+         *
+         * \param[in] from longitude of the first position (units of 1e-7 degrees)
+         * \param[in] to longitude of the second position (units of 1e-7 degrees)
+         *
+         * \return difference in units of 1e-7 degrees
+         */
+        static float deltaLongitude(long from, long to);
+
+        //! Latitude (1e-7 degrees)
+        long m_lat;
+
+        //! Longitude (1e-7 degrees)
+        long m_lon;
+
+        //! Altitude (centimeters)
+        long m_alt;
+    };
+
+  } /* namespace data */
+
+} /* namespace smrtobj */
+
+#endif /* GPSFIX_H_ */
@@ -2,7 +2,7 @@
  * \file gpsposition.cpp
  * \brief Arduino library to model GPS position. A coordinate has three component:
  *        latitude, longitude and altitude. Latitude and longitude are in decimal
- *        degree format (where positive value means North for latitude and West for
+ *        degree format (where positive value means North for latitude and East for
  *        longitude). Altitude value is an integer and its unit is meter.
  *
  * \author Marco Boeris Frusca
@@ -28,7 +28,7 @@ namespace smrtobj
     {
       memcpy(m_latitude, p.m_latitude, COODINATE_LENGTH);
       memcpy(m_longitude, p.m_longitude, COODINATE_LENGTH);
-      memcpy(m_latitude, p.m_latitude, ALTITUDE_LENGTH);
+      memcpy(m_altitude, p.m_altitude, ALTITUDE_LENGTH);
     }
   
     GPSPosition::~GPSPosition()
@@ -39,7 +39,7 @@ namespace smrtobj
     {
       memcpy(m_latitude, p.m_latitude, COODINATE_LENGTH);
       memcpy(m_longitude, p.m_longitude, COODINATE_LENGTH);
-      memcpy(m_latitude, p.m_latitude, ALTITUDE_LENGTH);
+      memcpy(m_altitude, p.m_altitude, ALTITUDE_LENGTH);
   
       return (*this);
     }
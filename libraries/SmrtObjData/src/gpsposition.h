@@ -2,7 +2,7 @@
  * \file gpsposition.h
  * \brief Arduino library to model GPS position. A coordinate has three component:
  *        latitude, longitude and altitude. Latitude and longitude are in decimal
- *        degree format (where positive value means North for latitude and West for
+ *        degree format (where positive value means North for latitude and East for
  *        longitude). Altitude value is an integer and its unit is meter.
  *
  * \author Marco Boeris Frusca
@@ -30,7 +30,7 @@ namespace smrtobj
     /**
      * A coordinate has three component: latitude, longitude and altitude. Latitude and 
      * longitude are in decimal degree format (where positive value means North for latitude 
-     * and West for longitude). Altitude value is an integer and its unit is meter.
+     * and East for longitude). Altitude value is an integer and its unit is meter.
      */
     class GPSPosition
     {
@@ -95,7 +95,7 @@ namespace smrtobj
   
         /**
          * Sets longitude to the coord value. Value have to be in decimal degree. Positive
-         * values represent West coordinate and negative ones represent Est coordinate.
+         * values represent East coordinate and negative ones represent West coordinate.
          *
          * \param[in] coord longitude value (in decimal degree)
         *
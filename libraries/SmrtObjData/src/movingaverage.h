@@ -0,0 +1,207 @@
+/**
+ * \file movingaverage.h
+ * \brief Arduino library to calculate a simple moving average over a fixed window of samples.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+
+#ifndef MOVINGAVERAGE_H_
+#define MOVINGAVERAGE_H_
+
+
+#if ARDUINO >= 100
+#include "Arduino.h"       // for delayMicroseconds, digitalPinToBitMask, etc
+#else
+#include "WProgram.h"      // for delayMicroseconds
+#include "pins_arduino.h"  // for digitalPinToBitMask, etc
+#endif
+
+
+namespace smrtobj
+{
+
+  namespace data
+  {
+
+    /**
+     * Accumulator used by smrtobj::data::MovingAverage for samples of type T. By default the sum has the
+     * same type of the samples; integral samples use a wider integral type, so no floating point operation
+     * is needed to average ADC counts.
+     */
+    template <typename T>
+    struct MovingAverageSum
+    {
+      //! Type of the running sum
+      typedef T type;
+
+      //! true if the running sum has no rounding errors
+      static const bool EXACT = false;
+
+      /**
+       * Gets the average value.
+       *
+       * \param[in] sum sum of the samples
+       * \param[in] n number of samples
+       *
+       * \return average value
+       */
+      static T mean(type sum, byte n) { return sum / n; }
+    };
+
+    //! Accumulator for 8 bit samples
+    template <>
+    struct MovingAverageSum<uint8_t>
+    {
+      typedef uint16_t type;
+      static const bool EXACT = true;
+      static uint8_t mean(type sum, byte n) { return (sum + n / 2) / n; }
+    };
+
+    //! Accumulator for unsigned 16 bit samples (e.g. ADC counts)
+    template <>
+    struct MovingAverageSum<uint16_t>
+    {
+      typedef uint32_t type;
+      static const bool EXACT = true;
+      static uint16_t mean(type sum, byte n) { return (sum + n / 2) / n; }
+    };
+
+    //! Accumulator for signed 16 bit samples
+    template <>
+    struct MovingAverageSum<int16_t>
+    {
+      typedef int32_t type;
+      static const bool EXACT = true;
+      static int16_t mean(type sum, byte n) { return (sum >= 0) ? (sum + n / 2) / n : (sum - n / 2) / n; }
+    };
+
+    /**
+     * The MovingAverage class implements a simple moving average: the average of the last N samples.
+     * Differently from smrtobj::data::AvgValue, old samples are forgotten, so the average follows a
+     * drifting signal.
+     *
+     * Samples are stored in a ring buffer of N elements and a running sum is updated at every new sample,
+     * so the cost of smrtobj::data::MovingAverage::push does not depend on N. Until N samples are pushed,
+     * the average is calculated over the samples available.
+     *
+     * For \c uint8_t, \c uint16_t and \c int16_t samples the sum is an integer (see
+     * smrtobj::data::MovingAverageSum) and the average is rounded to the nearest integer. For floating
+     * point samples the sum is recalculated every N samples, to avoid the accumulation of rounding errors.
+     *
+     * \code{.cpp}
+     * smrtobj::data::MovingAverage<uint16_t, 16> avg;
+     *
+     * uint16_t smooth = avg.push(analogRead(A0));
+     * \endcode
+     *
+     * \tparam T type of the samples
+     * \tparam N number of samples of the window (1 - 255)
+     */
+    template <typename T, byte N>
+    class MovingAverage
+    {
+        //! Type of the running sum
+        typedef typename MovingAverageSum<T>::type sum_t;
+
+        //! Samples
+        T m_samples[N];
+
+        //! Running sum of the samples
+        sum_t m_sum;
+
+        //! Position of the next sample
+        byte m_i;
+
+        //! Number of samples stored
+        byte m_n;
+
+      public:
+        /**
+         * Default Constructor
+         */
+        MovingAverage() : m_sum(0), m_i(0), m_n(0) {};
+
+        /**
+         * Resets the moving average, removing all samples
+         *
+         */
+        void reset() { m_sum = 0, m_i = 0, m_n = 0; };
+
+        /**
+         * Gets average value
+         *
+         * \return current average value, 0 if there are no samples
+         */
+        T value() const { return (m_n > 0) ? MovingAverageSum<T>::mean(m_sum, m_n) : 0; };
+
+        /**
+         * Checks if average is valid (not 0 elements)
+         *
+         * \return true if is valid, false otherwise
+         */
+        bool isValid() const { return (m_n > 0); };
+
+        /**
+         * Checks if the window is full (N samples have been pushed)
+         *
+         * \return true if the window is full, false otherwise
+         */
+        bool isFull() const { return (m_n == N); };
+
+        /**
+         * Adds a sample to the window, removing the oldest one if the window is full
+         *
+         * \param sample value to add
+         *
+         * \return new average value
+         */
+        T push(T sample);
+
+        /**
+         * Returns the number of samples in the window.
+         *
+         * \return number of samples.
+         */
+        byte index() const { return m_n; }
+
+    };
+
+    template <typename T, byte N>
+    T MovingAverage<T, N>::push(T sample)
+    {
+      if (m_n == N)
+      {
+        m_sum -= m_samples[m_i];
+      }
+      else
+      {
+        m_n++;
+      }
+
+      m_samples[m_i] = sample;
+      m_sum += sample;
+
+      if (++m_i == N)
+      {
+        m_i = 0;
+
+        // A floating point sum is recalculated to discard rounding errors
+        if ( !MovingAverageSum<T>::EXACT )
+        {
+          m_sum = 0;
+          for (byte i = 0; i < N; i++)
+          {
+            m_sum += m_samples[i];
+          }
+        }
+      }
+
+      return value();
+    }
+
+  } /* namespace data */
+
+} /* namespace smrtobj */
+
+#endif /* MOVINGAVERAGE_H_ */
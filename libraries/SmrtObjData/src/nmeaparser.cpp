@@ -0,0 +1,424 @@
+/**
+ * \file nmeaparser.cpp
+ * \brief Arduino library to decode NMEA sentences one byte at a time. Position fields of GGA and
+ *        RMC sentences are written into a GPS position as soon as they are received.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "nmeaparser.h"
+
+namespace smrtobj
+{
+
+  namespace data
+  {
+
+    NMEAParser::NMEAParser(GPSPosition &position) :
+      m_position(&position),
+      m_last(SENTENCE_UNKNOWN)
+    {
+      reset();
+    }
+
+    NMEAParser::NMEAParser(const NMEAParser& p)
+    {
+      (*this) = p;
+    }
+
+    NMEAParser::~NMEAParser()
+    {
+    }
+
+    NMEAParser& NMEAParser::operator=(const NMEAParser& p)
+    {
+      m_position = p.m_position;
+      m_state = p.m_state;
+      m_count = p.m_count;
+      m_checksum = p.m_checksum;
+      m_received = p.m_received;
+      m_type = p.m_type;
+      m_last = p.m_last;
+      m_field = p.m_field;
+      m_len = p.m_len;
+      memcpy(m_id, p.m_id, ID_LENGTH);
+      m_active = p.m_active;
+      m_negative = p.m_negative;
+      m_int = p.m_int;
+      m_minutes = p.m_minutes;
+      m_digits = p.m_digits;
+      m_decimals = p.m_decimals;
+      m_point = p.m_point;
+
+      return (*this);
+    }
+
+    void NMEAParser::reset()
+    {
+      m_state = WAIT_START;
+      m_count = 0;
+      m_checksum = 0;
+      m_received = 0;
+      m_type = SENTENCE_UNKNOWN;
+      m_field = 0;
+      m_len = 0;
+      memset(m_id, 0, ID_LENGTH);
+      m_active = true;
+      m_negative = false;
+      m_int = 0;
+      m_minutes = 0;
+      m_digits = 0;
+      m_decimals = 0;
+      m_point = false;
+    }
+
+    int NMEAParser::encode(char c)
+    {
+      // A new sentence always starts with '$'
+      if (c == '$')
+      {
+        reset();
+        m_state = DATA;
+        m_count = 1;
+
+        return SENTENCE_PENDING;
+      }
+
+      if (m_state == WAIT_START)
+      {
+        return SENTENCE_PENDING;
+      }
+
+      if ( ++m_count > SENTENCE_LENGTH )
+      {
+        reset();
+        return INVALID_SENTENCE;
+      }
+
+      switch (m_state)
+      {
+        case DATA : {
+          if (c == '*')
+          {
+            endField();
+            m_state = CHECKSUM_HI;
+          }
+          else if (c == ',')
+          {
+            m_checksum ^= c;
+            endField();
+          }
+          else
+          {
+            m_checksum ^= c;
+            if ( !addChar(c) )
+            {
+              reset();
+              return INVALID_SENTENCE;
+            }
+          }
+        } break;
+
+        case CHECKSUM_HI :
+        case CHECKSUM_LO : {
+          byte v = hex2dec(c);
+
+          if (v == 0xFF)
+          {
+            reset();
+            return INVALID_SENTENCE;
+          }
+
+          m_received = (m_received << 4) | v;
+
+          if (m_state == CHECKSUM_HI)
+          {
+            m_state = CHECKSUM_LO;
+            break;
+          }
+
+          byte type = m_type;
+          bool valid = (m_received == m_checksum);
+          reset();
+
+          if (!valid)
+          {
+            return INVALID_CHECKSUM;
+          }
+
+          if (type != SENTENCE_UNKNOWN)
+          {
+            m_last = type;
+            return SENTENCE_VALID;
+          }
+        } break;
+      }
+
+      return SENTENCE_PENDING;
+    }
+
+    byte NMEAParser::latitudeField() const
+    {
+      switch (m_type)
+      {
+        case SENTENCE_GGA : return 2;
+        case SENTENCE_RMC : return 3;
+      }
+
+      return 0;
+    }
+
+    bool NMEAParser::addChar(char c)
+    {
+      byte lf = latitudeField();
+
+      // Line terminators are valid only after the checksum
+      if (c == '\r' || c == '\n')
+      {
+        return false;
+      }
+
+      if (m_field == 0)
+      {
+        if (m_len < ID_LENGTH)
+        {
+          m_id[m_len] = c;
+        }
+      }
+      else if ( lf != 0 && (m_field == lf || m_field == lf + 2) )
+      {
+        // Coordinate: ddmm.mmmm (latitude) or dddmm.mmmm (longitude)
+        byte nDeg = (m_field == lf) ? 2 : 3;
+
+        if (c == '.' && !m_point)
+        {
+          m_point = true;
+        }
+        else if (c >= '0' && c <= '9')
+        {
+          if (!m_point && m_digits < nDeg)
+          {
+            m_int = m_int * 10 + (c - '0');
+          }
+          else if (!m_point && m_digits < nDeg + 2)
+          {
+            m_minutes = m_minutes * 10 + (c - '0');
+          }
+          else if (m_point && m_decimals < MINUTE_DECIMALS)
+          {
+            m_minutes = m_minutes * 10 + (c - '0');
+            m_decimals++;
+          }
+          else if (!m_point)
+          {
+            return false;
+          }
+          m_digits++;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      else if ( lf != 0 && (m_field == lf + 1 || m_field == lf + 3) )
+      {
+        // Hemisphere
+        m_negative = (c == 'S' || c == 'W');
+      }
+      else if (m_type == SENTENCE_RMC && m_field == 2)
+      {
+        // Status: A (active) or V (void)
+        m_active = (c == 'A');
+      }
+      else if (m_type == SENTENCE_GGA && m_field == 9)
+      {
+        // Altitude in meters, decimals are truncated
+        if (c == '-' && m_len == 0)
+        {
+          m_negative = true;
+        }
+        else if (c == '.' && !m_point)
+        {
+          m_point = true;
+        }
+        else if (c >= '0' && c <= '9')
+        {
+          if (!m_point)
+          {
+            m_int = m_int * 10 + (c - '0');
+            m_digits++;
+          }
+        }
+        else
+        {
+          return false;
+        }
+      }
+
+      m_len++;
+
+      return true;
+    }
+
+    void NMEAParser::endField()
+    {
+      byte lf = latitudeField();
+      bool clear = true;
+
+      if (m_field == 0)
+      {
+        if (m_len == ID_LENGTH && m_id[2] == 'G' && m_id[3] == 'G' && m_id[4] == 'A')
+        {
+          m_type = SENTENCE_GGA;
+        }
+        else if (m_len == ID_LENGTH && m_id[2] == 'R' && m_id[3] == 'M' && m_id[4] == 'C')
+        {
+          m_type = SENTENCE_RMC;
+        }
+      }
+      else if ( lf != 0 && (m_field == lf || m_field == lf + 2) )
+      {
+        // Coordinate is written when its hemisphere is known
+        clear = false;
+      }
+      else if ( lf != 0 && (m_field == lf + 1 || m_field == lf + 3) )
+      {
+        if (m_len > 0 && m_digits > 0 && m_active)
+        {
+          writeCoordinate(m_field == lf + 1);
+        }
+      }
+      else if (m_type == SENTENCE_GGA && m_field == 9)
+      {
+        if (m_digits > 0)
+        {
+          writeAltitude();
+        }
+      }
+
+      if (clear)
+      {
+        m_negative = false;
+        m_int = 0;
+        m_minutes = 0;
+        m_digits = 0;
+        m_decimals = 0;
+        m_point = false;
+      }
+
+      m_field++;
+      m_len = 0;
+    }
+
+    void NMEAParser::writeCoordinate(bool latitude)
+    {
+      // Minutes are scaled by 10^m_decimals: get degrees scaled by 10^7
+      unsigned long scale = 1;
+      for (byte i = 0; i < m_decimals; i++)
+      {
+        scale *= 10;
+      }
+
+      if (m_minutes >= 60 * scale || m_int > 180)
+      {
+        return;
+      }
+
+      unsigned long fraction = m_minutes;
+      for (byte i = m_decimals; i < 7; i++)
+      {
+        fraction *= 10;
+      }
+      fraction /= 60;
+
+      char buf[GPSPosition::COODINATE_LENGTH] = {0};
+      byte i = 0;
+
+      if (m_negative)
+      {
+        buf[i++] = '-';
+      }
+
+      if (m_int >= 100)
+      {
+        buf[i++] = '0' + (m_int / 100);
+      }
+      if (m_int >= 10)
+      {
+        buf[i++] = '0' + ((m_int / 10) % 10);
+      }
+      buf[i++] = '0' + (m_int % 10);
+      buf[i++] = '.';
+
+      for (byte j = 7; j > 0; j--)
+      {
+        buf[i + j - 1] = '0' + (fraction % 10);
+        fraction /= 10;
+      }
+
+      if (latitude)
+      {
+        m_position->setLatitude(buf);
+      }
+      else
+      {
+        m_position->setLongitude(buf);
+      }
+    }
+
+    void NMEAParser::writeAltitude()
+    {
+      char buf[GPSPosition::ALTITUDE_LENGTH] = {0};
+      char digits[GPSPosition::ALTITUDE_LENGTH];
+      byte n = 0;
+      unsigned long value = m_int;
+
+      do
+      {
+        digits[n++] = '0' + (value % 10);
+        value /= 10;
+      } while (value > 0 && n < GPSPosition::ALTITUDE_LENGTH);
+
+      // Sign and digits must leave room for the terminator
+      if (value > 0 || n + (m_negative ? 1 : 0) >= GPSPosition::ALTITUDE_LENGTH)
+      {
+        return;
+      }
+
+      byte i = 0;
+      if (m_negative)
+      {
+        buf[i++] = '-';
+      }
+
+      while (n > 0)
+      {
+        buf[i++] = digits[--n];
+      }
+
+      m_position->setAltitude(buf);
+    }
+
+    byte NMEAParser::hex2dec(char c)
+    {
+      if (c >= '0' && c <= '9')
+      {
+        return c - '0';
+      }
+
+      if (c >= 'A' && c <= 'F')
+      {
+        return c - 'A' + 10;
+      }
+
+      if (c >= 'a' && c <= 'f')
+      {
+        return c - 'a' + 10;
+      }
+
+      return 0xFF;
+    }
+
+  } /* namespace data */
+
+} /* namespace smrtobj */
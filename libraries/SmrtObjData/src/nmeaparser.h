@@ -0,0 +1,280 @@
+/**
+ * \file nmeaparser.h
+ * \brief Arduino library to decode NMEA sentences one byte at a time. Position fields of GGA and
+ *        RMC sentences are written into a GPS position as soon as they are received.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+
+#ifndef NMEAPARSER_H_
+#define NMEAPARSER_H_
+
+
+#if ARDUINO >= 100
+#include "Arduino.h"       // for delayMicroseconds, digitalPinToBitMask, etc
+#else
+#include "WProgram.h"      // for delayMicroseconds
+#include "pins_arduino.h"  // for digitalPinToBitMask, etc
+#endif
+
+#include "gpsposition.h"
+
+namespace smrtobj
+{
+
+  namespace data
+  {
+
+    /**
+     * The NMEAParser class decodes the NMEA 0183 sentences sent by a GPS receiver, one character at a time.
+     * It does not need a buffer for the whole sentence (up to 82 characters): every field is decoded while
+     * it is received, the checksum is computed on the fly and latitude, longitude and altitude of \e GGA
+     * and \e RMC sentences are written into the attached smrtobj::data::GPSPosition as soon as their fields
+     * are complete. Other sentences are ignored.
+     *
+     * Latitude and longitude are converted from the NMEA format (ddmm.mmmm and dddmm.mmmm) to decimal
+     * degrees with 7 decimals, positive for North and East. Altitude is truncated to meters.
+     * Empty fields (e.g. before a fix) and the fields of an RMC sentence with status \e V (void) do not
+     * change the position.
+     *
+     * \b Note: \n
+     * Since fields are written before the checksum is received, a sentence with a wrong checksum can
+     * leave fields of the corrupted sentence in the position. Use the return value of
+     * smrtobj::data::NMEAParser::encode to discard it (e.g. decoding into a scratch position and copying it
+     * only on success).
+     *
+     * \code{.cpp}
+     * smrtobj::data::GPSPosition p;
+     * smrtobj::data::NMEAParser nmea(p);
+     *
+     * while ( Serial.available() )
+     * {
+     *   if ( nmea.encode(Serial.read()) == smrtobj::data::NMEAParser::SENTENCE_VALID )
+     *   {
+     *     Serial.println(p.latitude());
+     *   }
+     * }
+     * \endcode
+     */
+    class NMEAParser
+    {
+      public:
+        /**
+         * Result of the decoding of a character.
+         */
+        enum _nmea_result
+        {
+          //! Sentence not complete yet, or sentence ignored
+          SENTENCE_PENDING = 0,
+
+          //! GGA or RMC sentence completed with a valid checksum
+          SENTENCE_VALID = 1,
+
+          //! Sentence completed with a wrong checksum
+          INVALID_CHECKSUM = -1,
+
+          //! Sentence too long or with invalid characters
+          INVALID_SENTENCE = -2,
+        };
+
+        /**
+         * Type of the sentences decoded.
+         */
+        enum _nmea_sentence
+        {
+          //! Unknown or ignored sentence
+          SENTENCE_UNKNOWN = 0,
+
+          //! Global Positioning System Fix Data
+          SENTENCE_GGA = 1,
+
+          //! Recommended Minimum Specific GNSS Data
+          SENTENCE_RMC = 2,
+        };
+
+        /**
+         * Limits of the NMEA protocol.
+         */
+        enum _nmea_limits
+        {
+          //! Maximum length of a sentence, from '$' to the end of the checksum
+          SENTENCE_LENGTH = 82,
+
+          //! Length of the sentence identifier (talker + type, e.g. GPGGA)
+          ID_LENGTH = 5,
+
+          //! Maximum number of decimals of the minutes used for the conversion
+          MINUTE_DECIMALS = 5,
+        };
+
+        /**
+         * Constructor.
+         *
+         * \param[in] position GPS position where decoded fields are written
+         */
+        NMEAParser(GPSPosition &position);
+
+        /**
+         * Copy Constructor
+         *
+         * \param[in] p source parser
+         */
+        NMEAParser(const NMEAParser& p);
+
+        /**
+         * Destructor
+         *
+         */
+        virtual ~NMEAParser();
+
+        /**
+         * Override operator =
+         *
+         * \param[in] p source parser
+         *
+         * \return reference to the destination parser
+         */
+        NMEAParser& operator=(const NMEAParser& p);
+
+        /**
+         * Decodes a character received from the GPS receiver.
+         *
+         * \param[in] c character received
+         *
+         * \return SENTENCE_VALID when a GGA or RMC sentence ends with a valid checksum, SENTENCE_PENDING while
+         *         a sentence is received, error codes (from _nmea_result enum) otherwise
+         */
+        int encode(char c);
+
+        /**
+         * Discards the sentence currently decoded and waits for the next '$'.
+         */
+        void reset();
+
+        /**
+         * Gets the type of the last valid sentence.
+         *
+         * \return sentence type according to _nmea_sentence enum
+         */
+        byte sentence() const { return m_last; }
+
+      private:
+        /**
+         * Internal state of the decoder
+         */
+        enum _nmea_state
+        {
+          //! Waiting for '$'
+          WAIT_START = 0,
+
+          //! Decoding fields
+          DATA = 1,
+
+          //! Waiting for the first checksum digit
+          CHECKSUM_HI = 2,
+
+          //! Waiting for the second checksum digit
+          CHECKSUM_LO = 3,
+        };
+
+        /**
+         * Index of the latitude field for the current sentence (the next fields are hemisphere, longitude
+         * and hemisphere).
+         *
+         * \return field index, 0 if sentence is unknown
+         */
+        byte latitudeField() const;
+
+        /**
+         * Accumulates a character of the current field.
+         *
+         * \param[in] c character of the field
+         *
+         * \return false if the character is not valid for the field
+         */
+        bool addChar(char c);
+
+        /**
+         * Completes the current field, writing its value into the GPS position when needed.
+         */
+        void endField();
+
+        /**
+         * Writes the coordinate accumulated as decimal degrees.
+         *
+         * \param[in] latitude true for latitude, false for longitude
+         */
+        void writeCoordinate(bool latitude);
+
+        /**
+         * Writes the altitude accumulated.
+         */
+        void writeAltitude();
+
+        /**
+         * Converts a hexadecimal digit.
+         *
+         * \param[in] c hexadecimal digit
+         *
+         * \return value of the digit, 0xFF if it is not valid
+         */
+        static byte hex2dec(char c);
+
+        //! GPS position to update
+        GPSPosition* m_position;
+
+        //! Decoder state
+        byte m_state;
+
+        //! Number of characters of the current sentence
+        byte m_count;
+
+        //! Checksum of the current sentence
+        byte m_checksum;
+
+        //! Checksum received
+        byte m_received;
+
+        //! Type of the current sentence
+        byte m_type;
+
+        //! Type of the last valid sentence
+        byte m_last;
+
+        //! Index of the current field
+        byte m_field;
+
+        //! Number of characters of the current field
+        byte m_len;
+
+        //! Sentence identifier
+        char m_id[ID_LENGTH];
+
+        //! false if the current sentence does not carry a valid position (RMC with status V)
+        bool m_active;
+
+        //! Negative value (South, West or negative altitude)
+        bool m_negative;
+
+        //! Integer part: degrees for coordinates, meters for altitude
+        unsigned long m_int;
+
+        //! Minutes, scaled by 10^m_decimals
+        unsigned long m_minutes;
+
+        //! Number of digits of the minutes (integer and decimals)
+        byte m_digits;
+
+        //! Number of decimals of the minutes
+        byte m_decimals;
+
+        //! true after the decimal point
+        bool m_point;
+    };
+
+  } /* namespace data */
+
+} /* namespace smrtobj */
+
+#endif /* NMEAPARSER_H_ */
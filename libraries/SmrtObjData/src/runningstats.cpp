@@ -0,0 +1,79 @@
+/**
+ * \file runningstats.cpp
+ * \brief Arduino library to calculate statistics (mean, variance, standard deviation, minimum and
+ *        maximum) of a stream of samples without storing them.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "runningstats.h"
+
+namespace smrtobj
+{
+
+  namespace data
+  {
+    /**********************************************************************************
+     * RunningStats
+     **********************************************************************************/
+    RunningStats::RunningStats()
+    {
+      reset();
+    }
+
+    RunningStats::RunningStats(const RunningStats& s)
+    {
+      (*this) = s;
+    }
+
+    RunningStats::~RunningStats()
+    {
+    }
+
+    RunningStats& RunningStats::operator=(const RunningStats& s)
+    {
+      m_n = s.m_n;
+      m_mean = s.m_mean;
+      m_m2 = s.m_m2;
+      m_min = s.m_min;
+      m_max = s.m_max;
+
+      return (*this);
+    }
+
+    void RunningStats::reset()
+    {
+      m_n = 0;
+      m_mean = 0.0;
+      m_m2 = 0.0;
+      m_min = 0.0;
+      m_max = 0.0;
+    }
+
+    float RunningStats::push(float value)
+    {
+      float delta = value - m_mean;
+
+      if (++m_n == 1)
+      {
+        m_min = value;
+        m_max = value;
+      }
+      else if (value < m_min)
+      {
+        m_min = value;
+      }
+      else if (value > m_max)
+      {
+        m_max = value;
+      }
+
+      m_mean += delta / m_n;
+      m_m2 += delta * (value - m_mean);
+
+      return m_mean;
+    }
+
+  } /* namespace data */
+
+}/* namespace smrtobj */
@@ -0,0 +1,172 @@
+/**
+ * \file runningstats.h
+ * \brief Arduino library to calculate statistics (mean, variance, standard deviation, minimum and
+ *        maximum) of a stream of samples without storing them.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+
+#ifndef RUNNINGSTATS_H_
+#define RUNNINGSTATS_H_
+
+
+#if ARDUINO >= 100
+#include "Arduino.h"       // for delayMicroseconds, digitalPinToBitMask, etc
+#else
+#include "WProgram.h"      // for delayMicroseconds
+#include "pins_arduino.h"  // for digitalPinToBitMask, etc
+#endif
+
+
+namespace smrtobj
+{
+
+  namespace data
+  {
+
+    /**
+     * The RunningStats class calculates mean, variance, standard deviation, minimum and maximum of a
+     * stream of samples, using a constant amount of memory.
+     *
+     * Mean and variance are updated using the Welford's algorithm:
+     *
+     * \f$
+     * M(n) = M(n-1) + \frac{x(n) - M(n-1)}{n}
+     * \f$
+     *
+     * \f$
+     * S(n) = S(n-1) + (x(n) - M(n-1)) (x(n) - M(n))
+     * \f$
+     *
+     * where S(n) is the sum of squared differences from the mean; the variance is S(n) / (n - 1).
+     * Differently from the sum of squares, it does not lose precision when the samples have a large
+     * mean and a small variance, so the statistics hold over long runs.
+     *
+     * \code{.cpp}
+     * smrtobj::data::RunningStats stats;
+     *
+     * stats.push(sensor.read());
+     * ...
+     * // Every minute
+     * Serial.println(stats.mean());
+     * Serial.println(stats.stddev());
+     * stats.reset();
+     * \endcode
+     */
+    class RunningStats
+    {
+        //! Number of samples
+        unsigned long m_n;
+
+        //! Mean
+        float m_mean;
+
+        //! Sum of squared differences from the mean
+        float m_m2;
+
+        //! Minimum value
+        float m_min;
+
+        //! Maximum value
+        float m_max;
+
+      public:
+        /**
+         * Default Constructor
+         */
+        RunningStats();
+
+        /**
+         * Copy Constructor
+         *
+         * \param[in] s statistics
+         *
+         */
+        RunningStats(const RunningStats& s);
+
+        /**
+         * Destructor
+         */
+        virtual ~RunningStats();
+
+        /**
+         * Override operator =
+         *
+         * \param[in] s source statistics
+         *
+         * \return reference to the destination statistics
+         */
+        RunningStats& operator=(const RunningStats& s);
+
+        /**
+         * Resets statistics, removing all samples
+         *
+         */
+        void reset();
+
+        /**
+         * Adds a sample
+         *
+         * \param value value to add
+         *
+         * \return new mean value
+         */
+        float push(float value);
+
+        /**
+         * Checks if statistics are valid (not 0 samples)
+         *
+         * \return true if is valid, false otherwise
+         */
+        bool isValid() const { return (m_n > 0); };
+
+        /**
+         * Returns the number of samples.
+         *
+         * \return number of samples.
+         */
+        unsigned long count() const { return m_n; };
+
+        /**
+         * Gets mean value
+         *
+         * \return mean value, 0 if there are no samples
+         */
+        float mean() const { return m_mean; };
+
+        /**
+         * Gets the sample variance (the sum of squared differences from the mean divided by n - 1)
+         *
+         * \return variance, 0 if there are less than 2 samples
+         */
+        float variance() const { return (m_n > 1) ? m_m2 / (m_n - 1) : 0.0; };
+
+        /**
+         * Gets the sample standard deviation
+         *
+         * \return standard deviation, 0 if there are less than 2 samples
+         */
+        float stddev() const { return sqrt( variance() ); };
+
+        /**
+         * Gets minimum value
+         *
+         * \return minimum value, 0 if there are no samples
+         */
+        float minimum() const { return m_min; };
+
+        /**
+         * Gets maximum value
+         *
+         * \return maximum value, 0 if there are no samples
+         */
+        float maximum() const { return m_max; };
+
+    };
+
+  } /* namespace data */
+
+} /* namespace smrtobj */
+
+#endif /* RUNNINGSTATS_H_ */
@@ -14,6 +14,10 @@
 // Data
 #include <avgvalue.h>
 #include <gpsposition.h>
+#include <gpsfix.h>
+#include <movingaverage.h>
+#include <nmeaparser.h>
+#include <runningstats.h>
 
 
 #endif /* SMRTOBJDATA_H_ */
@@ -0,0 +1,60 @@
+/*
+ * Routing.ino
+ * Reads eight HIH7121 sensors (same address) connected to the channels of a PCA9548A multiplexer.
+ * The multiplexer is written only when the channel changes.
+ *
+ * Authors:
+ *         Marco Boeris Frusca
+ *
+ */
+
+// I2Cdev must be installed as library, or else the .cpp/.h files
+// must be in the include path of your project
+#include "I2Cdev.h"
+
+// SmartObject library
+#include <smrtobjio.h>
+#include <smrtobji2c.h>
+
+#include <Wire.h>    // include Wire library
+
+// Number of sensors
+#define SENSORS 8
+
+// I2C multiplexer
+smrtobj::i2c::PCA9548A mux;
+
+// Humidity sensors, one for each channel
+smrtobj::i2c::HIH7121 hih[SENSORS];
+
+void setup()
+{
+  // Open serial monitor
+  Serial.begin(9600);
+
+  // Open I2C
+  Wire.begin();
+
+  // Register the path of each sensor
+  for (uint8_t i = 0; i < SENSORS; i++)
+  {
+    hih[i].setPath(&mux, i);
+  }
+}
+
+void loop()
+{
+  for (uint8_t i = 0; i < SENSORS; i++)
+  {
+    // The channel is selected by read()
+    if ( hih[i].read() )
+    {
+      Serial.print( F("CH") );
+      Serial.print( i , DEC );
+      Serial.print( F(" RH: ") );
+      Serial.println( hih[i].humidity() );
+    }
+  }
+
+  delay(10000);
+}
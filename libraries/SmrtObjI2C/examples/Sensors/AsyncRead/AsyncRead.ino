@@ -0,0 +1,77 @@
+/*
+ * AsyncRead.ino
+ * Reads a IAQ2000 (VOC) and a HIH7121 (T and RH) sensor in background and prints
+ * the values to the serial monitor. The loop never waits for the I2C bus.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <Wire.h>           // I2C
+
+// I2Cdev must be installed as library, or else the .cpp/.h files
+// must be in the include path of your project
+#include "I2Cdev.h"
+
+// SmartObject library
+#include <smrtobjio.h>      // Generic analog/digital sensors
+#include <smrtobji2c.h>     // I2C device
+
+// I2C devices
+smrtobj::i2c::IAQ2000 iaq;
+smrtobj::i2c::HIH7121 hih;
+
+// Time of the last reading
+unsigned long last = 0;
+
+// true while readings are pending
+bool iaqPending = false;
+bool hihPending = false;
+
+void setup()
+{
+  // Open serial monitor
+  Serial.begin(9600);
+
+  // Open I2C
+  Wire.begin();
+}
+
+void loop()
+{
+  // Start a new reading every 10 seconds
+  if ( millis() - last >= 10000 )
+  {
+    last = millis();
+    iaqPending = iaq.begin();
+    hihPending = hih.begin();
+  }
+
+  // Advance transfers and check results
+  int8_t status = iaq.poll();
+  if ( iaqPending && status != smrtobj::i2c::I2CTransaction::QUEUED && status != smrtobj::i2c::I2CTransaction::RUNNING )
+  {
+    iaqPending = false;
+    if ( status == smrtobj::i2c::I2CTransaction::DONE )
+    {
+      Serial.print( F("VOC: ") );
+      Serial.print( iaq.measure() , DEC );
+      Serial.println( F(" ppm") );
+    }
+  }
+
+  status = hih.poll();
+  if ( hihPending && status != smrtobj::i2c::I2CTransaction::QUEUED && status != smrtobj::i2c::I2CTransaction::RUNNING )
+  {
+    hihPending = false;
+    if ( status == smrtobj::i2c::I2CTransaction::DONE )
+    {
+      Serial.print( F("RH: ") );
+      Serial.print( hih.humidity() );
+      Serial.print( F(" % T: ") );
+      Serial.println( hih.temperature() );
+    }
+  }
+
+  // Other tasks are not blocked
+}
@@ -0,0 +1,111 @@
+/**
+ * \file i2csimbus.cpp
+ * \brief  I2CSimBus simulates an I2C bus and its devices, to test drivers and smrtobj::i2c::I2CQueue
+ *         without hardware (also in a host build).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "bus/i2csimbus.h"
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    /**********************************************************************************
+     * I2CSimDevice
+     **********************************************************************************/
+    I2CSimDevice::I2CSimDevice(uint8_t addr) :
+        m_addr(addr)
+    {
+    }
+
+    I2CSimDevice::~I2CSimDevice()
+    {
+    }
+
+    /**********************************************************************************
+     * I2CSimBus
+     **********************************************************************************/
+    I2CSimBus::I2CSimBus(uint8_t latency) :
+        m_ndevices(0),
+        m_t(0),
+        m_latency(latency),
+        m_wait(0),
+        m_count(0)
+    {
+    }
+
+    I2CSimBus::~I2CSimBus()
+    {
+    }
+
+    bool I2CSimBus::attach(I2CSimDevice &d)
+    {
+      if (m_ndevices >= MAX_DEVICES)
+      {
+        return false;
+      }
+
+      m_devices[m_ndevices++] = &d;
+
+      return true;
+    }
+
+    bool I2CSimBus::begin(I2CTransaction &t)
+    {
+      m_t = &t;
+      m_wait = m_latency;
+      m_count++;
+
+      return true;
+    }
+
+    int8_t I2CSimBus::poll()
+    {
+      if (!m_t)
+      {
+        return I2CTransaction::ERROR_BUS;
+      }
+
+      if (m_wait > 0)
+      {
+        m_wait--;
+        return I2CTransaction::RUNNING;
+      }
+
+      I2CTransaction *t = m_t;
+      m_t = 0;
+
+      I2CSimDevice *d = 0;
+      for (uint8_t i = 0; i < m_ndevices && !d; i++)
+      {
+        if (m_devices[i]->address() == t->address())
+        {
+          d = m_devices[i];
+        }
+      }
+
+      if (!d)
+      {
+        return I2CTransaction::ERROR_ADDRESS;
+      }
+
+      if ( (t->writeLength() > 0 || t->readLength() == 0) && !d->write(t->writeData(), t->writeLength()) )
+      {
+        return I2CTransaction::ERROR_DATA;
+      }
+
+      if ( t->readLength() > 0 && !d->read(t->readData(), t->readLength()) )
+      {
+        return I2CTransaction::ERROR_DATA;
+      }
+
+      return I2CTransaction::DONE;
+    }
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
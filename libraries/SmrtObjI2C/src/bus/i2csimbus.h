@@ -0,0 +1,171 @@
+/**
+ * \file i2csimbus.h
+ * \brief  I2CSimBus simulates an I2C bus and its devices, to test drivers and smrtobj::i2c::I2CQueue
+ *         without hardware (also in a host build).
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef I2CSIMBUS_H_
+#define I2CSIMBUS_H_
+
+#include "interfaces/i2cbus.h"
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    /**
+     * The I2CSimDevice class models a device connected to a smrtobj::i2c::I2CSimBus. This is a virtual
+     * class and defines two virtual method:
+     *   - write : receives the bytes written by the master;
+     *   - read : gives the bytes read by the master.
+     *
+     * A write then read transaction calls write and then read.
+     */
+    class I2CSimDevice
+    {
+      public:
+        /**
+         * Constructor.
+         *
+         * \param[in] addr device address
+         */
+        I2CSimDevice(uint8_t addr);
+
+        /**
+         * Destructor.
+         */
+        virtual ~I2CSimDevice();
+
+        /**
+         * Returns the device address.
+         *
+         * \return device address
+         */
+        uint8_t address() const { return m_addr; }
+
+        /**
+         * Receives the bytes written by the master.
+         *
+         * \param[in] data data written
+         * \param[in] len number of bytes (0 if the master only addresses the device)
+         *
+         * \return true if all bytes are acknowledged, false otherwise
+         */
+        virtual bool write(const uint8_t *data, uint8_t len) = 0;
+
+        /**
+         * Gives the bytes read by the master.
+         *
+         * \param[out] data data read
+         * \param[in] len number of bytes
+         *
+         * \return true if the bytes are available, false otherwise
+         */
+        virtual bool read(uint8_t *data, uint8_t len) = 0;
+
+      private:
+        //! Device address
+        uint8_t m_addr;
+    };
+
+    /**
+     * The I2CSimBus class executes the transactions with simulated devices (smrtobj::i2c::I2CSimDevice).
+     * Each transaction stays on the bus for a given number of polls, so the asynchronous behavior of
+     * drivers can be tested. Transactions to addresses without devices fail with
+     * I2CTransaction::ERROR_ADDRESS.
+     *
+     * \code{.cpp}
+     * MySimSensor sensor(0x27);
+     * smrtobj::i2c::I2CSimBus bus;
+     *
+     * bus.attach(sensor);
+     * smrtobj::i2c::I2CQueue::setBus(bus);
+     * \endcode
+     */
+    class I2CSimBus : public I2CBus
+    {
+      public:
+        //! Maximum number of devices
+        static const uint8_t MAX_DEVICES = 8;
+
+        /**
+         * Constructor.
+         *
+         * \param[in] latency number of polls of each transaction
+         */
+        I2CSimBus(uint8_t latency = 1);
+
+        /**
+         * Destructor.
+         */
+        virtual ~I2CSimBus();
+
+        /**
+         * Connects a device to the bus.
+         *
+         * \param[in] d device
+         *
+         * \return false if there are already MAX_DEVICES devices, true otherwise
+         */
+        bool attach(I2CSimDevice &d);
+
+        /**
+         * Sets the number of polls of each transaction.
+         *
+         * \param[in] latency number of polls
+         */
+        void setLatency(uint8_t latency) { m_latency = latency; }
+
+        /**
+         * Gets the number of transactions started.
+         *
+         * \return number of transactions
+         */
+        unsigned long transactions() const { return m_count; }
+
+        /**
+         * Starts a transaction.
+         *
+         * \param[in] t transaction
+         *
+         * \return always true
+         */
+        virtual bool begin(I2CTransaction &t);
+
+        /**
+         * Executes the transaction when its latency has elapsed.
+         *
+         * \return I2CTransaction::RUNNING while the transaction is on the bus, I2CTransaction::DONE or an error
+         *         code (from smrtobj::i2c::I2CTransaction::_status enum) when it is completed
+         */
+        virtual int8_t poll();
+
+      private:
+        //! Devices
+        I2CSimDevice *m_devices[MAX_DEVICES];
+
+        //! Number of devices
+        uint8_t m_ndevices;
+
+        //! Transaction on the bus
+        I2CTransaction *m_t;
+
+        //! Number of polls of each transaction
+        uint8_t m_latency;
+
+        //! Polls left for the current transaction
+        uint8_t m_wait;
+
+        //! Number of transactions
+        unsigned long m_count;
+    };
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
+
+#endif /* I2CSIMBUS_H_ */
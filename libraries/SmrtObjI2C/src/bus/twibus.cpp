@@ -0,0 +1,208 @@
+/**
+ * \file twibus.cpp
+ * \brief  TWIBus executes the transactions of smrtobj::i2c::I2CQueue with the TWI peripheral of AVR
+ *         microcontrollers, without waiting for the end of the transfers.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "bus/twibus.h"
+
+#if defined(TWCR)
+#include <util/twi.h>
+#endif
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    TWIBus::TWIBus(uint16_t timeout) :
+        m_t(0),
+        m_index(0),
+        m_status(I2CTransaction::IDLE),
+        m_stopping(false),
+        m_twcr(0),
+        m_start(0),
+        m_timeout(timeout)
+    {
+    }
+
+    TWIBus::~TWIBus()
+    {
+    }
+
+#if defined(TWCR)
+    bool TWIBus::begin(I2CTransaction &t)
+    {
+      m_t = &t;
+      m_index = 0;
+      m_status = I2CTransaction::RUNNING;
+      m_stopping = false;
+      m_start = millis();
+
+      // Wire interrupt is disabled until the end of the transaction
+      m_twcr = TWCR & (_BV(TWIE) | _BV(TWEA));
+      TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTA);
+
+      return true;
+    }
+
+    int8_t TWIBus::poll()
+    {
+      if (!m_t)
+      {
+        return I2CTransaction::ERROR_BUS;
+      }
+
+      if (m_stopping)
+      {
+        if ( TWCR & _BV(TWSTO) )
+        {
+          return I2CTransaction::RUNNING;
+        }
+
+        release();
+        return m_status;
+      }
+
+      if ( !(TWCR & _BV(TWINT)) )
+      {
+        if ( m_timeout > 0 && (millis() - m_start) > m_timeout )
+        {
+          // The peripheral is reset to release the bus
+          TWCR = 0;
+          TWCR = _BV(TWEN);
+          release();
+
+          return I2CTransaction::ERROR_TIMEOUT;
+        }
+
+        return I2CTransaction::RUNNING;
+      }
+
+      const uint8_t addr = m_t->address() << 1;
+      const uint8_t wlen = m_t->writeLength();
+      const uint8_t rlen = m_t->readLength();
+
+      switch (TW_STATUS)
+      {
+        case TW_START :
+        {
+          // Read only transactions start reading
+          TWDR = (wlen == 0 && rlen > 0) ? (addr | TW_READ) : (addr | TW_WRITE);
+          TWCR = _BV(TWEN) | _BV(TWINT);
+        } break;
+
+        case TW_REP_START :
+        {
+          m_index = 0;
+          TWDR = addr | TW_READ;
+          TWCR = _BV(TWEN) | _BV(TWINT);
+        } break;
+
+        case TW_MT_SLA_ACK :
+        case TW_MT_DATA_ACK :
+        {
+          if (m_index < wlen)
+          {
+            TWDR = m_t->writeData()[m_index++];
+            TWCR = _BV(TWEN) | _BV(TWINT);
+          }
+          else if (rlen > 0)
+          {
+            TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTA);
+          }
+          else
+          {
+            stop(I2CTransaction::DONE);
+          }
+        } break;
+
+        case TW_MT_SLA_NACK :
+        case TW_MR_SLA_NACK :
+        {
+          stop(I2CTransaction::ERROR_ADDRESS);
+        } break;
+
+        case TW_MT_DATA_NACK :
+        {
+          stop(I2CTransaction::ERROR_DATA);
+        } break;
+
+        case TW_MR_SLA_ACK :
+        {
+          // The last byte is not acknowledged
+          TWCR = _BV(TWEN) | _BV(TWINT) | ( (rlen > 1) ? _BV(TWEA) : 0 );
+        } break;
+
+        case TW_MR_DATA_ACK :
+        {
+          m_t->readData()[m_index++] = TWDR;
+          TWCR = _BV(TWEN) | _BV(TWINT) | ( (m_index < rlen - 1) ? _BV(TWEA) : 0 );
+        } break;
+
+        case TW_MR_DATA_NACK :
+        {
+          m_t->readData()[m_index++] = TWDR;
+          stop(I2CTransaction::DONE);
+        } break;
+
+        case TW_MT_ARB_LOST :
+        {
+          // The bus is released without stop condition
+          TWCR = _BV(TWEN) | _BV(TWINT);
+          release();
+
+          return I2CTransaction::ERROR_BUS;
+        } break;
+
+        default :
+        {
+          stop(I2CTransaction::ERROR_BUS);
+        }
+      }
+
+      return I2CTransaction::RUNNING;
+    }
+
+    void TWIBus::stop(int8_t status)
+    {
+      m_status = status;
+      m_stopping = true;
+      TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO);
+    }
+
+    void TWIBus::release()
+    {
+      TWCR = _BV(TWEN) | m_twcr;
+      m_t = 0;
+      m_stopping = false;
+    }
+#else
+    bool TWIBus::begin(I2CTransaction &t)
+    {
+      (void) t;
+      return false;
+    }
+
+    int8_t TWIBus::poll()
+    {
+      return I2CTransaction::ERROR_BUS;
+    }
+
+    void TWIBus::stop(int8_t status)
+    {
+      m_status = status;
+    }
+
+    void TWIBus::release()
+    {
+      m_t = 0;
+    }
+#endif
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
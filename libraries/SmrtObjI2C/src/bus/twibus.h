@@ -0,0 +1,108 @@
+/**
+ * \file twibus.h
+ * \brief  TWIBus executes the transactions of smrtobj::i2c::I2CQueue with the TWI peripheral of AVR
+ *         microcontrollers, without waiting for the end of the transfers.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef TWIBUS_H_
+#define TWIBUS_H_
+
+#include "interfaces/i2cbus.h"
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    /**
+     * The TWIBus class drives the TWI (I2C) peripheral of AVR microcontrollers directly. The peripheral
+     * transfers a byte (or sends a start/stop condition) in background and sets its TWINT flag at the
+     * end; every call to smrtobj::i2c::TWIBus::poll checks the flag and starts the next step, so the main
+     * loop never waits for the bus (the slave is held by clock stretching between two polls).
+     *
+     * The TWI interrupt is owned by the Wire library, so the peripheral is driven polling TWINT: its
+     * interrupt is disabled during a transaction and restored at the end, so Wire can be used between
+     * two transactions.
+     *
+     * \b Note: \n
+     * The bit rate and the pull-ups are not changed: call \b Wire.begin() before using the bus.\n
+     * On boards without TWI peripheral every transaction fails with I2CTransaction::ERROR_BUS.
+     */
+    class TWIBus : public I2CBus
+    {
+      public:
+        //! Default timeout of a transaction (milliseconds)
+        static const uint16_t DEFAULT_TIMEOUT = 100;
+
+        /**
+         * Constructor.
+         *
+         * \param[in] timeout timeout of a transaction (milliseconds), 0 to disable it
+         */
+        TWIBus(uint16_t timeout = DEFAULT_TIMEOUT);
+
+        /**
+         * Destructor.
+         */
+        virtual ~TWIBus();
+
+        /**
+         * Sends the start condition of a transaction.
+         *
+         * \param[in] t transaction
+         *
+         * \return true if the transaction has been started, false if the peripheral is not available
+         */
+        virtual bool begin(I2CTransaction &t);
+
+        /**
+         * Advances the transaction if the peripheral has completed the last step.
+         *
+         * \return I2CTransaction::RUNNING while the transaction is on the bus, I2CTransaction::DONE or an error
+         *         code (from smrtobj::i2c::I2CTransaction::_status enum) when it is completed
+         */
+        virtual int8_t poll();
+
+      private:
+        /**
+         * Sends the stop condition. The transaction is completed when the stop has been sent.
+         *
+         * \param[in] status final status of the transaction
+         */
+        void stop(int8_t status);
+
+        /**
+         * Restores the control register of the peripheral, as it was before the transaction.
+         */
+        void release();
+
+        //! Transaction on the bus
+        I2CTransaction *m_t;
+
+        //! Index of the next byte to write or read
+        uint8_t m_index;
+
+        //! Final status (I2CTransaction::RUNNING until the stop is sent)
+        int8_t m_status;
+
+        //! true while the stop condition is sent
+        bool m_stopping;
+
+        //! Bits of the control register used by Wire (interrupt and acknowledge)
+        uint8_t m_twcr;
+
+        //! Start time of the transaction (milliseconds)
+        unsigned long m_start;
+
+        //! Timeout (milliseconds)
+        uint16_t m_timeout;
+    };
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
+
+#endif /* TWIBUS_H_ */
@@ -0,0 +1,74 @@
+/**
+ * \file wirebus.cpp
+ * \brief  WireBus executes the transactions of smrtobj::i2c::I2CQueue with the Wire library.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "bus/wirebus.h"
+#include <Wire.h>
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    WireBus::WireBus() :
+        m_status(I2CTransaction::IDLE)
+    {
+    }
+
+    WireBus::~WireBus()
+    {
+    }
+
+    bool WireBus::begin(I2CTransaction &t)
+    {
+      const uint8_t wlen = t.writeLength();
+      const uint8_t rlen = t.readLength();
+
+      m_status = I2CTransaction::DONE;
+
+      if (wlen > 0 || rlen == 0)
+      {
+        Wire.beginTransmission(t.address());
+        for (uint8_t i = 0; i < wlen; i++)
+        {
+          Wire.write(t.writeData()[i]);
+        }
+
+        // A read after the write starts with a repeated start
+        switch ( Wire.endTransmission(rlen == 0) )
+        {
+          case 0 : break;
+          case 2 : m_status = I2CTransaction::ERROR_ADDRESS; break;
+          case 3 : m_status = I2CTransaction::ERROR_DATA; break;
+          default : m_status = I2CTransaction::ERROR_BUS;
+        }
+      }
+
+      if (m_status == I2CTransaction::DONE && rlen > 0)
+      {
+        if (Wire.requestFrom(t.address(), rlen) != rlen)
+        {
+          m_status = I2CTransaction::ERROR_ADDRESS;
+        }
+
+        for (uint8_t i = 0; i < rlen && Wire.available(); i++)
+        {
+          t.readData()[i] = Wire.read();
+        }
+      }
+
+      return true;
+    }
+
+    int8_t WireBus::poll()
+    {
+      return m_status;
+    }
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
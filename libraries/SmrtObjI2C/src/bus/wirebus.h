@@ -0,0 +1,65 @@
+/**
+ * \file wirebus.h
+ * \brief  WireBus executes the transactions of smrtobj::i2c::I2CQueue with the Wire library.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef WIREBUS_H_
+#define WIREBUS_H_
+
+#include "interfaces/i2cbus.h"
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    /**
+     * The WireBus class executes the transactions with the Wire library, so it works on every board.
+     * Wire functions wait for the end of the transfer: the whole transaction is executed by
+     * smrtobj::i2c::WireBus::begin and it is completed at the next poll of the queue.
+     *
+     * \b Note: \n
+     * Call \b Wire.begin() before using the bus.
+     */
+    class WireBus : public I2CBus
+    {
+      public:
+        /**
+         * Default Constructor.
+         */
+        WireBus();
+
+        /**
+         * Destructor.
+         */
+        virtual ~WireBus();
+
+        /**
+         * Executes a transaction.
+         *
+         * \param[in] t transaction
+         *
+         * \return always true
+         */
+        virtual bool begin(I2CTransaction &t);
+
+        /**
+         * Returns the status of the last transaction.
+         *
+         * \return I2CTransaction::DONE or an error code (from smrtobj::i2c::I2CTransaction::_status enum)
+         */
+        virtual int8_t poll();
+
+      private:
+        //! Status of the last transaction
+        int8_t m_status;
+    };
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
+
+#endif /* WIREBUS_H_ */
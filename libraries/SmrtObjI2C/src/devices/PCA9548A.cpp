@@ -12,12 +12,12 @@ namespace smrtobj
   namespace i2c
   {
 
-    PCA9548A::PCA9548A() : I2CInterface(DEVICE_ADDRESS), m_ctrl_reg(0)
+    PCA9548A::PCA9548A() : I2CInterface(DEVICE_ADDRESS), m_ctrl_reg(0), m_cached(false)
     {
 
     }
 
-    PCA9548A::PCA9548A(uint8_t addr):  m_ctrl_reg(0)
+    PCA9548A::PCA9548A(uint8_t addr):  m_ctrl_reg(0), m_cached(false)
     {
       if (addr < 0x70 || addr > 0x77)
       {
@@ -31,6 +31,7 @@ namespace smrtobj
     PCA9548A::PCA9548A(const PCA9548A &d): I2CInterface(d)
     {
       m_ctrl_reg = d.m_ctrl_reg;
+      m_cached = d.m_cached;
     }
 
     PCA9548A::~PCA9548A()
@@ -42,6 +43,7 @@ namespace smrtobj
     {
       I2CInterface::operator=(d);
       m_ctrl_reg = d.m_ctrl_reg;
+      m_cached = d.m_cached;
 
       return (*this);
     }
@@ -58,17 +60,21 @@ namespace smrtobj
 
     bool PCA9548A::read()
     {
-      return ( readAllBytes(address(), 1, &m_ctrl_reg, 0) > 0 );
+      m_cached = ( readAllBytes(address(), 1, &m_ctrl_reg, 0) > 0 );
+
+      return m_cached;
     }
 
     bool PCA9548A::write ()
     {
-      return ( writeAllBytes(address(), 1, &m_ctrl_reg, 0) > 0 );
+      m_cached = writeAllBytes(address(), 1, &m_ctrl_reg, 0);
+
+      return m_cached;
     }
 
     bool PCA9548A::setChannel(uint8_t n, bool en)
     {
-      if (n > 0x08)
+      if (n > 7)
         return false;
 
       uint8_t mask = 1;
@@ -76,22 +82,21 @@ namespace smrtobj
       mask <<= n;
 
       if (en)
-        m_ctrl_reg |= mask;
+        mask |= m_ctrl_reg;
       else
-        m_ctrl_reg &= ~(mask);
+        mask = m_ctrl_reg & ~(mask);
 
-      //Serial.print( " mask .. " );
-      //Serial.println( mask , HEX );
-
-      return write();
+      return setChannels(mask);
     }
 
-   bool PCA9548A::select(uint8_t n)
+    bool PCA9548A::setChannels(uint8_t mask)
     {
-      if ( !disableAll() )
-        return false;
+      if ( m_cached && m_ctrl_reg == mask )
+        return true;
+
+      m_ctrl_reg = mask;
 
-      return setChannel(n, 1);
+      return write();
     }
 
   } /* namespace i2c */
@@ -22,6 +22,25 @@ namespace smrtobj
      * The system master can reset the PCA9548A in the event of a timeout or other improper operation by asserting
      * a low in the RESET input. Similarly, the power-on reset deselects all channels and initializes the I2C/SMBus
      * state machine. Asserting RESET causes the same reset/initialization to occur without powering down the part.
+     *
+     * The value written in the control register is cached: smrtobj::i2c::PCA9548A::select writes the device
+     * only if the channel is not already selected. After a reset of the device, the cache must be invalidated
+     * with smrtobj::i2c::PCA9548A::invalidate.
+     *
+     * Devices connected to a channel can be registered with their path (see smrtobj::i2c::I2CInterface::setPath):
+     * the channel is selected before each transfer with the device.
+     *
+     * \code{.cpp}
+     * smrtobj::i2c::PCA9548A mux;
+     * smrtobj::i2c::HIH7121 rh[8];
+     *
+     * for (uint8_t i = 0; i < 8; i++)
+     * {
+     *   rh[i].setPath(&mux, i);
+     * }
+     * ...
+     * rh[3].read();   // selects channel 3 (if needed) and reads the sensor
+     * \endcode
      */
     class PCA9548A  : public I2CInterface
     {
@@ -117,14 +136,24 @@ namespace smrtobj
          *
          * \return true for success, or false if any error occurs. 
          */
-        bool disableAll() {m_ctrl_reg = 0x00; return write ();};
+        bool disableAll() { return setChannels(0x00); };
 
         /**
          * Enables all channels. This function writes in the control register the value 0xFF.
          *
          * \return true for success, or false if any error occurs. 
          */
-        bool enableAll() {m_ctrl_reg = 0xFF; return write ();};
+        bool enableAll() { return setChannels(0xFF); };
+
+        /**
+         * Sets the state (enable/disable) of all channels with one write. The control register is not written
+         * if it already has this value.
+         *
+         * \param[in] mask channels to enable (bit n for channel n)
+         *
+         * \return true for success, or false if any error occurs.
+         */
+        bool setChannels(uint8_t mask);
 
         /**
          * Sets the state (enable/disable) of a channel. 
@@ -137,13 +166,29 @@ namespace smrtobj
         bool setChannel(uint8_t n, bool en);
 
         /**
-         * Selects only a specific channel. 
+         * Selects only a specific channel. The control register is written (once) only if the channel is
+         * not already the only one selected.
          *
          * \param[in] n channel number
          *
          * \return true for success, or false if any error occurs. 
          */
-        bool select(uint8_t n);
+        bool select(uint8_t n) { return ( n < 8 ) ? setChannels(1 << n) : false; };
+
+        /**
+         * Checks if a channel is the only one selected, according to the cached control register.
+         *
+         * \param[in] n channel number
+         *
+         * \return true if the channel is selected, false if it is not or the cache is not valid
+         */
+        bool isSelected(uint8_t n) { return ( m_cached && n < 8 && m_ctrl_reg == (1 << n) ); };
+
+        /**
+         * Invalidates the cached control register (e.g. after a reset of the device), so that the next
+         * selection writes the device.
+         */
+        void invalidate() { m_cached = false; };
 
       protected:
         /**
@@ -154,8 +199,14 @@ namespace smrtobj
         bool write ();
 
       private:
+        //! The queue selects channels before routed transactions
+        friend class I2CQueue;
+
         //! Control register
         uint8_t m_ctrl_reg;
+
+        //! True if the control register has the same value of the device
+        bool m_cached;
     };
 
   } /* namespace i2c */
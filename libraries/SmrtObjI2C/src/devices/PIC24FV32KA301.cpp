@@ -47,9 +47,9 @@ namespace smrtobj
 
     bool PIC24FV32KA301::initialize()
     {
-      if ( I2Cdev::writeByte(DEVICE_ADDRESS, CFG_RAD_ADDRESS, m_cfg[RAD]) )
+      if ( writeByte(DEVICE_ADDRESS, CFG_RAD_ADDRESS, m_cfg[RAD]) )
       {
-        return I2Cdev::writeByte(DEVICE_ADDRESS, CFG_PM_ADDRESS, m_cfg[PM]);
+        return writeByte(DEVICE_ADDRESS, CFG_PM_ADDRESS, m_cfg[PM]);
       }
 
       return false;
@@ -71,68 +71,14 @@ namespace smrtobj
         return false;
       }
 
-/*
-      for (uint8_t n = 0; n < 4 * N_SENS; n++ )
-      {
-        Serial.print( F("[") );
-        Serial.print( n );
-        Serial.print( F("] : ") );
-        Serial.println( buf[n] , HEX);
-      }
-*/
-      uint8_t i = 0;
-      for ( i = 0; i < N_SENS; i++ )
-      {
-/*
-        Serial.print( F("[") );
-        Serial.print( i );
-        Serial.print( F("] : ") );
-*/
-        uint16_t n = buf[(i*2)];
-        n &= 0x0FF;
-/*
-        Serial.print( n , HEX);
-        Serial.print( F(" _ ") );
-*/
-        m_data[i] = n;
-        m_data[i] <<= 8;
-        m_data[i] &= 0xFF00;
-
-        n = buf[(i*2)+1];
-        n &= 0x0FF;
-        m_data[i] |=  n;
-/*
-        Serial.print( n , HEX);
-        Serial.print( F(" _ ") );
-        Serial.println( m_data[i] , HEX );
-*/
-      }
+      m_data[RAD] = Data<RAD>::get(buf);
+      m_data[PM] = Data<PM>::get(buf);
 
-      i*=2;
+      m_cfg[RAD] = Cfg<RAD>::get(buf);
+      m_cfg[PM] = Cfg<PM>::get(buf);
 
-      for (uint8_t j = 0; j < N_SENS; j++ )
-      {
-        m_cfg[j] = buf[i+j];
-/*
-        Serial.print( F("[") );
-        Serial.print( j );
-        Serial.print( F("] : ") );
-        Serial.println( m_cfg[j] );
-*/
-      }
-
-      i+= N_SENS;
-
-      for (uint8_t j = 0; j < N_SENS; j++ )
-      {
-        m_state[j] = buf[i+j];
-/*
-        Serial.print( F("[") );
-        Serial.print( j );
-        Serial.print( F("] : ") );
-        Serial.println( m_state[j] );
-*/
-      }
+      m_state[RAD] = State<RAD>::get(buf);
+      m_state[PM] = State<PM>::get(buf);
 
       return true;
     }
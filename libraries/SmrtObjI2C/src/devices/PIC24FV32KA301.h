@@ -16,6 +16,7 @@
 #define PIC24FV32KA301_H_
 
 #include <interfaces/i2cinterface.h>
+#include <interfaces/i2cregister.h>
 
 namespace smrtobj
 {
@@ -195,6 +196,18 @@ namespace smrtobj
 
 
       private:
+        //! Data register of a sensor: 2 bytes for each sensor, from the first byte read
+        template <uint8_t CODE>
+        struct Data : RegisterField<CODE * 2, 2> {};
+
+        //! Configuration register of a sensor: 1 byte for each sensor, after the data registers
+        template <uint8_t CODE>
+        struct Cfg : RegisterField<N_SENS * 2 + CODE, 1> {};
+
+        //! State register of a sensor: 1 byte for each sensor, after the configuration registers
+        template <uint8_t CODE>
+        struct State : RegisterField<N_SENS * 3 + CODE, 1> {};
+
         // Configuration registers
         uint8_t m_cfg[N_SENS];
 
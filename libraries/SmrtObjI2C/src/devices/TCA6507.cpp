@@ -15,15 +15,18 @@ namespace smrtobj
 
     TCA6507::TCA6507() : m_reset_pin(0)
     {
+      defaults();
     }
 
     TCA6507::TCA6507(uint8_t r_pin) : m_reset_pin(r_pin)
     {
+      defaults();
     }
 
     TCA6507::TCA6507(const TCA6507 &d) : I2CInterface(d)
     {
       m_reset_pin = d.m_reset_pin;
+      memcpy(m_reg, d.m_reg, REGISTERS);
     }
 
     TCA6507::~TCA6507()
@@ -35,6 +38,7 @@ namespace smrtobj
     {
       I2CInterface::operator=(d);
       m_reset_pin = d.m_reset_pin;
+      memcpy(m_reg, d.m_reg, REGISTERS);
 
       return (*this);
     }
@@ -56,27 +60,74 @@ namespace smrtobj
     void TCA6507::stop()
     {
       digitalWrite(m_reset_pin, LOW);
+      defaults();
+    }
+
+    void TCA6507::defaults()
+    {
+      // Reset values (data sheet, register descriptions)
+      m_reg[SELECT0] = 0x00;
+      m_reg[SELECT1] = 0x00;
+      m_reg[SELECT2] = 0x00;
+      m_reg[FADE_ON_TIME] = (TMS256 << 4) | TMS256;
+      m_reg[FULLY_ON_TIME] = (TMS256 << 4) | TMS256;
+      m_reg[FADE_OFF_TIME] = (TMS256 << 4) | TMS256;
+      m_reg[FIRST_FULLY_OFF_TIME] = (TMS256 << 4) | TMS256;
+      m_reg[SECOND_FULLY_OFF_TIME] = (TMS256 << 4) | TMS256;
+      m_reg[MAXIMUM_INTENSITY] = 0xFF;
+      m_reg[ONE_SHOT] = 0x00;
+      m_reg[REGISTERS - 1] = 0x00;
+    }
+
+    bool TCA6507::read()
+    {
+      // INITIALIZATION is the auto-increment flag of the command byte
+      return ( readBytes(DEVICE_ADDRESS, INITIALIZATION | SELECT0, REGISTERS, m_reg, 0) == REGISTERS );
+    }
+
+    bool TCA6507::update(uint8_t reg, const uint8_t *data, uint8_t length)
+    {
+      uint8_t first = 0;
+      while (first < length && m_reg[reg + first] == data[first])
+        first++;
+
+      if (first == length)
+        return true;
+
+      uint8_t last = length - 1;
+      while (m_reg[reg + last] == data[last])
+        last--;
+
+      uint8_t n = last - first + 1;
+
+      // INITIALIZATION is the auto-increment flag of the command byte
+      if ( !writeBytes(DEVICE_ADDRESS, INITIALIZATION | (reg + first), n, (uint8_t*) data + first) )
+        return false;
+
+      memcpy(m_reg + reg + first, data + first, n);
+
+      return true;
     }
 
     bool TCA6507::isConnected()
     {
       uint8_t result = 0;
 
-      return ( I2Cdev::readByte(DEVICE_ADDRESS, SELECT0, &result, 0) == 1);
+      return ( readByte(DEVICE_ADDRESS, SELECT0, &result, 0) == 1);
     };
 
     bool TCA6507::RAWSelRegsDrv(uint8_t s0, uint8_t s1, uint8_t s2)
     {
       uint8_t data[3] = {s0, s1, s2};
 
-      return I2Cdev::writeBytes(DEVICE_ADDRESS, INITIALIZATION, 3, data);
+      return update(SELECT0, data, 3);
     }
 
     bool TCA6507::RAWRegDrv(uint8_t reg, uint8_t val)
     {
       if(reg >= 3 && reg <= 10)
       {
-        return I2Cdev::writeByte(DEVICE_ADDRESS, reg, val);
+        return update(reg, &val, 1);
 
       }
 
@@ -85,11 +136,10 @@ namespace smrtobj
 
     uint8_t TCA6507::readReg(uint8_t reg)
     {
-      uint8_t result = 0;
+      if (reg >= REGISTERS)
+        return 0;
 
-     I2Cdev::readByte(DEVICE_ADDRESS, reg, &result, 0);
-
-      return result;
+      return m_reg[reg];
     }
 
     uint8_t TCA6507::pinState(uint8_t pin)
@@ -120,57 +170,59 @@ namespace smrtobj
 
     void TCA6507::pinSetState(uint8_t pin, uint8_t state)
     {
-      if(pin >= 0 && pin <= 6 && state >= 0 && state <= 7)
+      if(pin >= 0 && pin <= 6)
       {
-        uint8_t SR0 = readReg(0);
-        uint8_t SR0b = 0;
-        uint8_t SR1 = readReg(1);
-        uint8_t SR1b = 0;
-        uint8_t SR2 = readReg(2);
-        uint8_t SR2b = 0;
-
-        if(state == LED_ON_PWM0)
-        {
-          SR0b = 0;
-          SR1b = 1;
-          SR2b = 0;
-        }
-        else if(state == LED_ON_PWM1)
-        {
-          SR0b = 1;
-          SR1b = 1;
-          SR2b = 0;
-        }
-        else if(state == LED_ON)
-        {
-          SR0b = 0;
-          SR1b = 0;
-          SR2b = 1;
-        }
-        else if(state == LED_ON_ONE_SHOT)
-        {
-          SR0b = 1;
-          SR1b = 0;
-          SR2b = 1;
-        }
-        else if(state == LED_BLINK_BANK0)
-        {
-          SR0b = 0;
-          SR1b = 1;
-          SR2b = 1;
-        }
-        else if(state == LED_BLINK_BANK1)
+        pinsSetState(1 << pin, state);
+      }
+    }
+
+    bool TCA6507::pinsSetState(uint8_t mask, uint8_t state)
+    {
+      if (state > 7)
+        return false;
+
+      // Select2, Select1 and Select0 bits of an output are the bits 2, 1 and 0 of its state
+      // (0x01 is off, as 0x00)
+      if (state == 0x01)
+        state = LED_OFF;
+
+      mask &= 0x7F;
+
+      uint8_t data[3];
+
+      for (uint8_t i = 0; i < 3; i++)
+      {
+        data[i] = m_reg[SELECT0 + i] & ~mask;
+
+        if ( bitRead(state, i) )
+          data[i] |= mask;
+      }
+
+      return update(SELECT0, data, 3);
+    }
+
+    bool TCA6507::pinsSetState(const uint8_t *states)
+    {
+      uint8_t data[3] = {0, 0, 0};
+
+      for (uint8_t pin = 0; pin <= 6; pin++)
+      {
+        uint8_t state = states[pin];
+
+        if (state > 7)
+          return false;
+
+        if (state == 0x01)
+          state = LED_OFF;
+
+        for (uint8_t i = 0; i < 3; i++)
         {
-          SR0b = 1;
-          SR1b = 1;
-          SR2b = 1;
+          if ( bitRead(state, i) )
+            bitSet(data[i], pin);
         }
-
-        SR0 = bitWrite(SR0, pin, SR0b);
-        SR1 = bitWrite(SR1, pin, SR1b);
-        SR2 = bitWrite(SR2, pin, SR2b);
-        RAWSelRegsDrv(SR0, SR1, SR2);
       }
+
+      return update(SELECT0, data, 3);
     }
 
     void TCA6507::basicBankSetup(uint8_t nBank, uint8_t fadeOn, uint8_t onTime, uint8_t fadeOff, uint8_t offTime, uint8_t sdOffTime)
@@ -178,11 +230,14 @@ namespace smrtobj
 
       if (nBank >= 0 && nBank <= 1 && fadeOn >= 0 && fadeOn <= 15 && onTime >= 0 && onTime <= 15 && fadeOff >= 0 && fadeOff <= 15 && offTime >= 0 && offTime <= 15 && sdOffTime >= 0 && sdOffTime <= 15 )
       {
-        uint8_t SR3 = readReg(FADE_ON_TIME);
-        uint8_t SR4 = readReg(FULLY_ON_TIME);
-        uint8_t SR5 = readReg(FADE_OFF_TIME);
-        uint8_t SR6 = readReg(FIRST_FULLY_OFF_TIME);
-        uint8_t SR7 = readReg(SECOND_FULLY_OFF_TIME);
+        uint8_t SR[5];
+        memcpy(SR, m_reg + FADE_ON_TIME, 5);
+
+        uint8_t &SR3 = SR[0];
+        uint8_t &SR4 = SR[1];
+        uint8_t &SR5 = SR[2];
+        uint8_t &SR6 = SR[3];
+        uint8_t &SR7 = SR[4];
 
         if(nBank == 0)
         {
@@ -214,11 +269,8 @@ namespace smrtobj
         SR6 = SR6 | offTime;
         SR7 = SR7 | sdOffTime;
 
-        RAWRegDrv(FADE_ON_TIME, SR3);
-        RAWRegDrv(FULLY_ON_TIME, SR4);
-        RAWRegDrv(FADE_OFF_TIME, SR5);
-        RAWRegDrv(FIRST_FULLY_OFF_TIME, SR6);
-        RAWRegDrv(SECOND_FULLY_OFF_TIME, SR7);
+        // Registers 3 - 7 in one transfer
+        update(FADE_ON_TIME, SR, 5);
 
       }
     }
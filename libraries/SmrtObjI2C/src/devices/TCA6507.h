@@ -25,6 +25,11 @@ namespace smrtobj
      * The TCA6507 alleviates this issue by limiting the number of operations required by the processor in
      * blinking LEDs and, thus, helps to create a more efficient system.
      *
+     * The driver keeps a copy (shadow) of the eleven registers of the device. The copy is set to the reset
+     * values by smrtobj::i2c::TCA6507::initialize and smrtobj::i2c::TCA6507::stop, or it is loaded from the
+     * device by smrtobj::i2c::TCA6507::read. Registers are read from the copy, and only the registers
+     * changed are written to the device (in one auto-increment transfer).
+     *
      */
     class TCA6507 : public I2CInterface
     {
@@ -32,6 +37,9 @@ namespace smrtobj
         //! Device address used by default
         static const uint8_t DEVICE_ADDRESS = 0x45;
 
+        //! Number of registers
+        static const uint8_t REGISTERS = 11;
+
         /**
          * Command byte for Control Register.
          * Following the successful acknowledgment of the address byte, the bus master sends a command byte,
@@ -238,7 +246,7 @@ namespace smrtobj
         TCA6507 & operator=(const TCA6507 &d);
 
         /**
-         * Starts I2C communications, and puts device in shutdown mode.
+         * Starts I2C communications, and puts device in shutdown mode. Registers are set to their reset values.
          *
          * \return always true
          */
@@ -250,16 +258,17 @@ namespace smrtobj
         void start();
 
         /**
-         *  Resets registers and puts IC in shutdown mode.
+         *  Resets registers (and their copy) and puts IC in shutdown mode.
          */
         void stop();
 
         /**
-         * Reads data from the i2c device. This function is empty and returns always true.
+         * Reads all registers from the i2c device (one auto-increment transfer) and updates their copy.
+         * It is needed only if the registers have been changed without using this object.
          *
          * \return true if no errors
          */
-        virtual bool read() { return true; };
+        virtual bool read();
 
         /**
          * Tests if the device is connected.
@@ -273,6 +282,7 @@ namespace smrtobj
          *  RAW Select Registers Drive for setting all pins at the same time by using auto-increment mode.
          *  Function RAW Select Registers Drive for setting all pins at the same time by using auto-increment
          *  mode. Useful when need switch multiple pins at the same time, can be used for binary.
+         *  Only the registers changed are written.
          *  To use a P port as a general-purpose output, Select1 and Select0 registers must be set low (or 0),
          *  then the inverse of the data written to the Select2 bit appears on the open-drain output.
          *
@@ -326,6 +336,8 @@ namespace smrtobj
          *    - 0x09 : One shot or master intensity register (ONE_SHOT).
          *    - 0x0A : Initialization register.
          *
+         *  The register is written only if the value is changed.
+         *
          *  \param[in] reg register to set
          *  \param[in] val value to write into register
          *
@@ -337,6 +349,7 @@ namespace smrtobj
          * RAW Registry read.
          * Reading entire register (both memory banks) using Read Registry function. Example reads LED
          * fully on time register and returns single value for two memory banks.
+         * The value is read from the copy of the registers (no I2C transfer).
          *
          * \code{.cpp}
          * int x = 0;
@@ -353,7 +366,7 @@ namespace smrtobj
          *
          * \param[in] reg register to read
          *
-         * \return register value
+         * \return register value, 0 if the register is not valid
          */
         uint8_t readReg(uint8_t reg);
 
@@ -398,6 +411,40 @@ namespace smrtobj
          */
         void pinSetState(uint8_t pin, uint8_t state);
 
+        /**
+         * Sets several outputs to the same state with one write of the Select registers, so that all of them
+         * change at the same time. Other outputs are not changed.
+         * Example sets outputs 0, 1 and 2 to blink with bank 0.
+         *
+         * \code{.cpp}
+         * tca6507.pinsSetState(0x07, LED_BLINK_BANK0);
+         * \endcode
+         *
+         * \param[in] mask outputs to change (bit n for output Pn)
+         * \param[in] state new state to set (according to smrtobj::i2c::TCA6507::_register_description)
+         *
+         * \return true for success, or false if any error occurs.
+         */
+        bool pinsSetState(uint8_t mask, uint8_t state);
+
+        /**
+         * Sets the state of all outputs with one write of the Select registers, so that all of them change at
+         * the same time.
+         * Example turns on outputs 0 - 3 and turns off outputs 4 - 6.
+         *
+         * \code{.cpp}
+         * uint8_t states[7] = { LED_ON, LED_ON, LED_ON, LED_ON, LED_OFF, LED_OFF, LED_OFF };
+         *
+         * tca6507.pinsSetState(states);
+         * \endcode
+         *
+         * \param[in] states new state of each output, from P0 to P6 (according to
+         *                   smrtobj::i2c::TCA6507::_register_description)
+         *
+         * \return true for success, or false if any error occurs.
+         */
+        bool pinsSetState(const uint8_t *states);
+
         /**
          * Setups single banks timing parameters using Basic Bank Setup function.
          * Example sets bank 0 timing for flashing or fading.
@@ -427,8 +474,28 @@ namespace smrtobj
         void registryToBank(uint8_t nBank, uint8_t nReg, uint8_t val);
 
       private:
+        /**
+         * Sets the copy of the registers to the reset values of the device.
+         */
+        void defaults();
+
+        /**
+         * Writes consecutive registers. Only the registers from the first to the last changed are written,
+         * in one auto-increment transfer; nothing is written if no register is changed.
+         *
+         * \param[in] reg first register
+         * \param[in] data new values
+         * \param[in] length number of registers
+         *
+         * \return true for success, or false if any error occurs.
+         */
+        bool update(uint8_t reg, const uint8_t *data, uint8_t length);
+
         //! IC reset pin. Reset pin can be any analog or digital pin on Arduino.
         uint8_t m_reset_pin;
+
+        //! Copy of the registers
+        uint8_t m_reg[REGISTERS];
     };
 
   } /* namespace i2c */
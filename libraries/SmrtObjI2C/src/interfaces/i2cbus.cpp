@@ -0,0 +1,26 @@
+/**
+ * \file i2cbus.cpp
+ * \brief  I2CBus is an interface to model the hardware executing the transactions of smrtobj::i2c::I2CQueue.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "interfaces/i2cbus.h"
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    I2CBus::I2CBus()
+    {
+    }
+
+    I2CBus::~I2CBus()
+    {
+    }
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
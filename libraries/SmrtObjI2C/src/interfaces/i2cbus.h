@@ -0,0 +1,66 @@
+/**
+ * \file i2cbus.h
+ * \brief  I2CBus is an interface to model the hardware executing the transactions of smrtobj::i2c::I2CQueue.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef I2CBUS_H_
+#define I2CBUS_H_
+
+#include "interfaces/i2ctransaction.h"
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    /**
+     * The I2CBus class defines the interface between smrtobj::i2c::I2CQueue and the hardware. The queue
+     * gives a transaction at a time to the bus, then it polls the bus until the transaction is completed.
+     * This is a virtual class and defines two virtual method:
+     *   - begin : starts a transaction;
+     *   - poll : advances the transaction started and returns its status.
+     *
+     * Available buses:
+     *   - smrtobj::i2c::TWIBus : AVR TWI peripheral, the transfer runs in background;
+     *   - smrtobj::i2c::WireBus : Wire library, the transfer is completed by begin (blocking);
+     *   - smrtobj::i2c::I2CSimBus : simulated bus with simulated devices, for tests without hardware.
+     */
+    class I2CBus
+    {
+      public:
+        /**
+         * Default Constructor.
+         */
+        I2CBus();
+
+        /**
+         * Destructor.
+         */
+        virtual ~I2CBus();
+
+        /**
+         * Starts a transaction. Buffers of the transaction are used until it is completed.
+         *
+         * \param[in] t transaction
+         *
+         * \return true if the transaction has been started, false otherwise
+         */
+        virtual bool begin(I2CTransaction &t) = 0;
+
+        /**
+         * Advances the transaction started by smrtobj::i2c::I2CBus::begin.
+         *
+         * \return I2CTransaction::RUNNING while the transaction is on the bus, I2CTransaction::DONE or an error
+         *         code (from smrtobj::i2c::I2CTransaction::_status enum) when it is completed
+         */
+        virtual int8_t poll() = 0;
+    };
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
+
+#endif /* I2CBUS_H_ */
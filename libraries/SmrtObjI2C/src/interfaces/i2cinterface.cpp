@@ -6,6 +6,7 @@
  *
  */
 #include "interfaces/i2cinterface.h"
+#include "devices/PCA9548A.h"
 
 namespace smrtobj
 {
@@ -14,13 +15,17 @@ namespace smrtobj
   {
 
     I2CInterface::I2CInterface() :
-        m_device_addr(0)
+        m_device_addr(0),
+        m_mux(0),
+        m_channel(0)
     {
       m_type = TYPE_BIDIRECTIONAL;
     }
 
     I2CInterface::I2CInterface(uint8_t addr) :
-        m_device_addr(addr)
+        m_device_addr(addr),
+        m_mux(0),
+        m_channel(0)
     {
       m_type = TYPE_BIDIRECTIONAL;
     }
@@ -29,6 +34,8 @@ namespace smrtobj
     {
       m_type = d.m_type;
       m_device_addr = d.m_device_addr;
+      m_mux = d.m_mux;
+      m_channel = d.m_channel;
     }
 
     I2CInterface::~I2CInterface()
@@ -40,10 +47,61 @@ namespace smrtobj
       Signal::operator=(d);
       m_type = d.m_type;
       m_device_addr = d.m_device_addr;
+      m_mux = d.m_mux;
+      m_channel = d.m_channel;
 
       return (*this);
     }
 
+    bool I2CInterface::setPath(PCA9548A *mux, uint8_t channel)
+    {
+      if (channel > 7)
+      {
+        return false;
+      }
+
+      m_mux = mux;
+      m_channel = channel;
+
+      return true;
+    }
+
+    bool I2CInterface::route()
+    {
+      if (!m_mux)
+      {
+        return true;
+      }
+
+      return m_mux->select(m_channel);
+    }
+
+    bool I2CInterface::submit(I2CTransaction &t)
+    {
+      if ( !t.setPath(m_mux, m_channel) )
+      {
+        return false;
+      }
+
+      return I2CQueue::submit(t);
+    }
+
+    int8_t I2CInterface::acquisition(int8_t status)
+    {
+      switch (status)
+      {
+        case I2CTransaction::DONE:
+          return smrtobj::io::Sensor::ACQUISITION_DONE;
+
+        case I2CTransaction::QUEUED:
+        case I2CTransaction::RUNNING:
+          return smrtobj::io::Sensor::ACQUISITION_PENDING;
+
+        default:
+          return smrtobj::io::Sensor::ACQUISITION_ERROR;
+      }
+    }
+
     int8_t I2CInterface::readAllBytes(uint8_t devAddr, uint8_t length,
         uint8_t *data, uint16_t timeout)
     {
@@ -56,6 +114,12 @@ namespace smrtobj
       #endif
 
       uint8_t count = 0;
+
+      if ( !route() )
+      {
+        return count;
+      }
+
       uint32_t t1 = millis();
 
       Wire.beginTransmission(devAddr);
@@ -133,6 +197,11 @@ namespace smrtobj
 
       uint8_t status = 0;
 
+      if ( !route() )
+      {
+        return false;
+      }
+
       Wire.beginTransmission(devAddr);
 
       for (uint8_t i = 0; i < length; i++)
@@ -159,6 +228,47 @@ namespace smrtobj
       return status == 0;
     }
 
+    int8_t I2CInterface::readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t timeout)
+    {
+      if ( !route() )
+      {
+        return 0;
+      }
+
+      return I2Cdev::readByte(devAddr, regAddr, data, timeout);
+    }
+
+    int8_t I2CInterface::readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data,
+        uint16_t timeout)
+    {
+      if ( !route() )
+      {
+        return 0;
+      }
+
+      return I2Cdev::readBytes(devAddr, regAddr, length, data, timeout);
+    }
+
+    bool I2CInterface::writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data)
+    {
+      if ( !route() )
+      {
+        return false;
+      }
+
+      return I2Cdev::writeByte(devAddr, regAddr, data);
+    }
+
+    bool I2CInterface::writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data)
+    {
+      if ( !route() )
+      {
+        return false;
+      }
+
+      return I2Cdev::writeBytes(devAddr, regAddr, length, data);
+    }
+
     bool I2CInterface::read_word(uint16_t &value, bool MSB)
     {
       uint8_t buffer[2] =
@@ -18,6 +18,7 @@
 
 #include <smrtobjio.h>
 #include <I2Cdev.h>
+#include "interfaces/i2cqueue.h"
 
 namespace smrtobj
 {
@@ -25,6 +26,8 @@ namespace smrtobj
   namespace i2c
   {
 
+    class PCA9548A;
+
     /**
      * The I2CInterface class defines the standard interface of an I2C device sensor. An I2C device is identified by
      * a address of one byte.  This is a virtual class and defines four virtual method:
@@ -33,6 +36,13 @@ namespace smrtobj
      *   - read : read values from device
      *   - measure : calculate a measure or specific value from the all data read.
      *
+     * A device connected to a channel of a multiplexer (smrtobj::i2c::PCA9548A) is registered with its path
+     * (smrtobj::i2c::I2CInterface::setPath): the channel is selected before each transfer, and the multiplexer
+     * is written only when the selected channel changes. Drivers must access the device through the transfer
+     * functions of this class (readAllBytes, writeAllBytes, readByte, readBytes, writeByte, writeBytes) or
+     * the queue (smrtobj::i2c::I2CInterface::submit), never calling I2Cdev directly, so that the path is
+     * applied.
+     *
      */
     class I2CInterface : public smrtobj::io::Signal
     {
@@ -79,6 +89,31 @@ namespace smrtobj
          * \return type of the interface
          */
         byte type() {return m_type; }
+
+        /**
+         * Sets the multiplexer channel the device is connected to. The channel is selected before every
+         * transfer of the driver with the device.
+         *
+         * \param[in] mux multiplexer, 0 if the device is connected directly to the bus
+         * \param[in] channel channel of the multiplexer (0 - 7)
+         *
+         * \return false if the channel is not valid, true otherwise
+         */
+        bool setPath(PCA9548A *mux, uint8_t channel = 0);
+
+        /**
+         * Gets the multiplexer the device is connected to.
+         *
+         * \return multiplexer, 0 if the device is connected directly to the bus
+         */
+        PCA9548A* mux() { return m_mux; }
+
+        /**
+         * Gets the channel of the multiplexer the device is connected to.
+         *
+         * \return channel
+         */
+        uint8_t channel() { return m_channel; }
   
         /**
          * Override operator =
@@ -142,6 +177,34 @@ namespace smrtobj
           m_device_addr = addr;
         }
   
+        /**
+         * Selects the channel of the multiplexer the device is connected to. It is called before each
+         * transfer and it does nothing if the device is connected directly to the bus or the channel
+         * is already selected.
+         *
+         * \return false in case of errors, true otherwise
+         */
+        bool route();
+
+        /**
+         * Submits a transaction to smrtobj::i2c::I2CQueue, with the path of the device.
+         *
+         * \param[in] t transaction
+         *
+         * \return false if the transaction is already pending, true otherwise
+         */
+        bool submit(I2CTransaction &t);
+
+        /**
+         * Converts the status of a transaction in the status of an acquisition, for sensors read in
+         * background (see smrtobj::io::Sensor::pollAcquisition).
+         *
+         * \param[in] status status according to smrtobj::i2c::I2CTransaction::_status enum
+         *
+         * \return status according to smrtobj::io::Sensor::_acquisition enum
+         */
+        static int8_t acquisition(int8_t status);
+
         /** Reads a word (2 byte) from i2c device.
          *
          * \param[out] value data read
@@ -180,10 +243,69 @@ namespace smrtobj
          * \return false in case of errors, true otherwise
          */
         bool writeAllBytes(uint8_t devAddr, uint8_t length, uint8_t *data, uint16_t timeout=I2Cdev::readTimeout);
+
+        /**
+         * Reads a register of the device with I2Cdev::readByte, after selecting the channel of the
+         * multiplexer (see smrtobj::i2c::I2CInterface::route).
+         *
+         * \param[in] devAddr Address of the slave device to read from
+         * \param[in] regAddr Register to read
+         * \param[out] data Buffer to store read data in
+         * \param[in] timeout Optional read timeout in milliseconds (0 to disable)
+         *
+         * \return Number of bytes read (0 or -1 indicate failure)
+         */
+        int8_t readByte(uint8_t devAddr, uint8_t regAddr, uint8_t *data, uint16_t timeout=I2Cdev::readTimeout);
+
+        /**
+         * Reads consecutive registers of the device with I2Cdev::readBytes, after selecting the channel of
+         * the multiplexer.
+         *
+         * \param[in] devAddr Address of the slave device to read from
+         * \param[in] regAddr First register to read
+         * \param[in] length Number of bytes to read
+         * \param[out] data Buffer to store read data in
+         * \param[in] timeout Optional read timeout in milliseconds (0 to disable)
+         *
+         * \return Number of bytes read (0 or -1 indicate failure)
+         */
+        int8_t readBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data,
+            uint16_t timeout=I2Cdev::readTimeout);
+
+        /**
+         * Writes a register of the device with I2Cdev::writeByte, after selecting the channel of the
+         * multiplexer.
+         *
+         * \param[in] devAddr Address of the slave device to write to
+         * \param[in] regAddr Register to write
+         * \param[in] data Value to write
+         *
+         * \return false in case of errors, true otherwise
+         */
+        bool writeByte(uint8_t devAddr, uint8_t regAddr, uint8_t data);
+
+        /**
+         * Writes consecutive registers of the device with I2Cdev::writeBytes, after selecting the channel
+         * of the multiplexer.
+         *
+         * \param[in] devAddr Address of the slave device to write to
+         * \param[in] regAddr First register to write
+         * \param[in] length Number of bytes to write
+         * \param[in] data Buffer with data to write
+         *
+         * \return false in case of errors, true otherwise
+         */
+        bool writeBytes(uint8_t devAddr, uint8_t regAddr, uint8_t length, uint8_t *data);
   
       private:
         // Device address
         uint8_t m_device_addr;
+
+        //! Multiplexer
+        PCA9548A *m_mux;
+
+        //! Channel of the multiplexer
+        uint8_t m_channel;
     };
   
   } /* namespace i2c */
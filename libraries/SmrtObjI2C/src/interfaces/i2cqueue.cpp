@@ -0,0 +1,181 @@
+/**
+ * \file i2cqueue.cpp
+ * \brief  I2CQueue executes I2C transactions in background, one at a time, in the order they are submitted.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "interfaces/i2cqueue.h"
+#include "bus/twibus.h"
+#include "bus/wirebus.h"
+#include "devices/PCA9548A.h"
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    I2CBus* I2CQueue::m_bus = 0;
+    I2CTransaction* I2CQueue::m_head = 0;
+    I2CTransaction* I2CQueue::m_tail = 0;
+    I2CTransaction I2CQueue::m_route;
+    uint8_t I2CQueue::m_select = 0;
+
+    bool I2CQueue::setBus(I2CBus &bus)
+    {
+      if (m_head)
+      {
+        return false;
+      }
+
+      m_bus = &bus;
+
+      return true;
+    }
+
+    I2CBus& I2CQueue::bus()
+    {
+      if (!m_bus)
+      {
+#if defined(TWCR)
+        static TWIBus twi;
+        m_bus = &twi;
+#else
+        static WireBus wire;
+        m_bus = &wire;
+#endif
+      }
+
+      return (*m_bus);
+    }
+
+    bool I2CQueue::submit(I2CTransaction &t)
+    {
+      if ( t.isPending() )
+      {
+        return false;
+      }
+
+      t.m_status = I2CTransaction::QUEUED;
+      t.m_next = 0;
+
+      if (m_tail)
+      {
+        m_tail->m_next = &t;
+        m_tail = &t;
+
+        return true;
+      }
+
+      m_head = &t;
+      m_tail = &t;
+      start();
+
+      return true;
+    }
+
+    void I2CQueue::start()
+    {
+      while (m_head && m_head->m_status == I2CTransaction::QUEUED)
+      {
+        route();
+
+        m_head->m_status = I2CTransaction::RUNNING;
+
+        if ( bus().begin(*m_head) )
+        {
+          return;
+        }
+
+        complete(I2CTransaction::ERROR_BUS);
+      }
+    }
+
+    void I2CQueue::route()
+    {
+      I2CTransaction *t = m_head;
+
+      if ( t == &m_route || !t->m_mux || t->m_mux->isSelected(t->m_channel) )
+      {
+        return;
+      }
+
+      m_select = 1 << t->m_channel;
+      m_route.set(t->m_mux->address(), &m_select, 1);
+
+      m_route.m_status = I2CTransaction::QUEUED;
+      m_route.m_next = t;
+      m_head = &m_route;
+    }
+
+    void I2CQueue::complete(int8_t status)
+    {
+      I2CTransaction *t = m_head;
+
+      m_head = t->m_next;
+      if (!m_head)
+      {
+        m_tail = 0;
+      }
+
+      t->m_next = 0;
+      t->m_status = status;
+
+      if (t == &m_route)
+      {
+        // The routed transaction is now at the head of the queue
+        PCA9548A *mux = m_head->m_mux;
+
+        if (status == I2CTransaction::DONE)
+        {
+          mux->m_ctrl_reg = m_select;
+          mux->m_cached = true;
+        }
+        else
+        {
+          mux->m_cached = false;
+          complete(status);
+        }
+
+        return;
+      }
+
+      // The callback can submit new transactions
+      if (t->m_callback)
+      {
+        t->m_callback(*t);
+      }
+    }
+
+    void I2CQueue::poll()
+    {
+      if (!m_head)
+      {
+        return;
+      }
+
+      int8_t status = bus().poll();
+
+      if (status == I2CTransaction::RUNNING)
+      {
+        return;
+      }
+
+      complete(status);
+      start();
+    }
+
+    bool I2CQueue::wait(I2CTransaction &t)
+    {
+      while ( t.isPending() )
+      {
+        poll();
+      }
+
+      return (t.status() == I2CTransaction::DONE);
+    }
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
@@ -0,0 +1,146 @@
+/**
+ * \file i2cqueue.h
+ * \brief  I2CQueue executes I2C transactions in background, one at a time, in the order they are submitted.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef I2CQUEUE_H_
+#define I2CQUEUE_H_
+
+#include "interfaces/i2ctransaction.h"
+#include "interfaces/i2cbus.h"
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    /**
+     * The I2CQueue class executes I2C transactions without blocking the main loop. Drivers submit
+     * transactions (smrtobj::i2c::I2CTransaction) and the queue gives them to the bus one at a time;
+     * the main loop calls smrtobj::i2c::I2CQueue::poll to advance the transfers and to complete them.
+     *
+     * The queue does not copy nor allocate anything: submitted transactions are linked in a list and they
+     * must exist until they are completed. A transaction is completed when its status is
+     * smrtobj::i2c::I2CTransaction::DONE or an error; then its callback (if any) is called by
+     * smrtobj::i2c::I2CQueue::poll.
+     *
+     * Transactions with a path (see smrtobj::i2c::I2CTransaction::setPath) are routed: if the channel is not
+     * already selected, the queue writes the multiplexer control register (one byte) just before the
+     * transaction. If the multiplexer does not answer, the transaction is completed with the same error.
+     * Only one level of multiplexers is supported.
+     *
+     * The bus is smrtobj::i2c::TWIBus on AVR boards and smrtobj::i2c::WireBus on the others; it can be
+     * changed with smrtobj::i2c::I2CQueue::setBus (e.g. to use smrtobj::i2c::I2CSimBus in tests).
+     *
+     * \code{.cpp}
+     * smrtobj::i2c::IAQ2000 voc;
+     *
+     * voc.begin();
+     *
+     * void loop()
+     * {
+     *   smrtobj::i2c::I2CQueue::poll();
+     *
+     *   if ( voc.poll() == smrtobj::i2c::I2CTransaction::DONE )
+     *   {
+     *     Serial.println( voc.value() );
+     *     voc.begin();
+     *   }
+     *   ...
+     * }
+     * \endcode
+     */
+    class I2CQueue
+    {
+      public:
+        /**
+         * Sets the bus used to execute the transactions. It must be called when the queue is empty.
+         *
+         * \param[in] bus bus
+         *
+         * \return false if there are pending transactions, true otherwise
+         */
+        static bool setBus(I2CBus &bus);
+
+        /**
+         * Gets the bus used to execute the transactions.
+         *
+         * \return bus
+         */
+        static I2CBus& bus();
+
+        /**
+         * Adds a transaction at the end of the queue. If the queue was empty, the transaction is started.
+         *
+         * \param[in] t transaction
+         *
+         * \return false if the transaction is already pending, true otherwise
+         */
+        static bool submit(I2CTransaction &t);
+
+        /**
+         * Advances the transaction on the bus. When it is completed, its callback is called and the
+         * next transaction is started. It has to be called in the main loop, as often as possible.
+         */
+        static void poll();
+
+        /**
+         * Waits for the end of a transaction, polling the queue.
+         *
+         * \param[in] t transaction
+         *
+         * \return true if the transaction has been completed successfully, false otherwise
+         */
+        static bool wait(I2CTransaction &t);
+
+        /**
+         * Checks if the queue is empty.
+         *
+         * \return true if there are no pending transactions, false otherwise
+         */
+        static bool isIdle() { return (m_head == 0); }
+
+      private:
+        /**
+         * Starts the transactions at the head of the queue. Transactions not accepted by the bus are
+         * completed with an error.
+         */
+        static void start();
+
+        /**
+         * Puts the routing transaction at the head of the queue, if the transaction at the head is behind a
+         * multiplexer and its channel is not selected.
+         */
+        static void route();
+
+        /**
+         * Removes the transaction at the head of the queue and calls its callback.
+         *
+         * \param[in] status final status of the transaction
+         */
+        static void complete(int8_t status);
+
+        //! Bus
+        static I2CBus *m_bus;
+
+        //! Transaction on the bus
+        static I2CTransaction *m_head;
+
+        //! Last transaction of the queue
+        static I2CTransaction *m_tail;
+
+        //! Transaction selecting the channel of a multiplexer
+        static I2CTransaction m_route;
+
+        //! Control register written by the routing transaction
+        static uint8_t m_select;
+    };
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
+
+#endif /* I2CQUEUE_H_ */
@@ -0,0 +1,174 @@
+/**
+ * \file i2cregister.h
+ * \brief Templates to describe the fields of the data read from or written to an i2c device, and to
+ *        pack and unpack them without loops.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef I2CREGISTER_H_
+#define I2CREGISTER_H_
+
+#if ARDUINO >= 100
+#include "Arduino.h"       // for delayMicroseconds, digitalPinToBitMask, etc
+#else
+#include "WProgram.h"      // for delayMicroseconds
+#include "pins_arduino.h"  // for digitalPinToBitMask, etc
+#endif
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    /**
+     * Smallest unsigned type holding N bytes (1 - 4).
+     */
+    template <uint8_t N>
+    struct RegisterType
+    {
+      typedef uint32_t type;
+    };
+
+    //! 1 byte
+    template <>
+    struct RegisterType<1>
+    {
+      typedef uint8_t type;
+    };
+
+    //! 2 bytes
+    template <>
+    struct RegisterType<2>
+    {
+      typedef uint16_t type;
+    };
+
+    /**
+     * N consecutive bytes of a buffer, starting at OFFSET, read and written as a number. If MSB is true
+     * the first byte is the most significant one (big endian), otherwise it is the least significant one.
+     *
+     * The bytes are expanded at compile time: every access is a fixed sequence of loads and shifts.
+     */
+    template <uint8_t OFFSET, uint8_t N, bool MSB = true>
+    struct RegisterBytes
+    {
+      //! Type of the number
+      typedef typename RegisterType<N>::type type;
+
+      //! Bytes before the last one
+      typedef RegisterBytes<(MSB ? OFFSET : OFFSET + 1), N - 1, MSB> head;
+
+      //! Position of the least significant byte
+      static const uint8_t LSB_INDEX = MSB ? OFFSET + N - 1 : OFFSET;
+
+      /**
+       * Reads the number.
+       *
+       * \param[in] buf buffer
+       *
+       * \return number
+       */
+      static type get(const uint8_t *buf)
+      {
+        return ((type) head::get(buf) << 8) | buf[LSB_INDEX];
+      }
+
+      /**
+       * Writes the number.
+       *
+       * \param[out] buf buffer
+       * \param[in] value number
+       */
+      static void set(uint8_t *buf, type value)
+      {
+        buf[LSB_INDEX] = (uint8_t) value;
+        head::set(buf, (typename head::type) (value >> 8));
+      }
+    };
+
+    //! Single byte
+    template <uint8_t OFFSET, bool MSB>
+    struct RegisterBytes<OFFSET, 1, MSB>
+    {
+      typedef uint8_t type;
+
+      static type get(const uint8_t *buf) { return buf[OFFSET]; }
+
+      static void set(uint8_t *buf, type value) { buf[OFFSET] = value; }
+    };
+
+    /**
+     * Field of the data of an i2c device: BITS bits starting at bit SHIFT of the number stored in N bytes
+     * at OFFSET (see smrtobj::i2c::RegisterBytes). By default the field is the whole number.
+     *
+     * A driver declares the layout of its buffer once, as a list of fields, instead of decoding it by hand:
+     *
+     * \code{.cpp}
+     * // HIH7121: status (2 bits), humidity (14 bits), temperature (14 bits, left aligned)
+     * typedef smrtobj::i2c::RegisterField<0, 1, true, 6, 2> Status;
+     * typedef smrtobj::i2c::RegisterField<0, 2, true, 0, 14> Humidity;
+     * typedef smrtobj::i2c::RegisterField<2, 2, true, 2, 14> Temperature;
+     *
+     * m_status = Status::get(buf);
+     * m_humidity = Humidity::get(buf);
+     * m_temperature = Temperature::get(buf);
+     * \endcode
+     *
+     * All the parameters are constants, so the compiler reduces every access to a few shifts and masks,
+     * without loops nor branches.
+     */
+    template <uint8_t OFFSET, uint8_t N, bool MSB = true, uint8_t SHIFT = 0, uint8_t BITS = N * 8 - SHIFT>
+    struct RegisterField
+    {
+      //! Bytes holding the field
+      typedef RegisterBytes<OFFSET, N, MSB> bytes;
+
+      //! Type of the field
+      typedef typename bytes::type type;
+
+      //! Mask of the field, after the shift
+      static const type MASK = (type) (0xFFFFFFFFUL >> (32 - BITS));
+
+      //! Size of the buffer needed to hold the field
+      static const uint8_t END = OFFSET + N;
+
+      /**
+       * Reads the field.
+       *
+       * \param[in] buf buffer
+       *
+       * \return value of the field
+       */
+      static type get(const uint8_t *buf)
+      {
+        return (bytes::get(buf) >> SHIFT) & MASK;
+      }
+
+      /**
+       * Writes the field. The other bits of its bytes are not changed.
+       *
+       * \param[in,out] buf buffer
+       * \param[in] value value of the field
+       */
+      static void set(uint8_t *buf, type value)
+      {
+        if (SHIFT == 0 && BITS == N * 8)
+        {
+          bytes::set(buf, value);
+        }
+        else
+        {
+          type mask = (type) (MASK << SHIFT);
+
+          bytes::set(buf, (bytes::get(buf) & ~mask) | ((type) (value << SHIFT) & mask));
+        }
+      }
+    };
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
+
+#endif /* I2CREGISTER_H_ */
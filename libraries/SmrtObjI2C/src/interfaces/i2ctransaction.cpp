@@ -0,0 +1,96 @@
+/**
+ * \file i2ctransaction.cpp
+ * \brief  I2CTransaction models an I2C transfer (write, read or write followed by read) executed in
+ *         background by smrtobj::i2c::I2CQueue.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "interfaces/i2ctransaction.h"
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    I2CTransaction::I2CTransaction() :
+        m_addr(0),
+        m_wdata(0),
+        m_wlen(0),
+        m_rdata(0),
+        m_rlen(0),
+        m_status(IDLE),
+        m_callback(0),
+        m_context(0),
+        m_mux(0),
+        m_channel(0),
+        m_next(0)
+    {
+    }
+
+    I2CTransaction::I2CTransaction(const I2CTransaction &t) :
+        m_status(IDLE),
+        m_next(0)
+    {
+      (*this) = t;
+    }
+
+    I2CTransaction::~I2CTransaction()
+    {
+    }
+
+    I2CTransaction & I2CTransaction::operator=(const I2CTransaction &t)
+    {
+      m_addr = t.m_addr;
+      m_wdata = t.m_wdata;
+      m_wlen = t.m_wlen;
+      m_rdata = t.m_rdata;
+      m_rlen = t.m_rlen;
+      m_callback = t.m_callback;
+      m_context = t.m_context;
+      m_mux = t.m_mux;
+      m_channel = t.m_channel;
+
+      return (*this);
+    }
+
+    bool I2CTransaction::set(uint8_t addr, const uint8_t *wdata, uint8_t wlen, uint8_t *rdata, uint8_t rlen)
+    {
+      if ( isPending() )
+      {
+        return false;
+      }
+
+      m_addr = addr;
+      m_wdata = wdata;
+      m_wlen = (wdata) ? wlen : 0;
+      m_rdata = rdata;
+      m_rlen = (rdata) ? rlen : 0;
+      m_status = IDLE;
+
+      return true;
+    }
+
+    void I2CTransaction::setCallback(callback_t callback, void *context)
+    {
+      m_callback = callback;
+      m_context = context;
+    }
+
+    bool I2CTransaction::setPath(PCA9548A *mux, uint8_t channel)
+    {
+      if ( isPending() || channel > 7 )
+      {
+        return false;
+      }
+
+      m_mux = mux;
+      m_channel = channel;
+
+      return true;
+    }
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
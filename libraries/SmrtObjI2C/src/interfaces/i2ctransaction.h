@@ -0,0 +1,271 @@
+/**
+ * \file i2ctransaction.h
+ * \brief  I2CTransaction models an I2C transfer (write, read or write followed by read) executed in
+ *         background by smrtobj::i2c::I2CQueue.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef I2CTRANSACTION_H_
+#define I2CTRANSACTION_H_
+
+#if ARDUINO >= 100
+#include "Arduino.h"       // for delayMicroseconds, digitalPinToBitMask, etc
+#else
+#include "WProgram.h"      // for delayMicroseconds
+#include "pins_arduino.h"  // for digitalPinToBitMask, etc
+#endif
+
+namespace smrtobj
+{
+
+  namespace i2c
+  {
+
+    class I2CQueue;
+    class PCA9548A;
+
+    /**
+     * The I2CTransaction class describes an I2C transfer with a slave device:
+     *   - write: \e wlen bytes are written and the read length is 0;
+     *   - read: \e rlen bytes are read and the write length is 0;
+     *   - write then read: \e wlen bytes are written, then \e rlen bytes are read after a repeated start
+     *     (e.g. to set a register pointer and read the register).
+     *
+     * A transaction with no bytes to write and read only addresses the device (e.g. to check if it is
+     * connected).
+     *
+     * Buffers are not copied: they must exist until the transaction is completed. The transaction itself
+     * is the handle to poll its status; it is also possible to set a function called when it is completed.
+     *
+     * If the device is connected behind a multiplexer (smrtobj::i2c::PCA9548A), the path (multiplexer and
+     * channel) is set with smrtobj::i2c::I2CTransaction::setPath: the queue selects the channel before the
+     * transaction, writing the multiplexer only if the channel is not already selected.
+     *
+     * \code{.cpp}
+     * uint8_t reg = 0x00;
+     * uint8_t data[2];
+     * smrtobj::i2c::I2CTransaction t;
+     *
+     * t.set(0x48, &reg, 1, data, 2);
+     * smrtobj::i2c::I2CQueue::submit(t);
+     * ...
+     * if ( t.status() == smrtobj::i2c::I2CTransaction::DONE )
+     * {
+     *   ...
+     * }
+     * \endcode
+     */
+    class I2CTransaction
+    {
+      public:
+        /**
+         * Status of the transaction
+         */
+        enum _status
+        {
+          //! Never submitted
+          IDLE = 0,
+
+          //! Waiting in the queue
+          QUEUED = 1,
+
+          //! On the bus
+          RUNNING = 2,
+
+          //! Completed successfully
+          DONE = 3,
+
+          //! Address not acknowledged (device not connected)
+          ERROR_ADDRESS = -1,
+
+          //! Data not acknowledged or not received
+          ERROR_DATA = -2,
+
+          //! Bus error or arbitration lost
+          ERROR_BUS = -3,
+
+          //! Transaction not completed in time
+          ERROR_TIMEOUT = -4,
+        };
+
+        /**
+         * Function called when a transaction is completed (successfully or not).
+         *
+         * \param[in] t transaction completed
+         */
+        typedef void (*callback_t)(I2CTransaction &t);
+
+        /**
+         * Default Constructor.
+         * It creates an empty transaction.
+         */
+        I2CTransaction();
+
+        /**
+         * Copy Constructor. The status is not copied.
+         *
+         * \param[in] t source transaction
+         */
+        I2CTransaction(const I2CTransaction &t);
+
+        /**
+         * Destructor.
+         */
+        virtual ~I2CTransaction();
+
+        /**
+         * Override operator = . The status is not copied.
+         *
+         * \param[in] t source transaction
+         *
+         * \return reference to the destination transaction
+         */
+        I2CTransaction & operator=(const I2CTransaction &t);
+
+        /**
+         * Sets the transfer. It must not be called while the transaction is pending.
+         *
+         * \param[in] addr device address
+         * \param[in] wdata data to write
+         * \param[in] wlen number of bytes to write
+         * \param[out] rdata buffer for data read
+         * \param[in] rlen number of bytes to read
+         *
+         * \return false if the transaction is pending, true otherwise
+         */
+        bool set(uint8_t addr, const uint8_t *wdata, uint8_t wlen, uint8_t *rdata = 0, uint8_t rlen = 0);
+
+        /**
+         * Sets the function called when the transaction is completed. The function is called by
+         * smrtobj::i2c::I2CQueue::poll (not by an interrupt).
+         *
+         * \param[in] callback function, 0 to remove it
+         * \param[in] context user data available with smrtobj::i2c::I2CTransaction::context
+         */
+        void setCallback(callback_t callback, void *context = 0);
+
+        /**
+         * Sets the multiplexer channel the device is connected to. The path is kept by
+         * smrtobj::i2c::I2CTransaction::set. It must not be called while the transaction is pending.
+         *
+         * \param[in] mux multiplexer, 0 if the device is connected directly to the bus
+         * \param[in] channel channel of the multiplexer (0 - 7)
+         *
+         * \return false if the transaction is pending or the channel is not valid, true otherwise
+         */
+        bool setPath(PCA9548A *mux, uint8_t channel = 0);
+
+        /**
+         * Gets the multiplexer the device is connected to.
+         *
+         * \return multiplexer, 0 if the device is connected directly to the bus
+         */
+        PCA9548A* mux() const { return m_mux; }
+
+        /**
+         * Gets the channel of the multiplexer the device is connected to.
+         *
+         * \return channel
+         */
+        uint8_t channel() const { return m_channel; }
+
+        /**
+         * Gets the status of the transaction.
+         *
+         * \return status according to smrtobj::i2c::I2CTransaction::_status enum
+         */
+        int8_t status() const { return m_status; }
+
+        /**
+         * Checks if the transaction is waiting or running.
+         *
+         * \return true if it is pending, false otherwise
+         */
+        bool isPending() const { return (m_status == QUEUED || m_status == RUNNING); }
+
+        /**
+         * Gets the device address.
+         *
+         * \return device address
+         */
+        uint8_t address() const { return m_addr; }
+
+        /**
+         * Gets the data to write.
+         *
+         * \return data to write
+         */
+        const uint8_t* writeData() const { return m_wdata; }
+
+        /**
+         * Gets the number of bytes to write.
+         *
+         * \return number of bytes to write
+         */
+        uint8_t writeLength() const { return m_wlen; }
+
+        /**
+         * Gets the buffer for data read.
+         *
+         * \return buffer for data read
+         */
+        uint8_t* readData() const { return m_rdata; }
+
+        /**
+         * Gets the number of bytes to read.
+         *
+         * \return number of bytes to read
+         */
+        uint8_t readLength() const { return m_rlen; }
+
+        /**
+         * Gets the user data set with the callback.
+         *
+         * \return user data
+         */
+        void* context() const { return m_context; }
+
+      private:
+        //! The queue changes status and links transactions
+        friend class I2CQueue;
+
+        //! Device address
+        uint8_t m_addr;
+
+        //! Data to write
+        const uint8_t *m_wdata;
+
+        //! Number of bytes to write
+        uint8_t m_wlen;
+
+        //! Buffer for data read
+        uint8_t *m_rdata;
+
+        //! Number of bytes to read
+        uint8_t m_rlen;
+
+        //! Status
+        int8_t m_status;
+
+        //! Function called at the end of the transaction
+        callback_t m_callback;
+
+        //! User data
+        void *m_context;
+
+        //! Multiplexer
+        PCA9548A *m_mux;
+
+        //! Channel of the multiplexer
+        uint8_t m_channel;
+
+        //! Next transaction in the queue
+        I2CTransaction *m_next;
+    };
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
+
+#endif /* I2CTRANSACTION_H_ */
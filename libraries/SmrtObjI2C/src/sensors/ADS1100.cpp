@@ -75,7 +75,7 @@ namespace smrtobj
       float voltage = m_value * m_vref;
       voltage = voltage / 32768.0;
 
-      return (float) voltage;
+      return calibrate(voltage);
     }
   
   } /* namespace i2c */
@@ -120,6 +120,21 @@ namespace smrtobj
          * \return last data read as voltage level.
          */
         virtual float measure();
+
+        /**
+         * Starts the acquisition: the device is read at once (see smrtobj::i2c::ADS1100::read).
+         *
+         * \return true for success, or false if any error occurs
+         */
+        virtual bool startAcquisition() { return read(); }
+
+        /**
+         * Gets the time to wait after power on: the device converts continuously at the data rate of its
+         * configuration and the first result is ready after a conversion period.
+         *
+         * \return warm up time (in milliseconds)
+         */
+        virtual unsigned long warmup() { return 1000UL / DATA_RATE; }
   
         /**
          * Returns last ADC value read. Example:
@@ -143,6 +158,9 @@ namespace smrtobj
         uint16_t value() { return m_value; }
   
       private:
+        //! Data rate (in samples per second) at power on: the configuration register is not written
+        static const uint8_t DATA_RATE = 8;
+
         //! Last value read
         uint16_t m_value;
 
@@ -65,55 +65,49 @@ namespace smrtobj
 
     bool HIH7121::read()
     {
-      uint8_t buf[4] = {0};
+      uint8_t buf[DATA_LENGTH] = {0};
 
-      if ( readAllBytes(address(), 4, buf, 0) != 4 )
+      if ( readAllBytes(address(), DATA_LENGTH, buf, 0) != DATA_LENGTH )
         return false;
 
-      bool valid = true;
+      decode(buf);
 
-      for (uint8_t index = 0; index < 4; index++)
-      {
-
-        switch (index)
-        {
-          case 0 : {
-            uint8_t m_status = buf[index] >> 6;
-            m_status &=0x03;
-
-            m_humidity = buf[index];
-            m_humidity &=0x3F;
-            m_humidity <<=8;
-            m_humidity &= 0xFF00;
-          } break;
+      return true;
+    }
 
-          case 1 : {
-            m_humidity |= buf[index];
+    bool HIH7121::begin()
+    {
+      if ( !m_transaction.set(address(), 0, 0, m_buffer, DATA_LENGTH) )
+      {
+        return false;
+      }
 
-          } break;
+      m_transaction.setCallback(completed, this);
 
-          case 2 : {
-            m_temperature = buf[index];
-            m_temperature <<=8;
-            m_temperature &= 0xFF00;
-          } break;
+      return submit(m_transaction);
+    }
 
-          case 3 : {
-            m_temperature |= buf[index];
-            m_temperature >>= 2;
-            m_temperature &= 0x3FFF;
+    int8_t HIH7121::poll()
+    {
+      I2CQueue::poll();
 
-          } break;
+      return m_transaction.status();
+    }
 
-          default :
-           valid = false;
-        }
+    void HIH7121::completed(I2CTransaction &t)
+    {
+      if ( t.status() == I2CTransaction::DONE )
+      {
+        HIH7121 *s = (HIH7121*) t.context();
+        s->decode(s->m_buffer);
       }
+    }
 
-      if ( !valid )
-        return false;
-
-      return true;
+    void HIH7121::decode(const uint8_t *buf)
+    {
+      m_status = Status::get(buf);
+      m_humidity = Humidity::get(buf);
+      m_temperature = Temperature::get(buf);
     }
 
     uint8_t HIH7121::status()
@@ -142,7 +136,7 @@ namespace smrtobj
 
     float HIH7121::measure()
     {
-      return humidity();
+      return calibrate( humidity() );
     }
   } /* namespace i2c */
 
@@ -10,6 +10,8 @@
 #define HIH7121_H_
 
 #include <interfaces/i2cinterface.h>
+#include <interfaces/i2cqueue.h>
+#include <interfaces/i2cregister.h>
 
 namespace smrtobj
 {
@@ -104,6 +106,22 @@ namespace smrtobj
          */
         virtual bool read();
 
+        /**
+         * Starts reading data from the i2c device in background (see smrtobj::i2c::I2CQueue). Data are
+         * decoded as in smrtobj::i2c::HIH7121::read when the transaction is completed.
+         *
+         * \return true if the reading has been started, false if a reading is already pending
+         */
+        bool begin();
+
+        /**
+         * Advances the I2C queue and returns the status of the reading started by smrtobj::i2c::HIH7121::begin.
+         *
+         * \return I2CTransaction::DONE when new data are available, I2CTransaction::QUEUED or I2CTransaction::RUNNING
+         *         while the reading is pending, an error code (from smrtobj::i2c::I2CTransaction::_status enum) otherwise
+         */
+        int8_t poll();
+
         /**
          * Returns relative humidity measurement.
          *
@@ -111,6 +129,36 @@ namespace smrtobj
          */
         virtual float measure();
 
+        /**
+         * Starts the acquisition in background (see smrtobj::i2c::HIH7121::begin).
+         *
+         * \return true if the reading has been started, false if a reading is already pending
+         */
+        virtual bool startAcquisition() { return begin(); }
+
+        /**
+         * Checks the acquisition started by smrtobj::i2c::HIH7121::startAcquisition, advancing the I2C queue.
+         *
+         * \return status according to smrtobj::io::Sensor::_acquisition enum
+         */
+        virtual int8_t pollAcquisition() { return acquisition(poll()); }
+
+        /**
+         * Gets the time to wait after power on: the device is ready when its first measurement cycle
+         * is completed.
+         *
+         * \return warm up time (in milliseconds)
+         */
+        virtual unsigned long warmup() { return TSTARTUP; }
+
+        /**
+         * Gets the time of a measurement cycle: the result of an acquisition is checked when it is
+         * completed.
+         *
+         * \return latency (in milliseconds)
+         */
+        virtual unsigned long latency() { return TMEASUREMENT; }
+
         /**
          * Returns the status of the last reading.
          * Values are :
@@ -157,11 +205,49 @@ namespace smrtobj
         float temperature();
 
       private:
+        //! Number of bytes read
+        static const uint8_t DATA_LENGTH = 4;
+
+        //! Power on time, with the first measurement cycle (in milliseconds, 60 ms max)
+        static const unsigned long TSTARTUP = 60;
+
+        //! Measurement cycle (in milliseconds, 36.65 ms typical)
+        static const unsigned long TMEASUREMENT = 37;
+
+        //! Status: 2 MSBs of Byte0
+        typedef RegisterField<0, 1, true, 6, 2> Status;
+
+        //! Humidity: 6 LSBs of Byte0 and Byte1
+        typedef RegisterField<0, 2, true, 0, 14> Humidity;
+
+        //! Temperature: Byte2 and 6 MSBs of Byte3
+        typedef RegisterField<2, 2, true, 2, 14> Temperature;
+
+        /**
+         * Decodes data read.
+         *
+         * \param[in] buf data read (DATA_LENGTH bytes)
+         */
+        void decode(const uint8_t *buf);
+
+        /**
+         * Decodes data at the end of the reading started by smrtobj::i2c::HIH7121::begin.
+         *
+         * \param[in] t transaction completed
+         */
+        static void completed(I2CTransaction &t);
+
         uint8_t m_status;
 
         uint16_t m_humidity;
 
         uint16_t m_temperature;
+
+        //! Transaction of the reading in background
+        I2CTransaction m_transaction;
+
+        //! Data of the reading in background
+        uint8_t m_buffer[DATA_LENGTH];
     };
 
   } /* namespace i2c */
@@ -68,76 +68,56 @@ namespace smrtobj
     }
   
     bool IAQ2000::read() {
-      uint8_t buf[9] = {0};
+      uint8_t buf[DATA_LENGTH] = {0};
 
-       if ( readAllBytes(address(), 9, buf, 0) != 9 )
+       if ( readAllBytes(address(), DATA_LENGTH, buf, 0) != DATA_LENGTH )
          return false;
 
-       bool valid = true;
-       m_value = 0;
-       m_resistance = 0;
-       m_tvoc = 0;
+       decode(buf);
 
+       return true;
+      //return read_word(m_value);
+    }
 
-       for (uint8_t index = 0; index < 9; index++)
-       {
-         switch (index)
-         {
-           case 0 :
-           case 1 : {
-             m_value <<= 8;
-             m_value |= buf[index];
-           }
-           break;
+    bool IAQ2000::begin()
+    {
+      if ( !m_transaction.set(address(), 0, 0, m_buffer, DATA_LENGTH) )
+      {
+        return false;
+      }
 
-           case 2 : {
-             m_status = buf[index];
-           }
-           break;
+      m_transaction.setCallback(completed, this);
 
-           case 3 :
-           case 4 :
-           case 5 :
-           case 6 : {
-             m_resistance <<= 8;
-             m_resistance |= buf[index];
-           }
-           break;
+      return submit(m_transaction);
+    }
 
-           case 7 :
-           case 8 : {
-             m_tvoc <<= 8;
-             m_tvoc |= buf[index];
-           }
-           break;
-         }
-         /*
-         Serial.print( F( "[" ) );
-         Serial.print( index );
-         Serial.print( F( "] : " ) );
-         Serial.println( buf[index] , HEX );
-         */
-       }
-       /*
-       Serial.print( F("PPM : ") );
-       Serial.println( m_value );
+    int8_t IAQ2000::poll()
+    {
+      I2CQueue::poll();
 
-       Serial.print( F("Status : ") );
-       Serial.println( m_status);
+      return m_transaction.status();
+    }
 
-       Serial.print( F("Resistance : ") );
-       Serial.println( m_resistance );
+    void IAQ2000::completed(I2CTransaction &t)
+    {
+      if ( t.status() == I2CTransaction::DONE )
+      {
+        IAQ2000 *s = (IAQ2000*) t.context();
+        s->decode(s->m_buffer);
+      }
+    }
 
-       Serial.print( F("tvoc : ") );
-       Serial.println( m_tvoc );
-       */
-       return true;
-      //return read_word(m_value);
+    void IAQ2000::decode(const uint8_t *buf)
+    {
+      m_value = Prediction::get(buf);
+      m_status = Status::get(buf);
+      m_resistance = Resistance::get(buf);
+      m_tvoc = Tvoc::get(buf);
     }
   
     float IAQ2000::measure()
     {
-     return (float) m_value;
+     return calibrate( (float) m_value );
     }
 
   } /* namespace i2c */
@@ -9,6 +9,8 @@
 #define IAQ2000_H_
 
 #include <interfaces/i2cinterface.h>
+#include <interfaces/i2cqueue.h>
+#include <interfaces/i2cregister.h>
 
 namespace smrtobj
 {
@@ -87,6 +89,22 @@ namespace smrtobj
          * \return true for success, or false if any error occurs.
          */
         virtual bool read();
+
+        /**
+         * Starts reading data from the i2c device in background (see smrtobj::i2c::I2CQueue). Data are
+         * decoded as in smrtobj::i2c::IAQ2000::read when the transaction is completed.
+         *
+         * \return true if the reading has been started, false if a reading is already pending
+         */
+        bool begin();
+
+        /**
+         * Advances the I2C queue and returns the status of the reading started by smrtobj::i2c::IAQ2000::begin.
+         *
+         * \return I2CTransaction::DONE when new data are available, I2CTransaction::QUEUED or I2CTransaction::RUNNING
+         *         while the reading is pending, an error code (from smrtobj::i2c::I2CTransaction::_status enum) otherwise
+         */
+        int8_t poll();
   
         /**
          * Returns last data read as a floating point number.
@@ -94,6 +112,28 @@ namespace smrtobj
          * \return last data read
          */
         virtual float measure();
+
+        /**
+         * Starts the acquisition in background (see smrtobj::i2c::IAQ2000::begin).
+         *
+         * \return true if the reading has been started, false if a reading is already pending
+         */
+        virtual bool startAcquisition() { return begin(); }
+
+        /**
+         * Checks the acquisition started by smrtobj::i2c::IAQ2000::startAcquisition, advancing the I2C queue.
+         *
+         * \return status according to smrtobj::io::Sensor::_acquisition enum
+         */
+        virtual int8_t pollAcquisition() { return acquisition(poll()); }
+
+        /**
+         * Gets the time to wait after power on: the module is in the warm up phase (RUNIN status) and its
+         * values are not valid.
+         *
+         * \return warm up time (in milliseconds)
+         */
+        virtual unsigned long warmup() { return TRUNIN; }
   
         /**
          * Returns last value read as unsigned integer of 16 bits.
@@ -129,6 +169,38 @@ namespace smrtobj
         uint16_t tVOC() { return m_tvoc; };
 
       private:
+        //! Number of bytes read
+        static const uint8_t DATA_LENGTH = 9;
+
+        //! Warm up phase after power on (in milliseconds, 5 minutes)
+        static const unsigned long TRUNIN = 300000UL;
+
+        //! Prediction (CO2 equivalent ppm): Byte0 and Byte1
+        typedef RegisterField<0, 2> Prediction;
+
+        //! Status: Byte2
+        typedef RegisterField<2, 1> Status;
+
+        //! Resistance: Byte3 - Byte6
+        typedef RegisterField<3, 4> Resistance;
+
+        //! TVOC equivalent ppb: Byte7 and Byte8
+        typedef RegisterField<7, 2> Tvoc;
+
+        /**
+         * Decodes data read.
+         *
+         * \param[in] buf data read (DATA_LENGTH bytes)
+         */
+        void decode(const uint8_t *buf);
+
+        /**
+         * Decodes data at the end of the reading started by smrtobj::i2c::IAQ2000::begin.
+         *
+         * \param[in] t transaction completed
+         */
+        static void completed(I2CTransaction &t);
+
         //! Last value read
         uint16_t m_value;
 
@@ -141,6 +213,12 @@ namespace smrtobj
         //! status
         uint16_t m_tvoc;
 
+        //! Transaction of the reading in background
+        I2CTransaction m_transaction;
+
+        //! Data of the reading in background
+        uint8_t m_buffer[DATA_LENGTH];
+
     };
   
   } /* namespace i2c */
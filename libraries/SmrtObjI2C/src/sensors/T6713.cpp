@@ -13,7 +13,7 @@ namespace smrtobj
   namespace i2c
   {
   
-    T6713::T6713() : m_register(0)
+    T6713::T6713() : m_register(0), m_result(I2CTransaction::IDLE)
     {
       setDeviceAddress(DEVICE_ADDRESS);
     }
@@ -53,82 +53,104 @@ namespace smrtobj
       return false;
     }
   
-    bool T6713::read(uint16_t cmd)
+    bool T6713::command(uint16_t cmd, uint8_t *buf)
     {
-      uint16_t c = cmd;
-
-//      Serial.println(c, HEX);
       switch (cmd)
       {
         case FIRMWARE :
         case STATUS :
-        case GAS_PPM : {
-          uint8_t buf_in[5] = {0};
-          uint8_t buf_out[4] = {0};
-          buf_in[0] = FUNCTION_READ;
-          buf_in[2] = c;
-          buf_in[2] &= 0x0FF;
-          c >>= 8;
-          buf_in[1] = c;
-          buf_in[1] &= 0x0FF;
-          buf_in[3] = 0x00;
-          buf_in[4] = 0x01;
-/*
-          for (uint8_t i = 0; i < 5; i++)
-          {
-            Serial.println(buf_in[i], HEX);
-          }
-*/
-          if ( !writeAllBytes(address(), 5, buf_in, 0) )
-            return false;
-
-//          Serial.println( F("Read response"));
-          if ( readAllBytes(address(), 4,buf_out, 0) != 4 )
-            return false;
-//          Serial.println( F("Process response"));
-
-          bool valid = true;
-          for (uint8_t index = 0; index < 4; index++)
-          {
-/*
-            Serial.print( index );
-            Serial.print( F(" : "));
-            Serial.println( buf_out[index] );
-            Serial.println( valid);
-*/
-            switch (index)
-            {
-              case 0 : {
-                if ( buf_out[index] != 0x04 )
-                {
-                  valid = false;
-                }
-              } break;
-              case 1 : {
-                if ( buf_out[index] != 0x02 )
-                {
-                  valid = false;
-                }
-              }break;
-              case 2 : { m_register = buf_out[index]; m_register <<= 8; } break;
-              case 3 : { m_register += (uint16_t) (buf_out[index] & 0x0FF) ; } break;
-              default :
-               valid = false;
-            }
-          }
-
-//          Serial.println( valid);
-          if (!valid)
-            return false;
-
-
-        } break;
+        case GAS_PPM : break;
         default :
           return false;
       }
+
+      CommandFunction::set(buf, FUNCTION_READ);
+      CommandAddress::set(buf, cmd);
+      CommandCount::set(buf, 1);
+
+      return true;
+    }
+
+    bool T6713::decode(const uint8_t *buf)
+    {
+      // Function code and number of bytes
+      if ( ResponseFunction::get(buf) != 0x04 || ResponseLength::get(buf) != 0x02 )
+      {
+        return false;
+      }
+
+      m_register = ResponseValue::get(buf);
+
       return true;
     }
 
+    bool T6713::read(uint16_t cmd)
+    {
+      uint8_t buf_in[COMMAND_LENGTH] = {0};
+      uint8_t buf_out[RESPONSE_LENGTH] = {0};
+
+      if ( !command(cmd, buf_in) )
+        return false;
+
+      if ( !writeAllBytes(address(), COMMAND_LENGTH, buf_in, 0) )
+        return false;
+
+      if ( readAllBytes(address(), RESPONSE_LENGTH, buf_out, 0) != RESPONSE_LENGTH )
+        return false;
+
+      return decode(buf_out);
+    }
+
+    bool T6713::begin(uint16_t cmd)
+    {
+      if ( m_transaction.isPending() || !command(cmd, m_command) )
+      {
+        return false;
+      }
+
+      m_transaction.set(address(), m_command, COMMAND_LENGTH);
+      m_transaction.setCallback(written, this);
+      m_result = I2CTransaction::QUEUED;
+
+      return submit(m_transaction);
+    }
+
+    int8_t T6713::poll()
+    {
+      I2CQueue::poll();
+
+      return ( m_transaction.isPending() ) ? m_transaction.status() : m_result;
+    }
+
+    void T6713::written(I2CTransaction &t)
+    {
+      T6713 *s = (T6713*) t.context();
+
+      if ( t.status() != I2CTransaction::DONE )
+      {
+        s->m_result = t.status();
+        return;
+      }
+
+      // The response is read with a new transaction, after the stop
+      t.set(s->address(), 0, 0, s->m_response, RESPONSE_LENGTH);
+      t.setCallback(received, s);
+      I2CQueue::submit(t);
+    }
+
+    void T6713::received(I2CTransaction &t)
+    {
+      T6713 *s = (T6713*) t.context();
+
+      if ( t.status() != I2CTransaction::DONE )
+      {
+        s->m_result = t.status();
+        return;
+      }
+
+      s->m_result = ( s->decode(s->m_response) ) ? I2CTransaction::DONE : I2CTransaction::ERROR_DATA;
+    }
+
     bool T6713::read()
     {
       return read(GAS_PPM);
@@ -142,7 +164,7 @@ namespace smrtobj
   
     float T6713::measure()
     {
-      return (float) m_register;
+      return calibrate( (float) m_register );
     }
   
   } /* namespace i2c */
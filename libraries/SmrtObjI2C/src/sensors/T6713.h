@@ -9,6 +9,8 @@
 #define T6713_H_
 
 #include <interfaces/i2cinterface.h>
+#include <interfaces/i2cqueue.h>
+#include <interfaces/i2cregister.h>
   
  namespace smrtobj
 {
@@ -140,6 +142,28 @@
          * \return true for success, or false if any error occurs.
          */
         bool readStatus();
+
+        /**
+         * Starts reading a register in background (see smrtobj::i2c::I2CQueue): the command is written and,
+         * when the write is completed, the response is read. The register is decoded as in
+         * smrtobj::i2c::T6713::read.
+         *
+         * \param[in] cmd command register value (FIRMWARE, STATUS or GAS_PPM).
+         *
+         * \return true if the reading has been started, false if the command is not valid or a reading is
+         *         already pending
+         */
+        bool begin(uint16_t cmd = GAS_PPM);
+
+        /**
+         * Advances the I2C queue and returns the status of the reading started by smrtobj::i2c::T6713::begin.
+         *
+         * \return I2CTransaction::DONE when the register has been read, I2CTransaction::QUEUED or
+         *         I2CTransaction::RUNNING while the reading is pending, an error code (from
+         *         smrtobj::i2c::I2CTransaction::_status enum) otherwise. An invalid response gives
+         *         I2CTransaction::ERROR_DATA
+         */
+        int8_t poll();
   
         /**
          * Converts data read (saved in \e m_value variable) in voltage.
@@ -162,6 +186,28 @@
          * \return last data read as voltage level.
          */
         virtual float measure();
+
+        /**
+         * Starts the acquisition in background (see smrtobj::i2c::T6713::begin).
+         *
+         * \return true if the reading has been started, false if a reading is already pending
+         */
+        virtual bool startAcquisition() { return begin(); }
+
+        /**
+         * Checks the acquisition started by smrtobj::i2c::T6713::startAcquisition, advancing the I2C queue.
+         *
+         * \return status according to smrtobj::io::Sensor::_acquisition enum
+         */
+        virtual int8_t pollAcquisition() { return acquisition(poll()); }
+
+        /**
+         * Gets the time to wait after power on: the sensor is in warm-up mode (WARMUP_MODE status) and
+         * the concentration is not valid.
+         *
+         * \return warm up time (in milliseconds)
+         */
+        virtual unsigned long warmup() { return TWARMUP_MODE; }
   
         /**
          * Returns last ADC value read. Example:
@@ -203,8 +249,80 @@
         void setRgstr(uint16_t value) { m_register = value; }
 
       private:
+        //! Length of a command
+        static const uint8_t COMMAND_LENGTH = 5;
+
+        //! Length of a response
+        static const uint8_t RESPONSE_LENGTH = 4;
+
+        //! Warm-up mode after power on (in milliseconds, less than 2 minutes)
+        static const unsigned long TWARMUP_MODE = 120000UL;
+
+        //! Command: function code
+        typedef RegisterField<0, 1> CommandFunction;
+
+        //! Command: address of the register
+        typedef RegisterField<1, 2> CommandAddress;
+
+        //! Command: number of registers
+        typedef RegisterField<3, 2> CommandCount;
+
+        //! Response: function code
+        typedef RegisterField<0, 1> ResponseFunction;
+
+        //! Response: number of bytes
+        typedef RegisterField<1, 1> ResponseLength;
+
+        //! Response: value of the register
+        typedef RegisterField<2, 2> ResponseValue;
+
+        /**
+         * Builds the command to read a register.
+         *
+         * \param[in] cmd command register value.
+         * \param[out] buf command (COMMAND_LENGTH bytes)
+         *
+         * \return false if the command is not valid, true otherwise
+         */
+        static bool command(uint16_t cmd, uint8_t *buf);
+
+        /**
+         * Checks and decodes a response, storing the register value.
+         *
+         * \param[in] buf response (RESPONSE_LENGTH bytes)
+         *
+         * \return true if the response is valid, false otherwise
+         */
+        bool decode(const uint8_t *buf);
+
+        /**
+         * Starts reading the response when the command written by smrtobj::i2c::T6713::begin is completed.
+         *
+         * \param[in] t transaction completed
+         */
+        static void written(I2CTransaction &t);
+
+        /**
+         * Decodes the response read in background.
+         *
+         * \param[in] t transaction completed
+         */
+        static void received(I2CTransaction &t);
+
         //! Last value read
         uint16_t m_register;
+
+        //! Transaction of the reading in background
+        I2CTransaction m_transaction;
+
+        //! Command written in background
+        uint8_t m_command[COMMAND_LENGTH];
+
+        //! Response read in background
+        uint8_t m_response[RESPONSE_LENGTH];
+
+        //! Status of the reading in background
+        int8_t m_result;
     };
   
   } /* namespace i2c */
@@ -57,24 +57,24 @@ namespace smrtobj
         switch (i)
         {
           // RGBC timing is 256 - contents x 2.4mS =
-          case 0 : ret = I2Cdev::writeByte(DEVICE_ADDRESS, create_command(ATIME_ADDR), ATIME_VALUE); break;
+          case 0 : ret = writeByte(DEVICE_ADDRESS, create_command(ATIME_ADDR), ATIME_VALUE); break;
   
           // Can be used to change the wait time
           case 1 : {
-            ret = I2Cdev::writeByte( DEVICE_ADDRESS, create_command(CONFIG_ADDR), 2 ); // sets WLONG to 1
+            ret = writeByte( DEVICE_ADDRESS, create_command(CONFIG_ADDR), 2 ); // sets WLONG to 1
             if ( ret )
             {
-              ret = I2Cdev::writeByte(DEVICE_ADDRESS, create_command(WTIME_ADDR), WAIT_TIME_VALUE);
+              ret = writeByte(DEVICE_ADDRESS, create_command(WTIME_ADDR), WAIT_TIME_VALUE);
             }
             //ret = I2Cdev::writeByte(DEVICE_ADDRESS, WTIME_ADDR, WAIT_TIME_VALUE);
           }
             break;
   
           // RGBC gain control
-          case 2 : ret = I2Cdev::writeByte(DEVICE_ADDRESS, create_command(CONTROL_ADDR), CONTROL_VALUE); break;
+          case 2 : ret = writeByte(DEVICE_ADDRESS, create_command(CONTROL_ADDR), CONTROL_VALUE); break;
   
           // enable ADs and oscillator for sensor
-          case 3 : ret = I2Cdev::writeByte(DEVICE_ADDRESS, create_command(ENABLE_ADDR), ENABLE_VALUE); break;
+          case 3 : ret = writeByte(DEVICE_ADDRESS, create_command(ENABLE_ADDR), ENABLE_VALUE); break;
         }
   
         if (!ret)
@@ -94,7 +94,7 @@ namespace smrtobj
     {
       uint8_t r_register = 0;
   
-      if ( !I2Cdev::readByte(DEVICE_ADDRESS, create_command(ID_ADDR), &r_register, 0) )
+      if ( !readByte(DEVICE_ADDRESS, create_command(ID_ADDR), &r_register, 0) )
         return false;
   
       if ( r_register == 0x44 )
@@ -107,15 +107,15 @@ namespace smrtobj
   
     bool TCS34725::read()
     {
-      uint8_t buf[8] = {0};
+      uint8_t buf[DATA_LENGTH] = {0};
   
-      if ( ! I2Cdev::readBytes(DEVICE_ADDRESS,  create_command(COLOR_ADDR), 8, buf, 0) )
+      if ( ! readBytes(DEVICE_ADDRESS,  create_command(COLOR_ADDR), DATA_LENGTH, buf, 0) )
         return false;
   
-      m_clear = (uint16_t)(buf[1]<<8) + (uint16_t)buf[0];
-      m_red   = (uint16_t)(buf[3]<<8) + (uint16_t)buf[2];
-      m_green = (uint16_t)(buf[5]<<8) + (uint16_t)buf[4];
-      m_blue  = (uint16_t)(buf[7]<<8) + (uint16_t)buf[6];
+      m_clear = Clear::get(buf);
+      m_red   = Red::get(buf);
+      m_green = Green::get(buf);
+      m_blue  = Blue::get(buf);
   
       return true;
     }
@@ -146,7 +146,7 @@ namespace smrtobj
   
       if((lux < 0) && (m_clear < 50)) lux = 0;
   
-      return lux;
+      return calibrate(lux);
     };
   
   } /* namespace i2c */
@@ -9,6 +9,7 @@
 #define TCS34725_H_
 
 #include <interfaces/i2cinterface.h>
+#include <interfaces/i2cregister.h>
 
 namespace smrtobj
 {
@@ -170,6 +171,13 @@ namespace smrtobj
          * \return value in Lux
          */
         virtual float measure();
+
+        /**
+         * Starts the acquisition: the device is read at once (see smrtobj::i2c::TCS34725::read).
+         *
+         * \return true for success, or false if any error occurs
+         */
+        virtual bool startAcquisition() { return read(); }
   
         /**
          * Returns the clear component of the last sensor reading.
@@ -200,6 +208,21 @@ namespace smrtobj
         uint16_t blue_color()  { return m_blue; };
   
       private:
+        //! Number of bytes read from COLOR_ADDR
+        static const uint8_t DATA_LENGTH = 8;
+
+        //! Clear component (LSB first)
+        typedef RegisterField<0, 2, false> Clear;
+
+        //! Red component (LSB first)
+        typedef RegisterField<2, 2, false> Red;
+
+        //! Green component (LSB first)
+        typedef RegisterField<4, 2, false> Green;
+
+        //! Blue component (LSB first)
+        typedef RegisterField<6, 2, false> Blue;
+
         /**
          * Creates code of a command as Register + Command_Mask
          *
@@ -13,6 +13,15 @@
 // Interfaces
 #include "interfaces/signal.h"
 #include "interfaces/i2cinterface.h"
+#include "interfaces/i2ctransaction.h"
+#include "interfaces/i2cbus.h"
+#include "interfaces/i2cqueue.h"
+#include "interfaces/i2cregister.h"
+
+// Buses
+#include "bus/twibus.h"
+#include "bus/wirebus.h"
+#include "bus/i2csimbus.h"
 
 // Sensors
 #include "sensors/TCS34725.h"  // Lighting
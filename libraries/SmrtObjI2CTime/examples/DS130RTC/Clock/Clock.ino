@@ -0,0 +1,47 @@
+/*
+ * Clock.ino
+ * Simple demo to get the current time from RTC DS130RTC without reading it at every request.
+ * The RTC is read once an hour (every minute during the first hour, to measure the drift of the
+ * Arduino clock); in the meantime the time is computed from millis().
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+
+// Arduino libraries
+#include <Time.h>                             // Time library
+#include <Wire.h>                             // I2C
+
+// I2Cdev and DS130RTC must be installed as libraries
+#include "I2Cdev.h"
+
+#include <smrtobjio.h>                        // Generic analog/digital sensors
+#include <smrtobji2c.h>                       // I2C sensors and devices
+#include <smrtobji2ctime.h>                   // I2C devices related to time
+
+smrtobj::i2c::DS130RTC rtc;                        // RTC handler
+
+void setup() {
+  // Open I2C communication
+  Wire.begin();
+
+  // Open serial monitor
+  Serial.begin(9600);
+
+  // Start the clock (waits for the next second of the RTC)
+  if ( !rtc.startClock() )
+    Serial.println( F("RTC read error!") );
+}
+
+void loop() {  
+  // No I2C transfer, but when the RTC has to be read again
+  time_t t = rtc.now();
+
+  Serial.print( F("Time in epoch format: ") );
+  Serial.print( t );
+  Serial.print( F(" drift (ppm): ") );
+  Serial.println( rtc.drift() );
+
+  delay(1000);  
+}
@@ -0,0 +1,64 @@
+/*
+ * NVRAMLog.ino
+ * Simple demo to store records in the battery-backed RAM of the RTC DS130RTC.
+ * At every boot a record with the boot counter is added, then the last records are printed.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+
+// Arduino libraries
+#include <Time.h>                             // Time library
+#include <Wire.h>                             // I2C
+
+// I2Cdev and DS130RTC must be installed as libraries
+#include "I2Cdev.h"
+
+#include <smrtobjio.h>                        // Generic analog/digital sensors
+#include <smrtobji2c.h>                       // I2C sensors and devices
+#include <smrtobji2ctime.h>                   // I2C devices related to time
+
+// Log of records of 2 bytes (boot counter)
+smrtobj::i2c::DS130NVRAMLog nvlog(2);
+
+void setup() {
+  // Open I2C communication
+  Wire.begin();
+
+  // Open serial monitor
+  Serial.begin(9600);
+
+  if ( !nvlog.initialize() )
+  {
+    Serial.println( F("RTC read error!") );
+    return;
+  }
+
+  // Boot counter from the newest record
+  uint16_t boot = 0;
+  uint8_t data[2] = {0};
+
+  if ( nvlog.get(0, data) )
+    boot = (data[0] << 8) | data[1];
+
+  boot++;
+  data[0] = boot >> 8;
+  data[1] = boot & 0xFF;
+
+  // Add the record and write it
+  nvlog.append(data);
+  nvlog.flush();
+
+  Serial.print( F("Boot number: ") );
+  Serial.println( boot );
+
+  Serial.print( F("Records: ") );
+  Serial.print( nvlog.count() );
+  Serial.print( F(" of ") );
+  Serial.println( nvlog.capacity() );
+}
+
+void loop() {  
+  delay(100);  
+}
@@ -0,0 +1,251 @@
+/**
+ * \file DS130NVRAMLog.cpp
+ * \brief  DS130NVRAMLog is a class to store records in the NV SRAM of the DS130 RTC, as a ring buffer.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "DS130NVRAMLog.h"
+
+namespace smrtobj
+{
+  namespace i2c
+  {
+
+    /**
+     * Gets the sequence number following \e seq (0 is not used).
+     */
+    static uint8_t nextSequence(uint8_t seq)
+    {
+      return (seq == 255) ? 1 : seq + 1;
+    }
+
+    DS130NVRAMLog::DS130NVRAMLog(uint8_t size) : I2CInterface(DS130RTC::DEVICE_ADDRESS), m_size(size), m_count(0), m_next(0),
+        m_seq(0), m_pending(0)
+    {
+      if (m_size < 1 || m_size > MAX_RECORD)
+        m_size = MAX_RECORD;
+
+      m_slots = (NVRAM_SIZE - HEADER_LENGTH) / (m_size + 1);
+    }
+
+    DS130NVRAMLog::DS130NVRAMLog(const DS130NVRAMLog &d) : I2CInterface(d)
+    {
+      (*this) = d;
+    }
+
+    DS130NVRAMLog::~DS130NVRAMLog()
+    {
+
+    }
+
+    DS130NVRAMLog & DS130NVRAMLog::operator=(const DS130NVRAMLog &d)
+    {
+      I2CInterface::operator=(d);
+      m_size = d.m_size;
+      m_slots = d.m_slots;
+      m_count = d.m_count;
+      m_next = d.m_next;
+      m_seq = d.m_seq;
+      m_pending = d.m_pending;
+      memcpy(m_buffer, d.m_buffer, TRANSFER_LENGTH);
+
+      return (*this);
+    }
+
+    bool DS130NVRAMLog::initialize()
+    {
+      uint8_t header[HEADER_LENGTH] = {0};
+
+      if ( readBytes(address(), NVRAM_START, HEADER_LENGTH, header, 0) != HEADER_LENGTH )
+        return false;
+
+      if (header[0] != MARKER || header[1] != m_size)
+        return clear();
+
+      return read();
+    }
+
+    bool DS130NVRAMLog::isConnected()
+    {
+      uint8_t marker = 0;
+
+      return ( readBytes(address(), NVRAM_START, 1, &marker, 0) == 1 );
+    }
+
+    bool DS130NVRAMLog::read()
+    {
+      uint8_t length = m_slots * (m_size + 1);
+      uint8_t prev = 0;
+      uint8_t newest = 0;
+      bool found = false;
+
+      m_pending = 0;
+      m_count = 0;
+
+      // Sequence numbers are the last byte of each slot: the newest record is the one not followed by
+      // the next sequence number
+      for (uint8_t offset = 0; offset < length; offset += TRANSFER_LENGTH)
+      {
+        uint8_t n = (length - offset < TRANSFER_LENGTH) ? length - offset : TRANSFER_LENGTH;
+
+        if ( readBytes(address(), slotAddress(0) + offset, n, m_buffer, 0) != n )
+          return false;
+
+        for (uint8_t i = 0; i < n; i++)
+        {
+          uint8_t pos = offset + i;
+
+          if ( pos % (m_size + 1) != m_size )
+            continue;
+
+          uint8_t slot = pos / (m_size + 1);
+          uint8_t seq = m_buffer[i];
+
+          if (slot > 0 && !found && prev != 0 && seq != nextSequence(prev))
+          {
+            newest = slot - 1;
+            found = true;
+          }
+
+          if (seq != 0)
+            m_count++;
+
+          prev = seq;
+        }
+      }
+
+      // No break: the ring is full and the last slot is the newest
+      if (!found)
+        newest = m_slots - 1;
+
+      if (m_count == 0)
+      {
+        m_next = 0;
+        m_seq = 0;
+
+        return true;
+      }
+
+      m_next = (newest + 1) % m_slots;
+
+      if ( readBytes(address(), slotAddress(newest) + m_size, 1, &m_seq, 0) != 1 )
+        return false;
+
+      return true;
+    }
+
+    bool DS130NVRAMLog::clear()
+    {
+      uint8_t header[HEADER_LENGTH] = {MARKER, m_size};
+
+      m_pending = 0;
+      m_count = 0;
+      m_next = 0;
+      m_seq = 0;
+
+      // Marker cleared first: if the slots are not all emptied (sequence number 0), the RAM is formatted
+      // again by the next initialize()
+      if ( !writeByte(address(), NVRAM_START, 0) )
+        return false;
+
+      memset(m_buffer, 0, TRANSFER_LENGTH);
+
+      uint8_t length = m_slots * (m_size + 1);
+
+      for (uint8_t offset = 0; offset < length; offset += TRANSFER_LENGTH)
+      {
+        uint8_t n = (length - offset < TRANSFER_LENGTH) ? length - offset : TRANSFER_LENGTH;
+
+        if ( !writeRAM(slotAddress(0) + offset, n, m_buffer) )
+          return false;
+      }
+
+      return writeRAM(NVRAM_START, HEADER_LENGTH, header);
+    }
+
+    bool DS130NVRAMLog::append(const uint8_t *data)
+    {
+      uint8_t *slot = m_buffer + m_pending * (m_size + 1);
+
+      // Data, then sequence number: a record is valid only when its last byte is written
+      memcpy(slot, data, m_size);
+      m_seq = nextSequence(m_seq);
+      slot[m_size] = m_seq;
+
+      m_pending++;
+      if (m_count < m_slots)
+        m_count++;
+
+      if ( (m_pending + 1) * (m_size + 1) > TRANSFER_LENGTH || m_pending == m_slots )
+        return flush();
+
+      return true;
+    }
+
+    bool DS130NVRAMLog::flush()
+    {
+      if (m_pending == 0)
+        return true;
+
+      uint8_t n = m_pending;
+      uint8_t first = m_next;
+      uint8_t part = (n < m_slots - first) ? n : m_slots - first;
+      bool ok = true;
+
+      // Empty slots first: if the write is cut, no slot keeps its sequence number with part of the new data
+      for (uint8_t i = 0; i < n && ok; i++)
+        ok = writeByte(address(), slotAddress((first + i) % m_slots) + m_size, 0);
+
+      if (ok)
+        ok = writeRAM(slotAddress(first), part * (m_size + 1), m_buffer);
+
+      // The ring wraps
+      if (ok && part < n)
+        ok = writeRAM(slotAddress(0), (n - part) * (m_size + 1), m_buffer + part * (m_size + 1));
+
+      if (!ok)
+      {
+        // Records not written: state from the device
+        read();
+        return false;
+      }
+
+      m_next = (first + n) % m_slots;
+      m_pending = 0;
+
+      return true;
+    }
+
+    bool DS130NVRAMLog::get(uint8_t index, uint8_t *data)
+    {
+      if (index >= m_count)
+        return false;
+
+      if (index < m_pending)
+      {
+        memcpy(data, m_buffer + (m_pending - 1 - index) * (m_size + 1), m_size);
+        return true;
+      }
+
+      uint8_t slot = (m_next + m_slots - 1 - (index - m_pending)) % m_slots;
+
+      return ( readBytes(address(), slotAddress(slot), m_size, data, 0) == m_size );
+    }
+
+    bool DS130NVRAMLog::writeRAM(uint8_t reg, uint8_t length, uint8_t *data)
+    {
+      for (uint8_t offset = 0; offset < length; offset += TRANSFER_LENGTH)
+      {
+        uint8_t n = (length - offset < TRANSFER_LENGTH) ? length - offset : TRANSFER_LENGTH;
+
+        if ( !writeBytes(address(), reg + offset, n, data + offset) )
+          return false;
+      }
+
+      return true;
+    }
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
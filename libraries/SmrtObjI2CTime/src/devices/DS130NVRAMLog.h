@@ -0,0 +1,231 @@
+/**
+ * \file DS130NVRAMLog.h
+ * \brief  DS130NVRAMLog is a class to store records in the NV SRAM of the DS130 RTC, as a ring buffer.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef DS130NVRAMLOG_H_
+#define DS130NVRAMLOG_H_
+
+#include <interfaces/i2cinterface.h>
+#include "DS130RTC.h"
+
+namespace smrtobj
+{
+  namespace i2c
+  {
+    /**
+     * Class DS130NVRAMLog stores fixed size records in the 56 bytes of battery-backed RAM of the DS1307
+     * (registers 0x08 - 0x3F), e.g. boot counters, last values of sensors or brown-out markers. Unlike the
+     * EEPROM, the RAM can be written any number of times.
+     *
+     * The RAM starts with a header (a marker and the record size), followed by the slots of the records.
+     * Each slot contains the data of a record and its sequence number (1 - 255, 0 if the slot is empty);
+     * the newest record is found from the sequence numbers, so the header is not written when a record is
+     * added. When all slots are used, a new record overwrites the oldest one. The sequence numbers of the
+     * slots are cleared before their data is written, so a write cut by a power failure loses the records
+     * being written but never leaves a slot with new data and an old sequence number.
+     *
+     * Records added are kept in a buffer and written together (in one I2C transfer, two if the ring wraps,
+     * after a one byte write per slot to empty it) when the buffer is full or by
+     * smrtobj::i2c::DS130NVRAMLog::flush.
+     *
+     * \code{.cpp}
+     * smrtobj::i2c::DS130NVRAMLog log(2);   // records of 2 bytes
+     *
+     * log.initialize();                    // loads (or formats) the RAM
+     *
+     * uint8_t boot[2] = { 0x01, 0x00 };
+     * log.append(boot);
+     * log.flush();
+     *
+     * uint8_t last[2];
+     * log.get(0, last);                    // newest record
+     * \endcode
+     */
+    class DS130NVRAMLog : public I2CInterface
+    {
+      public:
+        //! First register of the RAM
+        static const uint8_t NVRAM_START = 0x08;
+
+        //! Size of the RAM (bytes)
+        static const uint8_t NVRAM_SIZE = 56;
+
+        //! Size of the header (bytes)
+        static const uint8_t HEADER_LENGTH = 2;
+
+        //! Marker of a formatted RAM
+        static const uint8_t MARKER = 0x5A;
+
+        //! Maximum size of a record (bytes)
+        static const uint8_t MAX_RECORD = 16;
+
+        //! Maximum number of bytes in an I2C transfer (Wire buffer less register address)
+        static const uint8_t TRANSFER_LENGTH = 30;
+
+        /**
+         * Constructor.
+         * Sets the size of the records. It must be between 1 and \e MAX_RECORD, otherwise \e MAX_RECORD is
+         * used.
+         *
+         * \param[in] size record size (bytes)
+         */
+        DS130NVRAMLog(uint8_t size = 4);
+
+        /**
+         * Copy Constructor.
+         *
+         * \param[in] d I2C device object
+         */
+        DS130NVRAMLog(const DS130NVRAMLog &d);
+
+        /**
+         * Destructor.
+         */
+        virtual ~DS130NVRAMLog();
+
+        /**
+         * Override operator =
+         *
+         * \param[in] d source object
+         *
+         * \return destination obiect reference
+         */
+        DS130NVRAMLog & operator=(const DS130NVRAMLog &d);
+
+        /**
+         * Loads the log from the RAM. If the RAM does not contain a log with this record size (e.g. the
+         * backup battery has been removed), it is formatted.
+         *
+         * \return true for success, or false if any error occurs.
+         */
+        virtual bool initialize();
+
+        /**
+         * Tests if the device is connected.
+         * This function makes sure the device is connected and responds when you try to read a register.
+         *
+         * \return true if connection is valid, false otherwise
+         */
+        virtual bool isConnected();
+
+        /**
+         * Reads the sequence numbers of the records from the RAM, to find the newest record and the
+         * number of records. Records not written yet are discarded.
+         *
+         * \return true for success, or false if any error occurs.
+         */
+        virtual bool read();
+
+        /**
+         * Removes all records and writes the header.
+         *
+         * \return true for success, or false if any error occurs.
+         */
+        bool clear();
+
+        /**
+         * Adds a record. The record is written when the buffer is full or by
+         * smrtobj::i2c::DS130NVRAMLog::flush.
+         *
+         * \param[in] data record (record size bytes)
+         *
+         * \return true for success, or false if any error occurs writing the buffer.
+         */
+        bool append(const uint8_t *data);
+
+        /**
+         * Writes the records in the buffer.
+         *
+         * \return true for success, or false if any error occurs.
+         */
+        bool flush();
+
+        /**
+         * Reads a record (from the buffer if it has not been written yet).
+         *
+         * \param[in] index record number, 0 for the newest
+         * \param[out] data record (record size bytes)
+         *
+         * \return true for success, or false if the record does not exist or any error occurs.
+         */
+        bool get(uint8_t index, uint8_t *data);
+
+        /**
+         * Gets the number of records (also the ones in the buffer).
+         *
+         * \return number of records
+         */
+        uint8_t count() { return m_count; };
+
+        /**
+         * Gets the maximum number of records.
+         *
+         * \return number of slots
+         */
+        uint8_t capacity() { return m_slots; };
+
+        /**
+         * Gets the sequence number of the newest record.
+         *
+         * \return sequence number (1 - 255), 0 if there are no records
+         */
+        uint8_t sequence() { return m_seq; };
+
+        /**
+         * Gets the size of a record.
+         *
+         * \return record size (bytes)
+         */
+        uint8_t size() { return m_size; };
+
+      private:
+        /**
+         * Gets the register of a slot.
+         *
+         * \param[in] slot slot number
+         *
+         * \return register address
+         */
+        uint8_t slotAddress(uint8_t slot) { return NVRAM_START + HEADER_LENGTH + slot * (m_size + 1); };
+
+        /**
+         * Writes bytes to the RAM, splitting them in transfers of \e TRANSFER_LENGTH bytes at most.
+         *
+         * \param[in] reg first register
+         * \param[in] length number of bytes
+         * \param[in] data data to write
+         *
+         * \return true for success, or false if any error occurs.
+         */
+        bool writeRAM(uint8_t reg, uint8_t length, uint8_t *data);
+
+        //! Record size
+        uint8_t m_size;
+
+        //! Number of slots
+        uint8_t m_slots;
+
+        //! Number of records
+        uint8_t m_count;
+
+        //! Slot of the next record
+        uint8_t m_next;
+
+        //! Sequence number of the newest record
+        uint8_t m_seq;
+
+        //! Records not written yet (slots)
+        uint8_t m_pending;
+
+        //! Buffer of the records not written yet
+        uint8_t m_buffer[TRANSFER_LENGTH];
+    };
+
+  } /* namespace i2c */
+
+} /* namespace smrtobj */
+
+#endif /* DS130NVRAMLOG_H_ */
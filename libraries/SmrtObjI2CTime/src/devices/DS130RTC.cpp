@@ -12,14 +12,15 @@ namespace smrtobj
   namespace i2c
   {
 
-    DS130RTC::DS130RTC() : I2CInterface(DEVICE_ADDRESS),  m_time(0)
+    DS130RTC::DS130RTC() : I2CInterface(DEVICE_ADDRESS),  m_time(0), m_clock(false), m_interval(SYNC_INTERVAL * 1000),
+        m_base_time(0), m_base_ms(0), m_retry_ms(0), m_ref_time(0), m_ref_ms(0), m_rate(0), m_measured(false), m_lo(0), m_hi(0), m_ref_error(0)
     {
 
     }
 
-    DS130RTC::DS130RTC(const DS130RTC &d)
+    DS130RTC::DS130RTC(const DS130RTC &d) : I2CInterface(d)
     {
-      m_time = d.m_time;
+      (*this) = d;
     }
 
     DS130RTC::~DS130RTC()
@@ -31,6 +32,18 @@ namespace smrtobj
     {
       I2CInterface::operator=(d);
       m_time = d.m_time;
+      m_clock = d.m_clock;
+      m_interval = d.m_interval;
+      m_base_time = d.m_base_time;
+      m_base_ms = d.m_base_ms;
+      m_retry_ms = d.m_retry_ms;
+      m_ref_time = d.m_ref_time;
+      m_ref_ms = d.m_ref_ms;
+      m_rate = d.m_rate;
+      m_measured = d.m_measured;
+      m_lo = d.m_lo;
+      m_hi = d.m_hi;
+      m_ref_error = d.m_ref_error;
 
       return (*this);
     }
@@ -55,14 +68,25 @@ namespace smrtobj
       data[5] = dec2bcd(tm.Month);
       data[6] = dec2bcd(tmYearToY2k(tm.Year));
 
-      return I2Cdev::writeBytes(address(), 0x00, 7,data);
+      return writeBytes(address(), 0x00, 7,data);
     }
 
     bool DS130RTC::write(time_t t)
     {
       m_time = t;
 
-      return write();
+      if ( !write() )
+        return false;
+
+      // New time base (and reference for the drift): writing the seconds resets the divider of the RTC
+      m_base_time = t;
+      m_base_ms = millis();
+      m_retry_ms = m_base_ms;
+      m_lo = 0;
+      m_hi = 0;
+      reference();
+
+      return true;
     }
 
     bool DS130RTC::read()
@@ -70,7 +94,7 @@ namespace smrtobj
       uint8_t data[7] = {0};
       tmElements_t tm;
 
-      if ( I2Cdev::readBytes(address(), 0x00, 7, data) )
+      if ( readBytes(address(), 0x00, 7, data) == 7 )
       {
         tm.Second = bcd2dec(data[0] & 0x7f);
         tm.Minute = bcd2dec(data[1] );
@@ -88,6 +112,193 @@ namespace smrtobj
       return false;
     }
 
+    bool DS130RTC::startClock(unsigned long interval)
+    {
+      // Start of the next second: the seconds register changes (at most one second)
+      uint8_t first = 0;
+      uint8_t sec = 0;
+
+      if ( readByte(address(), 0x00, &first, 0) != 1 )
+        return false;
+
+      unsigned long start = millis();
+      unsigned long edge = start;
+
+      do
+      {
+        edge = millis();
+
+        if ( readByte(address(), 0x00, &sec, 0) != 1 )
+          return false;
+      }
+      while (sec == first && edge - start < 1100);
+
+      if ( !read() )
+        return false;
+
+      m_interval = interval * 1000;
+      m_base_time = m_time;
+      m_base_ms = edge;
+      m_retry_ms = edge;
+      m_lo = 0;
+      m_hi = 0;
+
+      reference();
+      m_clock = true;
+
+      return true;
+    }
+
+    unsigned long DS130RTC::elapsed(unsigned long ms)
+    {
+      unsigned long e = ms - m_base_ms;
+
+      return e + (long) (e * m_rate);
+    }
+
+    time_t DS130RTC::now()
+    {
+      if (!m_clock)
+        return m_time;
+
+      unsigned long ms = millis();
+      unsigned long interval = m_interval;
+
+      if ( !m_measured && interval > SYNC_INTERVAL_START * 1000 )
+        interval = SYNC_INTERVAL_START * 1000;
+
+      // A failed reading is not repeated before another interval: the clock keeps running meanwhile
+      if ( ms - m_base_ms >= interval && ms - m_retry_ms >= interval )
+      {
+        if ( sync() )
+        {
+          ms = millis();
+          m_retry_ms = m_base_ms;
+        }
+        else
+          m_retry_ms = ms;
+      }
+
+      return m_base_time + elapsed(ms) / 1000;
+    }
+
+    bool DS130RTC::sync()
+    {
+      if ( !read() )
+        return false;
+
+      unsigned long ms = millis();
+
+      // Milliseconds from the start of the RTC second, according to the clock
+      long diff = (long) (m_base_time - m_time);
+      unsigned long e = elapsed(ms);
+      long estimate = 0;
+      bool restart = true;
+
+      if (diff > -1000000 && diff < 1000000 && e < 1000000000)
+      {
+        estimate = diff * 1000 + (long) e;
+        restart = (estimate <= -5000 || estimate >= 5000);
+      }
+
+      // The error range of the clock grows with the time elapsed (uncertainty of the drift)
+      long widen = (long) (e / 1000) * ( (m_measured) ? DRIFT_ACCURACY : DRIFT_MAX ) / 1000;
+      m_lo = ( m_lo - widen < -1000 ) ? -1000 : m_lo - widen;
+      m_hi = ( m_hi + widen > 1000 ) ? 1000 : m_hi + widen;
+
+      if (restart)
+      {
+        // RTC changed (or not read for a long time): the clock starts again
+        estimate = 0;
+        m_lo = -1000;
+        m_hi = 1000;
+      }
+
+      align(ms, estimate);
+
+      // Reference for the drift: the reading with the smallest error, until the drift is measured
+      if ( (!m_measured && m_hi - m_lo < m_ref_error) || restart )
+      {
+        reference();
+      }
+
+      // Drift measured from the reference reading
+      unsigned long span = m_base_ms - m_ref_ms;
+      if ( span >= DRIFT_MIN_SPAN * 1000 )
+      {
+        float rtc = (float) (m_base_time - m_ref_time) * 1000.0;
+        m_rate = (rtc - span) / span;
+        m_measured = true;
+      }
+
+      if ( span >= DRIFT_MAX_SPAN * 1000 )
+      {
+        reference();
+      }
+
+      return true;
+    }
+
+    void DS130RTC::reference()
+    {
+      m_ref_time = m_base_time;
+      m_ref_ms = m_base_ms;
+      m_ref_error = m_hi - m_lo;
+    }
+
+    void DS130RTC::align(unsigned long ms, long estimate)
+    {
+      // The RTC second started in the last 1000 ms: the error of the estimate is in [estimate - 999, estimate].
+      // Readings at different phases of the second reduce the range.
+      long lo = estimate - 999;
+      long hi = estimate;
+
+      if (lo < m_lo)
+        lo = m_lo;
+
+      if (hi > m_hi)
+        hi = m_hi;
+
+      if (lo > hi)
+      {
+        // Not consistent with the previous readings (the clock drifted): the previous range is moved
+        // to the nearest end of the new one
+        long range = m_hi - m_lo;
+
+        if (estimate - 999 > m_hi)
+        {
+          lo = estimate - 999;
+          hi = lo + range;
+        }
+        else
+        {
+          hi = estimate;
+          lo = hi - range;
+        }
+      }
+
+      // Correction in the middle of the range
+      long error = (lo + hi) / 2;
+      long phase = estimate - error;
+
+      m_lo = lo - error;
+      m_hi = hi - error;
+
+      m_base_time = m_time;
+      if (phase < 0)
+      {
+        m_base_time--;
+        phase += 1000;
+      }
+      else if (phase >= 1000)
+      {
+        m_base_time++;
+        phase -= 1000;
+      }
+
+      m_base_ms = ms - phase;
+    }
+
   } /* namespace i2c */
 
 } /* namespace smrtobj */
@@ -29,6 +29,19 @@ namespace smrtobj
      * midnight. Values that correspond to the day of week are user defined but must be sequential (i.e., if 1 equals 
      * Sunday, then 2 equals Monday, and so on.) 
      *
+     * In clock mode (smrtobj::i2c::DS130RTC::startClock), the RTC is read rarely (every sync interval) and the
+     * current time is computed from millis(). At each reading the driver measures the drift of the Arduino
+     * clock with respect to the RTC and corrects the elapsed time, so smrtobj::i2c::DS130RTC::now stays within
+     * a second of the RTC without I2C transfers.
+     *
+     * \code{.cpp}
+     * smrtobj::i2c::DS130RTC rtc;
+     *
+     * rtc.startClock();           // reads the RTC every hour
+     * ...
+     * time_t t = rtc.now();       // no I2C transfer (but once an hour)
+     * \endcode
+     *
      */
     class DS130RTC : public I2CInterface
     {
@@ -41,6 +54,24 @@ namespace smrtobj
           DEVICE_ADDRESS = 0x68,
         };
 
+        //! Default interval between two readings of the RTC in clock mode (seconds)
+        static const unsigned long SYNC_INTERVAL = 3600;
+
+        //! Interval between two readings of the RTC in clock mode, until the drift is measured (seconds)
+        static const unsigned long SYNC_INTERVAL_START = 60;
+
+        //! Minimum time between two readings used to measure the drift (seconds)
+        static const unsigned long DRIFT_MIN_SPAN = 3600;
+
+        //! Maximum drift of the Arduino clock, before it is measured (ppm)
+        static const long DRIFT_MAX = 5000;
+
+        //! Accuracy of the drift measured (ppm)
+        static const long DRIFT_ACCURACY = 50;
+
+        //! Maximum time between two readings used to measure the drift (seconds, less than millis() roll over)
+        static const unsigned long DRIFT_MAX_SPAN = 2000000;
+
         /**
          * Default Constructor.
          *
@@ -117,7 +148,79 @@ namespace smrtobj
          */
         time_t time() { return m_time; };
 
+        /**
+         * Starts the clock mode: waits for the start of the next second of the RTC (at most one second, polling
+         * the seconds register) and then computes the current time from millis(), reading the
+         * RTC again every \e interval seconds. Until the drift is measured (\e DRIFT_MIN_SPAN seconds), the RTC
+         * is read every \e SYNC_INTERVAL_START seconds.
+         *
+         * \param[in] interval time between two readings of the RTC (seconds)
+         *
+         * \return true if the RTC has been read, false otherwise (clock mode is not started)
+         */
+        bool startClock(unsigned long interval = SYNC_INTERVAL);
+
+        /**
+         * Stops the clock mode. The drift measured is kept.
+         */
+        void stopClock() { m_clock = false; };
+
+        /**
+         * Checks if the clock mode is running.
+         *
+         * \return true if clock mode is running, false otherwise
+         */
+        bool isClockRunning() { return m_clock; };
+
+        /**
+         * Returns the current time as a 32 bit "time_t" number. In clock mode the time is computed from
+         * millis() and the RTC is read only when the sync interval is elapsed (if the reading fails, it is
+         * tried again after another interval); otherwise this is the last time read or written.
+         *
+         * \return current time
+         */
+        time_t now();
+
+        /**
+         * Reads the RTC and synchronizes the clock mode: the sub-second phase of the clock is kept if it
+         * agrees with the RTC, and the drift is updated when enough time is elapsed from the first reading.
+         *
+         * \return true for success, or false if any error occurs.
+         */
+        bool sync();
+
+        /**
+         * Returns the drift of the Arduino clock measured with respect to the RTC, in parts per million
+         * (positive if millis() is slower than the RTC).
+         *
+         * \return drift (ppm)
+         */
+        long drift() { return (long) (m_rate * 1000000.0); };
+
       private:
+        /**
+         * Gets the time elapsed from the last synchronization, corrected by the drift.
+         *
+         * \param[in] ms current value of millis()
+         *
+         * \return elapsed time (milliseconds)
+         */
+        unsigned long elapsed(unsigned long ms);
+
+        /**
+         * Sets the time base after a reading of the RTC. The error of the clock is estimated from the
+         * readings, and the time base is set in the middle of the possible range.
+         *
+         * \param[in] ms value of millis() at the reading
+         * \param[in] estimate milliseconds elapsed from the start of the second read, according to the clock
+         */
+        void align(unsigned long ms, long estimate);
+
+        /**
+         * Uses the current time base as reference to measure the drift.
+         */
+        void reference();
+
         /**
          * Writes the date and time, using value saved into a internal buffer. This is a 32 bit "time_t" number.
          * 
@@ -127,6 +230,42 @@ namespace smrtobj
 
         //! Internal buffer where last time read or written is stored.
         time_t m_time;
+
+        //! Clock mode running
+        bool m_clock;
+
+        //! Interval between two readings in clock mode (milliseconds)
+        unsigned long m_interval;
+
+        //! Time of the last synchronization
+        time_t m_base_time;
+
+        //! millis() at the start of the second m_base_time
+        unsigned long m_base_ms;
+
+        //! millis() at the last failed reading of the RTC by now() (m_base_ms after a successful one)
+        unsigned long m_retry_ms;
+
+        //! Time of the reading used as reference to measure the drift
+        time_t m_ref_time;
+
+        //! millis() at the reading used as reference to measure the drift
+        unsigned long m_ref_ms;
+
+        //! Drift correction (milliseconds to add for each millisecond elapsed)
+        float m_rate;
+
+        //! True if the drift has been measured
+        bool m_measured;
+
+        //! Minimum error of the clock (milliseconds)
+        int16_t m_lo;
+
+        //! Maximum error of the clock (milliseconds)
+        int16_t m_hi;
+
+        //! Range of the error of the clock at the reference reading (milliseconds)
+        int16_t m_ref_error;
     };
 
   } /* namespace i2c */
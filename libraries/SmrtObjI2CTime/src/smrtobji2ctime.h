@@ -15,5 +15,6 @@
 
 // Devices
 #include "devices/DS130RTC.h"  // RTC
+#include "devices/DS130NVRAMLog.h"  // RTC NV SRAM
 
 #endif /* SMRTOBJI2CTIME_H_ */
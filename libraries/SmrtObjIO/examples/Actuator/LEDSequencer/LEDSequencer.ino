@@ -0,0 +1,54 @@
+/*
+ * LEDSequencer.ino
+ * Checks three LEDs at boot, then runs a chase pattern for ever. The patterns
+ * run in background: the loop keeps reading the serial port while LEDs change.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <interval.h>
+#include <smrtobjio.h>
+
+// The digital actuators are LEDs
+smrtobj::io::DigitalActuator red;
+smrtobj::io::DigitalActuator yellow;
+smrtobj::io::DigitalActuator green;
+
+// Array of LEDs
+smrtobj::io::DigitalActuator *leds[3] = { &red, &yellow, &green };
+
+// Sequencer
+smrtobj::io::LEDSequencer sequencer;
+
+// true after the check
+bool checked = false;
+
+void setup() {
+  Serial.begin(9600);
+
+  // Initializes LEDs as connected to pin 5, 6 and 7
+  red.init(5);
+  yellow.init(6);
+  green.init(7);
+
+  // Switch on all LEDs for one second
+  sequencer.attach(leds, 3);
+  sequencer.check(1000);
+}
+
+void loop() {
+  // Advance the pattern
+  if ( !sequencer.update() && !checked )
+  {
+    // Check completed: one LED at a time for ever
+    checked = true;
+    sequencer.chase(250);
+  }
+
+  // Other tasks are not blocked
+  if ( Serial.available() )
+  {
+    Serial.write( Serial.read() );
+  }
+}
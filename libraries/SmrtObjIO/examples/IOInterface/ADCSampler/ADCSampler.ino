@@ -0,0 +1,39 @@
+/*
+ * ADCSampler.ino
+ * Reads two analog inputs (pin A0 and A1) converted in background by the ADC sampler
+ * and prints the result to the serial monitor.
+ * Reading an input does not wait for the conversion: it returns the latest sample.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <smrtobjio.h>
+
+// Analog inputs
+smrtobj::io::AnalogInput Pin0;
+smrtobj::io::AnalogInput Pin1;
+
+void setup(){
+  // Open serial monitor
+  Serial.begin(9600);
+  
+  // Initialize and open input pins: they are registered to the sampler
+  Pin0.init(A0);
+  Pin1.init(A1);
+
+  // Start background conversions
+  if ( !smrtobj::io::ADCSampler::start() )
+  {
+    Serial.println("ADC sampler not supported, using analogRead");
+  }
+}
+
+void loop(){
+  // Read and print values from analog inputs
+  Serial.print("A0: ");
+  Serial.print(Pin0.read());
+  Serial.print(" A1: ");
+  Serial.println(Pin1.read());
+  delay(1000);
+}
@@ -0,0 +1,43 @@
+/*
+ * DigitalOutputGroup.ino
+ * Drives a bar-graph of 8 LEDs (pins 2 - 9): every 200 ms one more LED is turned on,
+ * then all LEDs are turned off. All LEDs change at the same time.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <smrtobjio.h>
+
+// Number of LEDs
+const byte N_LEDS = 8;
+
+// Digital outputs
+smrtobj::io::DigitalOutput Leds[N_LEDS];
+
+// Group of outputs
+smrtobj::io::DigitalOutputGroup Bar;
+
+// Number of LEDs on
+byte level = 0;
+
+void setup(){
+  // Initialize the pins of the digital outputs and attach them to the group
+  for (byte i = 0; i < N_LEDS; i++)
+  {
+    Leds[i].init(2 + i);
+    Bar.attach(Leds[i], i);
+  }
+}
+
+void loop(){
+  // Turn on the first 'level' LEDs
+  Bar.write( (1 << level) - 1 );
+
+  level++;
+  if (level > N_LEDS)
+  {
+    level = 0;
+  }
+  delay(200);  
+}
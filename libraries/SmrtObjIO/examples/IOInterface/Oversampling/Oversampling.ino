@@ -0,0 +1,43 @@
+/*
+ * Oversampling.ino
+ * Reads an analog input on pin 0 with 12 bits of resolution, prints the result to the serial monitor.
+ * Every value is the sum of 16 conversions, added in background by the ADC interrupt and decimated
+ * to 12 bits.
+ * Attach the center pin of a potentiometer to pin A0, and the outside pins to +5V and ground.
+ * Oversampling needs some noise on the input (at least 1 LSB): with a very stable input the extra
+ * bits do not change.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <smrtobjio.h>
+
+// Analog input
+smrtobj::io::AnalogInput Pin;
+
+void setup(){
+  // Open serial monitor
+  Serial.begin(9600);
+  
+  // Initialize and open input pin, 2 extra bits (4^2 = 16 conversions)
+  Pin.init(0);
+  Pin.setOversampling(2);
+
+  // Convert in background
+  if ( !smrtobj::io::ADCSampler::start() )
+  {
+    Serial.println("Sampler not supported, using analogRead");
+  }
+}
+
+void loop(){
+  // Read and print value from analog input
+  Serial.print("Value (");
+  Serial.print(Pin.resolution());
+  Serial.print(" bits): ");
+  Serial.println(Pin.read());
+  Serial.print("Voltage: ");
+  Serial.println(Pin.inputVoltage(), 4);
+  delay(1000);
+}
@@ -0,0 +1,72 @@
+/*
+ * Calibration.ino
+ * Reads a Linear Active Thermistor sensor (MCP9700A) connected to the analog input A0 and corrects the
+ * temperature with a calibration table stored in EEPROM, then prints the result to the serial monitor.
+ * 
+ * The first time, the table is not in EEPROM: a two points table is created and saved. To calibrate
+ * a unit, measure the temperature with a reference thermometer at two (or more) temperatures and write
+ * the points on the serial monitor as:
+ *   x1 y1 x2 y2 ...
+ * where x is the temperature read by the sensor and y the reference temperature. The new table is
+ * saved in EEPROM and used at the next boot.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <smrtobjio.h>
+
+//! EEPROM address of the table
+#define TABLE_ADDRESS 0
+
+smrtobj::io::MCP9700A temperature;
+smrtobj::io::CalibrationTable table;
+
+void setup() {
+  Serial.begin(9600);
+
+  if ( !table.load(TABLE_ADDRESS) )
+  {
+    // Not calibrated: the table does not change the values
+    float x[] = { 0.0, 100.0 };
+    float y[] = { 0.0, 100.0 };
+
+    table.setPoints(x, y, 2);
+    table.save(TABLE_ADDRESS);
+    Serial.println("New calibration table");
+  }
+
+  // Initialize sensor
+  temperature.init(A0);
+  temperature.setCalibrationTable(&table);
+}
+
+void loop() {
+  float x[smrtobj::io::CalibrationTable::MAX_POINTS];
+  float y[smrtobj::io::CalibrationTable::MAX_POINTS];
+  byte n = 0;
+
+  // New points from serial monitor
+  while ( Serial.available() && n < smrtobj::io::CalibrationTable::MAX_POINTS )
+  {
+    x[n] = Serial.parseFloat();
+    y[n] = Serial.parseFloat();
+    n++;
+  }
+
+  if (n > 0)
+  {
+    if ( table.setPoints(x, y, n) && table.save(TABLE_ADDRESS) )
+    {
+      Serial.println("Calibration saved");
+    }
+    else
+    {
+      Serial.println("Invalid points");
+    }
+  }
+
+  Serial.print("Celsius: ");
+  Serial.println(temperature.read());
+  delay(5000);
+}
@@ -0,0 +1,63 @@
+/*
+ * Scheduler.ino
+ * Reads a Linear Active Thermistor sensor (MCP9700A) on the analog input A0 every second and a generic
+ * analog sensor on A1 every 250 milliseconds, without blocking the main loop. Every new measurement is
+ * printed to the serial monitor with its timestamp. The led on pin 13 is toggled by a task scheduled on
+ * the same timer wheel of the sensors.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <smrtobjio.h>
+
+smrtobj::io::MCP9700A temperature;
+smrtobj::io::AnalogSensor voltage;
+
+smrtobj::io::SensorScheduler scheduler;
+
+/**
+ * Prints a new measurement.
+ */
+void publish(smrtobj::io::SensorJob &job)
+{
+  Serial.print(job.timestamp());
+  Serial.print(" ");
+  Serial.print((const char *) job.context());
+  Serial.print(": ");
+  Serial.println(job.value());
+}
+
+/**
+ * Toggles the led.
+ */
+void blink(smrtobj::timer::TimerTask &t)
+{
+  digitalWrite(13, !digitalRead(13));
+}
+
+smrtobj::io::SensorJob jt(temperature, 1000, publish, (void *) "Celsius");
+smrtobj::io::SensorJob jv(voltage, 250, publish, (void *) "Volt");
+smrtobj::timer::TimerTask led(blink);
+
+void setup() {
+  Serial.begin(9600);
+  pinMode(13, OUTPUT);
+
+  // Initialize sensors
+  temperature.init(A0);
+  voltage.init(A1);
+
+  // The sensor needs some time after power on
+  jt.setWarmup(500);
+
+  scheduler.add(jt);
+  scheduler.add(jv);
+  scheduler.wheel().start(led, 0, 500);
+}
+
+void loop() {
+  scheduler.poll();
+
+  // Other work, never blocked by the sensors
+}
@@ -42,6 +42,10 @@ void setup() {
   Serial.println(temperature.kelvin());
   Serial.print("Farenheit: ");
   Serial.println(temperature.farenheit());
+
+  // Integer conversion, without floating point operations
+  Serial.print("Centi-celsius: ");
+  Serial.println(temperature.readCentiCelsius());
 }
 
 void loop() {
@@ -0,0 +1,187 @@
+/**
+ * \file ledsequencer.cpp
+ * \brief  LEDSequencer runs check, blink and chase patterns on an array of LEDs without blocking
+ *         the main loop.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "ledsequencer.h"
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    LEDSequencer::LEDSequencer() :
+        m_leds(0),
+        m_size(0),
+        m_pattern(PATTERN_NONE),
+        m_mask(0),
+        m_step(0),
+        m_steps(0),
+        m_period(0)
+    {
+    }
+
+    LEDSequencer::LEDSequencer(const LEDSequencer &s)
+    {
+      (*this) = s;
+    }
+
+    LEDSequencer::~LEDSequencer()
+    {
+    }
+
+    LEDSequencer & LEDSequencer::operator=(const LEDSequencer &s)
+    {
+      m_leds = s.m_leds;
+      m_size = s.m_size;
+      m_pattern = s.m_pattern;
+      m_mask = s.m_mask;
+      m_step = s.m_step;
+      m_steps = s.m_steps;
+      m_period = s.m_period;
+      m_interval = s.m_interval;
+
+      return (*this);
+    }
+
+    bool LEDSequencer::attach(DigitalActuator** ledsArray, byte size)
+    {
+      if (!ledsArray || size == 0 || size > MAX_LEDS)
+      {
+        return false;
+      }
+
+      m_pattern = PATTERN_NONE;
+      m_leds = ledsArray;
+      m_size = size;
+
+      return true;
+    }
+
+    bool LEDSequencer::check(unsigned long time)
+    {
+      // Step 0: all LEDs on; step 1: all LEDs off
+      return start(PATTERN_CHECK, time, 1);
+    }
+
+    bool LEDSequencer::blink(uint16_t mask, unsigned long period, byte count)
+    {
+      m_mask = mask;
+
+      return start(PATTERN_BLINK, period, 2 * count);
+    }
+
+    bool LEDSequencer::chase(unsigned long period, byte count)
+    {
+      return start(PATTERN_CHASE, period, (unsigned int) m_size * count);
+    }
+
+    bool LEDSequencer::start(byte pattern, unsigned long period, unsigned int steps)
+    {
+      if (!m_leds)
+      {
+        return false;
+      }
+
+      m_pattern = pattern;
+      m_period = period;
+      m_steps = steps;
+      m_step = 0;
+      m_interval.update();
+
+      apply();
+
+      return true;
+    }
+
+    void LEDSequencer::stop()
+    {
+      if (m_leds)
+      {
+        write(0);
+      }
+
+      m_pattern = PATTERN_NONE;
+    }
+
+    bool LEDSequencer::update(unsigned long tref)
+    {
+      if (m_pattern == PATTERN_NONE)
+      {
+        return false;
+      }
+
+      if (m_interval.time(tref) < m_period)
+      {
+        return true;
+      }
+
+      m_interval.reset(tref);
+
+      if (m_steps != 0 && ++m_step >= m_steps)
+      {
+        stop();
+
+        return false;
+      }
+
+      // Patterns running for ever repeat their cycle
+      if (m_steps == 0 && ++m_step == ( (m_pattern == PATTERN_CHASE) ? m_size : 2 ))
+      {
+        m_step = 0;
+      }
+
+      apply();
+
+      return true;
+    }
+
+    void LEDSequencer::apply()
+    {
+      switch (m_pattern)
+      {
+        case PATTERN_CHECK:
+        {
+          write(0xFFFF);
+        }
+          break;
+        case PATTERN_BLINK:
+        {
+          write( (m_step & 0x01) ? 0 : m_mask );
+        }
+          break;
+        case PATTERN_CHASE:
+        {
+          write( 1 << (m_step % m_size) );
+        }
+          break;
+      }
+    }
+
+    void LEDSequencer::write(uint16_t state)
+    {
+      for (byte i = 0; i < m_size; i++)
+      {
+        if (!m_leds[i])
+        {
+          continue;
+        }
+
+        if ( bitRead(state, i) )
+        {
+          m_leds[i]->on();
+        }
+        else
+        {
+          m_leds[i]->off();
+        }
+      }
+    }
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
@@ -0,0 +1,225 @@
+/**
+ * \file ledsequencer.h
+ * \brief  LEDSequencer runs check, blink and chase patterns on an array of LEDs without blocking
+ *         the main loop.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef LEDSEQUENCER_H_
+#define LEDSEQUENCER_H_
+
+#include <Arduino.h>
+#include <interval.h>
+#include "actuator/digitalactuator.h"
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    /**
+     * The LEDSequencer class runs patterns on an array of LEDs (digital actuators) as a timed state machine:
+     * a pattern is started by smrtobj::io::LEDSequencer::check, smrtobj::io::LEDSequencer::blink or
+     * smrtobj::io::LEDSequencer::chase and the main loop advances it calling
+     * smrtobj::io::LEDSequencer::update. Nothing waits, so the other tasks of the loop keep running.
+     *
+     * Patterns:
+     * - \b check: all LEDs are switched on for a given time, then switched off (see smrtobj::io::LEDArray::check);
+     * - \b blink: the LEDs of a mask are switched on and off;
+     * - \b chase: one LED at a time is switched on, from the first to the last.
+     *
+     * The LED states are written only when a step begins. At the end of the pattern all LEDs are switched off.
+     *
+     * \code{.cpp}
+     * smrtobj::io::DigitalActuator *leds[3] = { &red, &yellow, &green };
+     * smrtobj::io::LEDSequencer seq;
+     *
+     * seq.attach(leds, 3);
+     * seq.chase(200, 5);
+     *
+     * void loop()
+     * {
+     *   seq.update();
+     *   ...
+     * }
+     * \endcode
+     */
+    class LEDSequencer
+    {
+      public:
+        /**
+         * Patterns
+         */
+        enum _pattern
+        {
+          //! No pattern running
+          PATTERN_NONE = 0,
+
+          //! All LEDs on for a given time
+          PATTERN_CHECK = 1,
+
+          //! LEDs switched on and off
+          PATTERN_BLINK = 2,
+
+          //! One LED at a time
+          PATTERN_CHASE = 3,
+        };
+
+        //! Maximum number of LEDs
+        static const byte MAX_LEDS = 16;
+
+        /**
+         * Default Constructor.
+         * It creates a sequencer without LEDs.
+         */
+        LEDSequencer();
+
+        /**
+         * Copy constructor.
+         *
+         * \param[in] s source sequencer
+         *
+         */
+        LEDSequencer(const LEDSequencer &s);
+
+        /**
+         * Destructor.
+         *
+         */
+        virtual ~LEDSequencer();
+
+        /**
+         * Override operator =
+         *
+         * \param[in] s source sequencer
+         *
+         * \return reference to the destination sequencer
+         */
+        LEDSequencer & operator=(const LEDSequencer &s);
+
+        /**
+         * Attaches an array of LEDs. The running pattern is stopped. Null pointers in the array are skipped.
+         *
+         * \param[in] ledsArray pointer to the LED array
+         * \param[in] size size of the LED array (up to MAX_LEDS)
+         *
+         * \return true if no errors, false otherwise
+         */
+        bool attach(DigitalActuator** ledsArray, byte size);
+
+        /**
+         * Starts the check pattern: all LEDs are switched on for \c time milliseconds, then switched off.
+         *
+         * \param[in] time time with all LEDs on (milliseconds)
+         *
+         * \return true if the pattern has been started, false if there are no LEDs
+         */
+        bool check(unsigned long time);
+
+        /**
+         * Starts the blink pattern: the LEDs of the mask are switched on for \c period milliseconds, then
+         * off for \c period milliseconds. The other LEDs are off.
+         *
+         * \param[in] mask LEDs to blink (bit i is the LED i)
+         * \param[in] period time on and time off (milliseconds)
+         * \param[in] count number of blinks, 0 for ever
+         *
+         * \return true if the pattern has been started, false if there are no LEDs
+         */
+        bool blink(uint16_t mask, unsigned long period, byte count = 0);
+
+        /**
+         * Starts the chase pattern: every \c period milliseconds the next LED is switched on and the others
+         * are switched off.
+         *
+         * \param[in] period time of each LED (milliseconds)
+         * \param[in] count number of sequences (from the first LED to the last), 0 for ever
+         *
+         * \return true if the pattern has been started, false if there are no LEDs
+         */
+        bool chase(unsigned long period, byte count = 0);
+
+        /**
+         * Stops the running pattern and switches all LEDs off.
+         */
+        void stop();
+
+        /**
+         * Advances the running pattern. It has to be called in the main loop, as often as possible.
+         *
+         * \param[in] tref external reference time, if 0 use system time
+         *
+         * \return true if a pattern is running, false otherwise
+         */
+        bool update(unsigned long tref = 0);
+
+        /**
+         * Checks if a pattern is running
+         *
+         * \return true if a pattern is running, false otherwise
+         */
+        bool isRunning() const { return (m_pattern != PATTERN_NONE); }
+
+        /**
+         * Gets the running pattern
+         *
+         * \return pattern according to smrtobj::io::LEDSequencer::_pattern enum
+         */
+        byte pattern() const { return m_pattern; }
+
+      private:
+        /**
+         * Starts a pattern.
+         *
+         * \param[in] pattern pattern according to _pattern enum
+         * \param[in] period time of each step (milliseconds)
+         * \param[in] steps number of steps, 0 for ever
+         *
+         * \return true if the pattern has been started, false if there are no LEDs
+         */
+        bool start(byte pattern, unsigned long period, unsigned int steps);
+
+        /**
+         * Writes the LEDs of a step.
+         */
+        void apply();
+
+        /**
+         * Switches LEDs on or off.
+         *
+         * \param[in] state new state (bit i is the LED i)
+         */
+        void write(uint16_t state);
+
+        //! LEDs
+        DigitalActuator** m_leds;
+
+        //! Number of LEDs
+        byte m_size;
+
+        //! Running pattern
+        byte m_pattern;
+
+        //! LEDs used by the blink pattern
+        uint16_t m_mask;
+
+        //! Current step
+        unsigned int m_step;
+
+        //! Number of steps, 0 for ever
+        unsigned int m_steps;
+
+        //! Time of each step (milliseconds)
+        unsigned long m_period;
+
+        //! Start of the current step
+        smrtobj::timer::Interval m_interval;
+    };
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
+
+#endif /* LEDSEQUENCER_H_ */
@@ -0,0 +1,302 @@
+/**
+ * \file adcsampler.cpp
+ * \brief Interrupt-driven sampler of the analog inputs: the ADC converts the registered channels in
+ *        round-robin from its conversion complete interrupt.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "adcsampler.h"
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#endif
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    /**********************************************************************************
+     * ADCSampler
+     **********************************************************************************/
+    byte ADCSampler::m_channel[MAX_CHANNELS] = {0};
+    volatile byte ADCSampler::m_count = 0;
+    volatile byte ADCSampler::m_current = 0;
+    volatile uint16_t ADCSampler::m_samples[MAX_CHANNELS][SAMPLES];
+    volatile byte ADCSampler::m_head[MAX_CHANNELS] = {0};
+    byte ADCSampler::m_tail[MAX_CHANNELS] = {0};
+    volatile byte ADCSampler::m_ready = 0;
+    volatile byte ADCSampler::m_shift[MAX_CHANNELS] = {0};
+    volatile uint32_t ADCSampler::m_sum[MAX_CHANNELS] = {0};
+    volatile uint16_t ADCSampler::m_left[MAX_CHANNELS] = {0};
+    volatile uint16_t ADCSampler::m_result[MAX_CHANNELS] = {0};
+    volatile byte ADCSampler::m_decimated = 0;
+    byte ADCSampler::m_reference = DEFAULT;
+    volatile bool ADCSampler::m_running = false;
+
+    byte ADCSampler::channel(byte pin)
+    {
+#if defined(analogPinToChannel)
+#if defined(__AVR_ATmega32U4__)
+      if (pin >= 18) pin -= 18;
+#endif
+      return analogPinToChannel(pin);
+#else
+      if (pin >= A0) pin -= A0;
+      return pin;
+#endif
+    }
+
+    byte ADCSampler::attach(byte pin)
+    {
+      byte ch = channel(pin);
+
+      for (byte i = 0; i < m_count; i++)
+      {
+        if (m_channel[i] == ch)
+        {
+          return i;
+        }
+      }
+
+      if (m_count >= MAX_CHANNELS)
+      {
+        return NO_SLOT;
+      }
+
+      // The channel is written before the interrupt can see the new slot
+      m_channel[m_count] = ch;
+      m_head[m_count] = 0;
+      m_tail[m_count] = 0;
+      m_shift[m_count] = 0;
+
+      return m_count++;
+    }
+
+    void ADCSampler::select(byte ch)
+    {
+#if defined(ADMUX)
+#if defined(MUX5)
+      ADCSRB = (ADCSRB & ~_BV(MUX5)) | (((ch >> 3) & 0x01) << MUX5);
+#endif
+      ADMUX = (m_reference << 6) | (ch & 0x07);
+#else
+      (void) ch;
+#endif
+    }
+
+    bool ADCSampler::start(byte reference)
+    {
+#if defined(ADCSRA) && defined(ADC_vect)
+      if (m_count == 0)
+      {
+        return false;
+      }
+
+      if (m_running)
+      {
+        return true;
+      }
+
+      m_reference = reference;
+      m_current = 0;
+      m_ready = 0;
+      m_decimated = 0;
+      for (byte i = 0; i < MAX_CHANNELS; i++)
+      {
+        m_tail[i] = m_head[i];
+        m_sum[i] = 0;
+        m_left[i] = 1 << (m_shift[i] << 1);
+      }
+
+      select(m_channel[0]);
+
+      // Single conversions (no auto trigger) restarted by the interrupt
+      m_running = true;
+      ADCSRA = (ADCSRA & ~_BV(ADATE)) | _BV(ADEN) | _BV(ADIE) | _BV(ADIF);
+      ADCSRA |= _BV(ADSC);
+
+      return true;
+#else
+      (void) reference;
+      return false;
+#endif
+    }
+
+    void ADCSampler::stop()
+    {
+#if defined(ADCSRA) && defined(ADC_vect)
+      if (!m_running)
+      {
+        return;
+      }
+
+      ADCSRA &= ~_BV(ADIE);
+      while ( ADCSRA & _BV(ADSC) )
+        ;
+      ADCSRA |= _BV(ADIF);
+
+      m_running = false;
+#endif
+    }
+
+    byte ADCSampler::available(byte slot)
+    {
+      if (slot >= m_count)
+      {
+        return 0;
+      }
+
+      byte n = m_head[slot] - m_tail[slot];
+
+      if (n > SAMPLES)
+      {
+        // Oldest samples have been overwritten
+        m_tail[slot] = m_head[slot] - SAMPLES;
+        n = SAMPLES;
+      }
+
+      return n;
+    }
+
+    bool ADCSampler::pop(byte slot, uint16_t &value)
+    {
+#if defined(__AVR__)
+      // When the ring is full the interrupt writes the slot of the tail: it must not change the sample
+      // (16 bits) or the head while it is read
+      uint8_t oldSREG = SREG;
+      cli();
+#endif
+
+      bool ok = ( available(slot) > 0 );
+
+      if (ok)
+      {
+        value = m_samples[slot][m_tail[slot] & (SAMPLES - 1)];
+        m_tail[slot]++;
+      }
+
+#if defined(__AVR__)
+      SREG = oldSREG;
+#endif
+
+      return ok;
+    }
+
+    bool ADCSampler::latest(byte slot, uint16_t &value)
+    {
+      if ( slot >= m_count || !(m_ready & (1 << slot)) )
+      {
+        return false;
+      }
+
+      // The slot is overwritten only after SAMPLES conversions of this channel
+      byte h = m_head[slot];
+      value = m_samples[slot][(byte) (h - 1) & (SAMPLES - 1)];
+
+      return true;
+    }
+
+    bool ADCSampler::setOversampling(byte slot, byte bits)
+    {
+      if (slot >= m_count || bits > MAX_OVERSAMPLING)
+      {
+        return false;
+      }
+
+#if defined(__AVR__)
+      // The interrupt must not see a partial update
+      uint8_t oldSREG = SREG;
+      cli();
+#endif
+
+      m_shift[slot] = bits;
+      m_sum[slot] = 0;
+      m_left[slot] = 1 << (bits << 1);
+      m_decimated &= ~(1 << slot);
+
+#if defined(__AVR__)
+      SREG = oldSREG;
+#endif
+
+      return true;
+    }
+
+    byte ADCSampler::oversampling(byte slot)
+    {
+      if (slot >= m_count)
+      {
+        return 0;
+      }
+
+      return m_shift[slot];
+    }
+
+    bool ADCSampler::decimated(byte slot, uint16_t &value)
+    {
+      if ( slot >= m_count || !(m_decimated & (1 << slot)) )
+      {
+        return false;
+      }
+
+#if defined(__AVR__)
+      // 16 bits are written by the interrupt
+      uint8_t oldSREG = SREG;
+      cli();
+      value = m_result[slot];
+      SREG = oldSREG;
+#else
+      value = m_result[slot];
+#endif
+
+      return true;
+    }
+
+    void ADCSampler::isr()
+    {
+#if defined(ADCSRA) && defined(ADC_vect)
+      // ADCL must be read first
+      uint16_t v = ADCL;
+      v |= (ADCH << 8);
+
+      byte s = m_current;
+      m_samples[s][m_head[s] & (SAMPLES - 1)] = v;
+      m_head[s]++;
+      m_ready |= (1 << s);
+
+      if (m_shift[s])
+      {
+        m_sum[s] += v;
+
+        if (--m_left[s] == 0)
+        {
+          m_result[s] = m_sum[s] >> m_shift[s];
+          m_decimated |= (1 << s);
+          m_sum[s] = 0;
+          m_left[s] = 1 << (m_shift[s] << 1);
+        }
+      }
+
+      if (++s >= m_count)
+      {
+        s = 0;
+      }
+      m_current = s;
+
+      select(m_channel[s]);
+      ADCSRA |= _BV(ADSC);
+#endif
+    }
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
+
+#if defined(ADCSRA) && defined(ADC_vect)
+ISR(ADC_vect)
+{
+  smrtobj::io::ADCSampler::isr();
+}
+#endif
@@ -0,0 +1,250 @@
+/**
+ * \file adcsampler.h
+ * \brief Interrupt-driven sampler of the analog inputs: the ADC converts the registered channels in
+ *        round-robin from its conversion complete interrupt.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef ADCSAMPLER_H_
+#define ADCSAMPLER_H_
+
+#if ARDUINO >= 100
+#include "Arduino.h"       // for delayMicroseconds, digitalPinToBitMask, etc
+#else
+#include "WProgram.h"      // for delayMicroseconds
+#include "pins_arduino.h"  // for digitalPinToBitMask, etc
+#endif
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    /**
+     * The ADCSampler class runs the ADC in background. Every conversion is started by the conversion
+     * complete interrupt of the previous one, moving to the next registered channel, so the analog inputs
+     * are sampled continuously without stalling the main loop (\b analogRead waits about 110 microseconds
+     * for each conversion). With the default ADC clock (125 kHz) about 9600 conversions per second are
+     * shared among the channels.
+     *
+     * Channels are registered by smrtobj::io::AnalogInput::init (or by smrtobj::io::ADCSampler::attach) and
+     * every channel has a ring buffer of \e SAMPLES samples. The interrupt only writes the samples and the
+     * head of the ring, the loop only moves the tail. When the ring is full the next conversion overwrites
+     * the oldest sample, so smrtobj::io::ADCSampler::pop reads it with interrupts disabled (a few cycles).
+     * While the sampler is running, smrtobj::io::AnalogInput::read returns the latest sample of its
+     * channel.
+     *
+     * \b Note: \n
+     * The sampler works only on AVR boards; on other boards smrtobj::io::ADCSampler::start returns false
+     * and analog inputs keep using \b analogRead.\n
+     * The library defines the ADC interrupt handler (\b ISR(ADC_vect)) on AVR boards. AnalogInput uses the
+     * sampler, so the handler is linked in every sketch that uses SmrtObjIO: a sketch or an other library
+     * cannot define its own ADC_vect handler (the link fails with a multiple definition of
+     * \b __vector_21 on the ATmega328P).\n
+     * Do not call \b analogRead while the sampler is running. The reference voltage is set by smrtobj::io::ADCSampler::start: it must be the same mode
+     * used by \b analogReference.\n
+     * The first conversion after a channel switch can be inaccurate with high impedance sources
+     * (more than 10 kOhm).
+     *
+     * A channel can be oversampled (see smrtobj::io::ADCSampler::setOversampling): the interrupt adds
+     * 4^k conversions and decimates the sum to 10 + k bits, so no conversion is lost whatever the rate of
+     * the main loop is. Oversampling gains resolution only if the input has at least 1 LSB of noise;
+     * each decimated sample takes 4^k conversions of the round-robin.
+     *
+     * \code{.cpp}
+     * smrtobj::io::AnalogInput a0;
+     * smrtobj::io::AnalogInput a1;
+     *
+     * a0.init(A0);
+     * a1.init(A1);
+     * smrtobj::io::ADCSampler::start();
+     * ...
+     * unsigned long v = a0.read();    // it does not wait for the conversion
+     * \endcode
+     */
+    class ADCSampler
+    {
+      public:
+        /**
+         * Limits of the sampler.
+         */
+        enum _adc_limits
+        {
+          //! Maximum number of channels sampled
+          MAX_CHANNELS = 8,
+
+          //! Number of samples stored for each channel (power of 2)
+          SAMPLES = 4,
+
+          //! Invalid slot
+          NO_SLOT = 0xFF,
+
+          //! Maximum number of extra bits given by oversampling (4^6 samples, 16 bits)
+          MAX_OVERSAMPLING = 6,
+        };
+
+        /**
+         * Registers an analog pin. If the pin is already registered, it returns the same slot.
+         *
+         * \param[in] pin analog pin (channel number or Ax pin number)
+         *
+         * \return slot of the channel, NO_SLOT if all slots are used
+         */
+        static byte attach(byte pin);
+
+        /**
+         * Starts the conversions of the registered channels.
+         *
+         * \param[in] reference reference mode (DEFAULT, INTERNAL, EXTERNAL, ...) as used by \b analogReference
+         *
+         * \return true if the sampler is running, false if there are no channels or the board is not supported
+         */
+        static bool start(byte reference = DEFAULT);
+
+        /**
+         * Stops the conversions, waiting for the end of the current one. After stop, \b analogRead can be
+         * used again.
+         */
+        static void stop();
+
+        /**
+         * Checks if the sampler is running.
+         *
+         * \return true if it is running, false otherwise
+         */
+        static bool isRunning() { return m_running; }
+
+        /**
+         * Gets the number of samples of a channel that have not been read by smrtobj::io::ADCSampler::pop.
+         * Samples older than the last \e SAMPLES are lost.
+         *
+         * \param[in] slot slot of the channel
+         *
+         * \return number of samples available (0 - SAMPLES)
+         */
+        static byte available(byte slot);
+
+        /**
+         * Reads the oldest sample of a channel not read yet.
+         *
+         * \param[in] slot slot of the channel
+         * \param[out] value sample (0 - 1023)
+         *
+         * \return true if a sample has been read, false if there are no new samples
+         */
+        static bool pop(byte slot, uint16_t &value);
+
+        /**
+         * Gets the latest sample of a channel. It does not change the samples available.
+         *
+         * \param[in] slot slot of the channel
+         * \param[out] value sample (0 - 1023)
+         *
+         * \return true if the channel has been converted at least once after start, false otherwise
+         */
+        static bool latest(byte slot, uint16_t &value);
+
+        /**
+         * Sets the oversampling of a channel: the interrupt adds 4^bits conversions and returns their sum
+         * shifted right by \e bits. The decimated sample is read with smrtobj::io::ADCSampler::decimated.
+         *
+         * \param[in] slot slot of the channel
+         * \param[in] bits extra bits of resolution (0 to disable, up to MAX_OVERSAMPLING)
+         *
+         * \return false if the slot or the number of bits are not valid, true otherwise
+         */
+        static bool setOversampling(byte slot, byte bits);
+
+        /**
+         * Gets the oversampling of a channel.
+         *
+         * \param[in] slot slot of the channel
+         *
+         * \return extra bits of resolution, 0 if the channel is not oversampled
+         */
+        static byte oversampling(byte slot);
+
+        /**
+         * Gets the latest decimated sample of an oversampled channel.
+         *
+         * \param[in] slot slot of the channel
+         * \param[out] value decimated sample (0 - 2^(10 + bits) - 1)
+         *
+         * \return true if a decimated sample is available, false otherwise (e.g. not enough
+         *         conversions since start or since the oversampling has been changed)
+         */
+        static bool decimated(byte slot, uint16_t &value);
+
+        /**
+         * Stores the result of the conversion and starts the next one. It is called by the ADC interrupt:
+         * do not call it.
+         */
+        static void isr();
+
+      private:
+        /**
+         * Gets the ADC channel of an analog pin.
+         *
+         * \param[in] pin analog pin (channel number or Ax pin number)
+         *
+         * \return ADC channel
+         */
+        static byte channel(byte pin);
+
+        /**
+         * Selects the channel to convert.
+         *
+         * \param[in] ch ADC channel
+         */
+        static void select(byte ch);
+
+        //! ADC channel of each slot
+        static byte m_channel[MAX_CHANNELS];
+
+        //! Number of slots used
+        static volatile byte m_count;
+
+        //! Slot converted
+        static volatile byte m_current;
+
+        //! Samples of each slot
+        static volatile uint16_t m_samples[MAX_CHANNELS][SAMPLES];
+
+        //! Number of samples written in each slot (modulo 256), written only by the interrupt
+        static volatile byte m_head[MAX_CHANNELS];
+
+        //! Number of samples read from each slot (modulo 256), written only by the loop
+        static byte m_tail[MAX_CHANNELS];
+
+        //! Slots converted at least once (one bit per slot)
+        static volatile byte m_ready;
+
+        //! Oversampling bits of each slot
+        static volatile byte m_shift[MAX_CHANNELS];
+
+        //! Sum of the conversions of each oversampled slot
+        static volatile uint32_t m_sum[MAX_CHANNELS];
+
+        //! Conversions to add before the next decimated sample
+        static volatile uint16_t m_left[MAX_CHANNELS];
+
+        //! Latest decimated sample of each slot
+        static volatile uint16_t m_result[MAX_CHANNELS];
+
+        //! Slots with a decimated sample (one bit per slot)
+        static volatile byte m_decimated;
+
+        //! Reference mode
+        static byte m_reference;
+
+        //! true if the sampler is running
+        static volatile bool m_running;
+    };
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
+
+#endif /* ADCSAMPLER_H_ */
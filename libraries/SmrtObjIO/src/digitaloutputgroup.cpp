@@ -0,0 +1,177 @@
+/**
+ * \file digitaloutputgroup.cpp
+ * \brief Group of digital outputs changed at the same time, with one register write per port.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "digitaloutputgroup.h"
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    /**********************************************************************************
+     * DigitalOutputGroup
+     **********************************************************************************/
+    DigitalOutputGroup::DigitalOutputGroup() : m_nports(0), m_value(0)
+    {
+      for (byte i = 0; i < MAX_OUTPUTS; i++)
+      {
+        m_outputs[i] = 0;
+        m_port[i] = 0xFF;
+      }
+    }
+
+    DigitalOutputGroup::DigitalOutputGroup(const DigitalOutputGroup &g)
+    {
+      (*this) = g;
+    }
+
+    DigitalOutputGroup::~DigitalOutputGroup()
+    {
+    }
+
+    DigitalOutputGroup & DigitalOutputGroup::operator=(const DigitalOutputGroup &g)
+    {
+      for (byte i = 0; i < MAX_OUTPUTS; i++)
+      {
+        m_outputs[i] = g.m_outputs[i];
+        m_port[i] = g.m_port[i];
+      }
+
+      for (byte i = 0; i < MAX_PORTS; i++)
+      {
+        m_regs[i] = g.m_regs[i];
+        m_masks[i] = g.m_masks[i];
+      }
+
+      m_nports = g.m_nports;
+      m_value = g.m_value;
+
+      return (*this);
+    }
+
+    bool DigitalOutputGroup::attach(DigitalOutput &o, byte pos)
+    {
+      if (pos >= MAX_OUTPUTS || !o.isOpen())
+      {
+        return false;
+      }
+
+      DigitalOutput *old = m_outputs[pos];
+      m_outputs[pos] = &o;
+
+      if ( !update() )
+      {
+        m_outputs[pos] = old;
+        update();
+
+        return false;
+      }
+
+      return true;
+    }
+
+    void DigitalOutputGroup::detach(byte pos)
+    {
+      if (pos < MAX_OUTPUTS)
+      {
+        m_outputs[pos] = 0;
+        update();
+      }
+    }
+
+    bool DigitalOutputGroup::update()
+    {
+      m_nports = 0;
+
+      for (byte i = 0; i < MAX_OUTPUTS; i++)
+      {
+        m_port[i] = 0xFF;
+
+        if (!m_outputs[i] || !m_outputs[i]->m_reg)
+        {
+          continue;
+        }
+
+        byte p = 0;
+        while (p < m_nports && m_regs[p] != m_outputs[i]->m_reg)
+        {
+          p++;
+        }
+
+        if (p == m_nports)
+        {
+          if (m_nports == MAX_PORTS)
+          {
+            return false;
+          }
+
+          m_regs[p] = m_outputs[i]->m_reg;
+          m_masks[p] = 0;
+          m_nports++;
+        }
+
+        m_masks[p] |= m_outputs[i]->m_mask;
+        m_port[i] = p;
+      }
+
+      return true;
+    }
+
+    bool DigitalOutputGroup::write(uint16_t state)
+    {
+      uint8_t bits[MAX_PORTS] = {0};
+      bool empty = true;
+
+      // New levels are calculated before touching the registers
+      for (byte i = 0; i < MAX_OUTPUTS; i++)
+      {
+        DigitalOutput *o = m_outputs[i];
+
+        if (!o)
+        {
+          continue;
+        }
+
+        empty = false;
+        o->m_value = bitRead(state, i);
+
+        if (m_port[i] == 0xFF)
+        {
+          digitalWrite(o->m_pin, o->m_value);
+        }
+        else if (o->m_value)
+        {
+          bits[m_port[i]] |= o->m_mask;
+        }
+      }
+
+      if (empty)
+      {
+        return false;
+      }
+
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+
+      for (byte p = 0; p < m_nports; p++)
+      {
+        *m_regs[p] = (*m_regs[p] & ~m_masks[p]) | bits[p];
+      }
+
+      SREG = oldSREG;
+#endif
+
+      m_value = state;
+
+      return true;
+    }
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
@@ -0,0 +1,157 @@
+/**
+ * \file digitaloutputgroup.h
+ * \brief Group of digital outputs changed at the same time, with one register write per port.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef DIGITALOUTPUTGROUP_H_
+#define DIGITALOUTPUTGROUP_H_
+
+#include <Arduino.h>
+#include "iosignal.h"
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    /**
+     * The DigitalOutputGroup class changes a set of digital outputs (e.g. the segments of a display or
+     * the LEDs of a bar-graph) at the same time. Every output is attached to a bit of the group state;
+     * when the group is written, the new levels of all the outputs on the same port are applied with a
+     * single write of the port register, so they change in the same cycle and the cost of the update is
+     * about the same of a single output.
+     *
+     * Ports are resolved when outputs are attached, so outputs must be initialized
+     * (smrtobj::io::DigitalOutput::init) before.
+     *
+     * \b Note: \n
+     * Bits of the state are the levels of the outputs (1: HIGH, 0: LOW), the logic of a
+     * smrtobj::io::DigitalActuator is not applied and its state is not changed.\n
+     * On boards other than AVR, outputs are written one at a time.
+     *
+     * \code{.cpp}
+     * smrtobj::io::DigitalOutput seg[7];
+     * smrtobj::io::DigitalOutputGroup display;
+     *
+     * for (byte i = 0; i < 7; i++)
+     * {
+     *   seg[i].init(2 + i);
+     *   display.attach(seg[i], i);
+     * }
+     *
+     * display.write(0x06);    // '1'
+     * \endcode
+     */
+    class DigitalOutputGroup
+    {
+      public:
+        /**
+         * Limits of the group.
+         */
+        enum _group_limits
+        {
+          //! Maximum number of outputs
+          MAX_OUTPUTS = 16,
+
+          //! Maximum number of ports
+          MAX_PORTS = 4,
+        };
+
+        /**
+         * Default Constructor.
+         * It creates an empty group.
+         */
+        DigitalOutputGroup();
+
+        /**
+         * Copy Constructor.
+         *
+         * \param[in] g source group
+         *
+         */
+        DigitalOutputGroup(const DigitalOutputGroup &g);
+
+        /**
+         * Destructor.
+         *
+         */
+        virtual ~DigitalOutputGroup();
+
+        /**
+         * Override operator =
+         *
+         * \param[in] g source group
+         *
+         * \return reference to the destination group
+         */
+        DigitalOutputGroup & operator=(const DigitalOutputGroup &g);
+
+        /**
+         * Attaches a digital output to a bit of the group state. The output must be initialized.
+         *
+         * \param[in] o digital output
+         * \param[in] pos bit of the state (0 - MAX_OUTPUTS - 1)
+         *
+         * \return true if no errors, false if the output is not open, pos is not valid or the outputs use
+         *         more than MAX_PORTS ports
+         */
+        bool attach(DigitalOutput &o, byte pos);
+
+        /**
+         * Removes the digital output attached to a bit of the group state.
+         *
+         * \param[in] pos bit of the state
+         */
+        void detach(byte pos);
+
+        /**
+         * Gets the last state written.
+         *
+         * \return last state written
+         */
+        uint16_t value() const { return m_value; }
+
+        /**
+         * Writes the state of all outputs: bit i is the level of the output attached at position i.
+         *
+         * \param[in] state new state
+         *
+         * \return false if there are no outputs, true otherwise
+         */
+        bool write(uint16_t state);
+
+      private:
+        /**
+         * Calculates ports and masks of the outputs attached.
+         *
+         * \return false if the outputs use more than MAX_PORTS ports
+         */
+        bool update();
+
+        //! Outputs attached
+        DigitalOutput *m_outputs[MAX_OUTPUTS];
+
+        //! Port of each output (index of m_regs), 0xFF if it has no register
+        byte m_port[MAX_OUTPUTS];
+
+        //! Port registers
+        volatile uint8_t *m_regs[MAX_PORTS];
+
+        //! Mask of the outputs of the group in each port
+        uint8_t m_masks[MAX_PORTS];
+
+        //! Number of ports used
+        byte m_nports;
+
+        //! Last state written
+        uint16_t m_value;
+    };
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
+
+#endif /* DIGITALOUTPUTGROUP_H_ */
@@ -70,6 +70,16 @@ namespace smrtobj
   
       return true;
     }
+
+    bool LEDArray::check(smrtobj::io::LEDSequencer &sequencer, smrtobj::io::DigitalActuator** ledsArray, byte size)
+    {
+      if ( !sequencer.attach(ledsArray, size) )
+      {
+        return false;
+      }
+
+      return sequencer.check(CHECK_TIME);
+    }
   
   } /* namespace io */
   
@@ -11,6 +11,7 @@
 #include <Arduino.h>
 #include "interfaces/signal.h"
 #include "actuator/digitalactuator.h"
+#include "actuator/ledsequencer.h"
 #include "iosignal.h"
 
 namespace smrtobj
@@ -130,11 +131,28 @@ namespace io
        * Its blinks a generic array of LEDs. This operation can be used to check if
        * all LEDs are working correctly.
        *
+       * \b Note: \n
+       * It blocks for smrtobj::io::LEDArray::CHECK_TIME milliseconds, use the version with a
+       * smrtobj::io::LEDSequencer to run the check in background.
+       *
        * \param[in] ledsArray pointer to the LED array
        * \param[in] size size of the LED array
        */
       static bool check(smrtobj::io::DigitalActuator** ledsArray, byte size);
 
+      /**
+       * Starts the check of a generic array of LEDs on a sequencer and returns immediately: the LEDs
+       * are switched on for smrtobj::io::LEDArray::CHECK_TIME milliseconds while the main loop calls
+       * smrtobj::io::LEDSequencer::update.
+       *
+       * \param[in] sequencer sequencer running the check
+       * \param[in] ledsArray pointer to the LED array
+       * \param[in] size size of the LED array
+       *
+       * \return true if the check has been started, false otherwise
+       */
+      static bool check(smrtobj::io::LEDSequencer &sequencer, smrtobj::io::DigitalActuator** ledsArray, byte size);
+
       //! State of the LED array
       byte m_state;
 
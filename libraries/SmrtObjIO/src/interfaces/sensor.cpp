@@ -6,6 +6,7 @@
  *
  */
 #include "sensor.h"
+#include "sensor/calibrationtable.h"
 
 namespace smrtobj
 {
@@ -18,13 +19,15 @@ namespace smrtobj
     unsigned long Sensor::TWARMUP = 0;
   
     // Default constructor
-    Sensor::Sensor()
+    Sensor::Sensor() :
+      m_table(0)
     {
     }
   
   
     // Copy constructor
-    Sensor::Sensor(const Sensor &s)
+    Sensor::Sensor(const Sensor &s) :
+      m_table(s.m_table)
     {
     }
   
@@ -36,8 +39,20 @@ namespace smrtobj
   
     Sensor & Sensor::operator=(const Sensor &s)
     {
+      m_table = s.m_table;
+
       return (*this);
     }
+
+    float Sensor::calibrate(float value) const
+    {
+      if (!m_table)
+      {
+        return value;
+      }
+
+      return m_table->apply(value);
+    }
   
   } /* namespace io */
   
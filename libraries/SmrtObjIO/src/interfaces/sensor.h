@@ -8,19 +8,47 @@
 #ifndef SENSOR_H_
 #define SENSOR_H_
 
+#include <Arduino.h>
+
 namespace smrtobj
 {
 
   namespace io
   {
+
+    class CalibrationTable;
   
     /**
      * The Sensor class defines the standard interface of a sensor. This is a virtual class and defines
      * a virtual method "measure" to read the sensor.
+     *
+     * A calibration table (smrtobj::io::CalibrationTable) can be linked to a sensor: implementations
+     * convert their measurements with smrtobj::io::Sensor::calibrate, so every unit can be corrected
+     * without changing the nominal constants of the sensor.
+     *
+     * The acquisition of a new measurement can be split in two steps, so that it does not block the main
+     * loop (see smrtobj::io::SensorScheduler): smrtobj::io::Sensor::startAcquisition starts it and
+     * smrtobj::io::Sensor::pollAcquisition tells when the value returned by smrtobj::io::Sensor::measure
+     * is updated. By default the acquisition is completed at start.
      */
     class Sensor
     {
       public:
+        /**
+         * Status of an acquisition
+         */
+        enum _acquisition
+        {
+          //! Acquisition failed
+          ACQUISITION_ERROR = -1,
+
+          //! New measurement available
+          ACQUISITION_DONE = 0,
+
+          //! Acquisition in progress
+          ACQUISITION_PENDING = 1,
+        };
+
         /**
          * Default Constructor.
          *
@@ -55,10 +83,65 @@ namespace smrtobj
          *
          */
         virtual float measure() = 0;
+
+        /**
+         * Gets the time to wait after power on for having a valid value.
+         *
+         * \return warm up time (in milliseconds)
+         */
+        virtual unsigned long warmup() { return TWARMUP; }
+
+        /**
+         * Gets the time between the start of an acquisition and its result (e.g. the conversion time of
+         * the device). By default the result is available at start.
+         *
+         * \return latency (in milliseconds)
+         */
+        virtual unsigned long latency() { return 0; }
+
+        /**
+         * Starts the acquisition of a new measurement. By default it does nothing.
+         *
+         * \return true if the acquisition has been started, false otherwise
+         */
+        virtual bool startAcquisition() { return true; }
+
+        /**
+         * Checks the acquisition started by smrtobj::io::Sensor::startAcquisition. It must not block.
+         *
+         * \return status according to smrtobj::io::Sensor::_acquisition enum
+         */
+        virtual int8_t pollAcquisition() { return ACQUISITION_DONE; }
+
+        /**
+         * Sets the calibration table applied to the measurements. The table is not copied.
+         *
+         * \param[in] table calibration table, 0 to remove it
+         */
+        void setCalibrationTable(CalibrationTable *table) { m_table = table; }
+
+        /**
+         * Gets the calibration table applied to the measurements.
+         *
+         * \return calibration table, 0 if the measurements are not calibrated
+         */
+        CalibrationTable* calibrationTable() const { return m_table; }
   
       protected:
+        /**
+         * Converts a measurement with the calibration table, if any.
+         *
+         * \param[in] value measurement
+         *
+         * \return calibrated measurement
+         */
+        float calibrate(float value) const;
+
         //! Warm up time (in millis). This is the time to wait for having a valid value.
         static unsigned long TWARMUP;
+
+        //! Calibration table
+        CalibrationTable *m_table;
     };
   
   } /* namespace io */
@@ -6,6 +6,7 @@
  *
  */
 #include "iosignal.h"
+#include "adcsampler.h"
 
 namespace smrtobj
 {
@@ -16,7 +17,7 @@ namespace smrtobj
     /**********************************************************************************
      * DigitalOutput
      **********************************************************************************/
-    DigitalOutput::DigitalOutput() : m_value(LOW), m_pin(0)
+    DigitalOutput::DigitalOutput() : m_value(LOW), m_pin(0), m_reg(0), m_mask(0)
     {
       m_type = TYPE_OUTPUT;
     }
@@ -25,6 +26,8 @@ namespace smrtobj
     {
       m_value = o.m_value;
       m_pin = o.m_pin;
+      m_reg = o.m_reg;
+      m_mask = o.m_mask;
     }
   
     DigitalOutput::~DigitalOutput()
@@ -36,6 +39,8 @@ namespace smrtobj
       Signal::operator=(o);
       m_value = o.m_value;
       m_pin = o.m_pin;
+      m_reg = o.m_reg;
+      m_mask = o.m_mask;
   
       return (*this);
     }
@@ -44,6 +49,20 @@ namespace smrtobj
     {
       m_pin = pin;
       pinMode(m_pin, OUTPUT);
+
+#if defined(__AVR__)
+      byte port = digitalPinToPort(m_pin);
+
+      if (port != NOT_A_PIN)
+      {
+        m_reg = portOutputRegister(port);
+        m_mask = digitalPinToBitMask(m_pin);
+      }
+
+      // digitalRead turns off the PWM of the pin without changing the output
+      digitalRead(m_pin);
+#endif
+
       m_open = true;
     }
   
@@ -55,6 +74,29 @@ namespace smrtobj
       }
   
       m_value = value;
+
+#if defined(__AVR__)
+      if (m_reg)
+      {
+        // The read-modify-write of the register must not be interrupted
+        uint8_t oldSREG = SREG;
+        cli();
+
+        if (m_value)
+        {
+          *m_reg |= m_mask;
+        }
+        else
+        {
+          *m_reg &= ~m_mask;
+        }
+
+        SREG = oldSREG;
+
+        return true;
+      }
+#endif
+
       digitalWrite(m_pin, m_value);
   
       return true;
@@ -114,7 +156,7 @@ namespace smrtobj
     /**********************************************************************************
      * DigitalInput
      **********************************************************************************/
-    DigitalInput::DigitalInput() : m_value(0), m_pin(0)
+    DigitalInput::DigitalInput() : m_value(0), m_pin(0), m_reg(0), m_mask(0)
     {
       m_type = TYPE_INPUT;
     }
@@ -123,6 +165,8 @@ namespace smrtobj
     {
       m_value = o.m_value;
       m_pin = o.m_pin;
+      m_reg = o.m_reg;
+      m_mask = o.m_mask;
     }
   
     DigitalInput::~DigitalInput()
@@ -134,6 +178,8 @@ namespace smrtobj
       Signal::operator=(o);
       m_value = o.m_value;
       m_pin = o.m_pin;
+      m_reg = o.m_reg;
+      m_mask = o.m_mask;
   
       return (*this);
     }
@@ -150,6 +196,16 @@ namespace smrtobj
       {
         pinMode(m_pin,INPUT);
       }
+
+#if defined(__AVR__)
+      byte port = digitalPinToPort(m_pin);
+
+      if (port != NOT_A_PIN)
+      {
+        m_reg = portInputRegister(port);
+        m_mask = digitalPinToBitMask(m_pin);
+      }
+#endif
   
       m_open = true;
     }
@@ -161,7 +217,14 @@ namespace smrtobj
         return 0;
       }
   
-      m_value = digitalRead(m_pin);
+      if (m_reg)
+      {
+        m_value = ( (*m_reg & m_mask) != 0 );
+      }
+      else
+      {
+        m_value = digitalRead(m_pin);
+      }
   
       return m_value;
     }
@@ -171,6 +234,8 @@ namespace smrtobj
      * AnalogInput
      **********************************************************************************/
     float  AnalogInput::VREF = DEFAULT_VREF;
+    float  AnalogInput::LSB = DEFAULT_VREF / (1UL << RESOLUTION);
+    unsigned int AnalogInput::VREF_MV = DEFAULT_VREF * 1000;
   
     float AnalogInput::reference()
     {
@@ -186,10 +251,15 @@ namespace smrtobj
         case V0_0 : VREF = 0.0; break;
         default :  {
           VREF = 0.0;
+          LSB = 0.0;
+          VREF_MV = 0;
           return false;
         }
       }
   
+      LSB = VREF / (1UL << RESOLUTION);
+      VREF_MV = VREF * 1000 + 0.5;
+
       return true;
     }
   
@@ -201,11 +271,13 @@ namespace smrtobj
       }
   
       VREF = voltage;
+      LSB = VREF / (1UL << RESOLUTION);
+      VREF_MV = VREF * 1000 + 0.5;
   
       return true;
     }
   
-    AnalogInput::AnalogInput() : m_value(0), m_pin(0)
+    AnalogInput::AnalogInput() : m_value(0), m_pin(0), m_slot(ADCSampler::NO_SLOT), m_oversampling(0)
     {
       m_type = TYPE_INPUT;
     }
@@ -214,6 +286,8 @@ namespace smrtobj
     {
       m_value = o.m_value;
       m_pin = o.m_pin;
+      m_slot = o.m_slot;
+      m_oversampling = o.m_oversampling;
     }
   
     AnalogInput::~AnalogInput()
@@ -225,6 +299,8 @@ namespace smrtobj
       Signal::operator=(o);
       m_value = o.m_value;
       m_pin = o.m_pin;
+      m_slot = o.m_slot;
+      m_oversampling = o.m_oversampling;
   
       return (*this);
     }
@@ -238,8 +314,23 @@ namespace smrtobj
       {
         digitalWrite(pin, HIGH);
       }
+      m_slot = ADCSampler::attach(m_pin);
+      ADCSampler::setOversampling(m_slot, m_oversampling);
       m_open = true;
     }
+
+    bool AnalogInput::setOversampling(byte bits)
+    {
+      if (bits > ADCSampler::MAX_OVERSAMPLING)
+      {
+        return false;
+      }
+
+      m_oversampling = bits;
+      ADCSampler::setOversampling(m_slot, bits);
+
+      return true;
+    }
   
     unsigned long AnalogInput::read()
     {
@@ -248,6 +339,33 @@ namespace smrtobj
         return 0;
       }
   
+      if ( ADCSampler::isRunning() )
+      {
+        uint16_t v = 0;
+        bool updated = (m_oversampling) ? ADCSampler::decimated(m_slot, v) : ADCSampler::latest(m_slot, v);
+
+        if (updated)
+        {
+          m_value = v;
+        }
+
+        return m_value;
+      }
+
+      if (m_oversampling)
+      {
+        unsigned long sum = 0;
+
+        for (uint16_t n = 1 << (m_oversampling << 1); n > 0; n--)
+        {
+          sum += analogRead(m_pin);
+        }
+
+        m_value = sum >> m_oversampling;
+
+        return m_value;
+      }
+
       m_value = analogRead(m_pin);
   
       return m_value;
@@ -255,34 +373,23 @@ namespace smrtobj
   
     float  AnalogInput::inputVoltage()
     {
-      float lsb = reference();
-  
-      switch (RESOLUTION)
-      {
-        case 1  : { lsb /= 2; } break;
-        case 2  : { lsb /= 4; } break;
-        case 3  : { lsb /= 8; } break;
-        case 4  : { lsb /= 16; } break;
-        case 5  : { lsb /= 32; } break;
-        case 6  : { lsb /= 64; } break;
-        case 7  : { lsb /= 128; } break;
-        case 8  : { lsb /= 256; } break;
-        case 9  : { lsb /= 512; } break;
-        case 10 : { lsb /= 1024; } break;
-        case 11 : { lsb /= 2048; } break;
-        case 12 : { lsb /= 4096; } break;
-        default : { lsb /= 4096; }
-      }
-  
-      if (RESOLUTION > 12)
+      float v = m_value * LSB;
+
+      // 2^-bits: only the exponent changes
+      if (m_oversampling)
       {
-        for (byte i = 0; i <  RESOLUTION - 12; i++)
-        {
-          m_value /=10;
-        }
+        v = ldexp(v, -m_oversampling);
       }
-  
-      return m_value * lsb;
+
+      return v;
+    }
+
+    unsigned int AnalogInput::inputMillivolts()
+    {
+      byte bits = resolution();
+
+      // 16 bits value per 13 bits reference: the product fits in 32 bits
+      return ((m_value * VREF_MV) + (1UL << (bits - 1))) >> bits;
     }
   
   } /* namespace io */
@@ -16,12 +16,23 @@ namespace smrtobj
 
   namespace io
   {
+
+    class DigitalOutputGroup;
   
     /**
      * The DigitalOutput class models an digital output. Output value can be \b HIGH or
      * \b LOW. The last value written is stored in an internal variable. The default
      * output pin is 0.
      *
+     * On AVR boards the output register and the bit mask of the pin are resolved by
+     * smrtobj::io::DigitalOutput::init, so smrtobj::io::DigitalOutput::write changes the pin
+     * with a single read-modify-write of the register (with interrupts disabled), instead of
+     * looking up the pin tables at every call as \b digitalWrite does.
+     *
+     * \b Note: \n
+     * A PWM output on the pin is turned off by smrtobj::io::DigitalOutput::init. Do not use
+     * \b analogWrite on the same pin after init.
+     *
      */
     class DigitalOutput : public Signal
     {
@@ -94,11 +105,20 @@ namespace smrtobj
         bool write(bool value);
   
       private:
+        //! A group of outputs writes the registers directly
+        friend class DigitalOutputGroup;
+
         //! Last value written
         bool m_value;
   
         //! Pin number
         byte m_pin;
+
+        //! Output register of the pin (AVR only)
+        volatile uint8_t *m_reg;
+
+        //! Bit mask of the pin in its register
+        uint8_t m_mask;
     };
   
   
@@ -204,6 +224,10 @@ namespace smrtobj
      * The DigitalInput class models a digital input. Using this, it is possible read the value from a
      * specified digital pin, either HIGH or LOW.
      *
+     * On AVR boards the input register and the bit mask of the pin are resolved by
+     * smrtobj::io::DigitalInput::init, so smrtobj::io::DigitalInput::read is a single read of
+     * the register.
+     *
      */
     class DigitalInput : public Signal
     {
@@ -284,6 +308,12 @@ namespace smrtobj
   
         //! Pin number
         byte m_pin;
+
+        //! Input register of the pin (AVR only)
+        volatile uint8_t *m_reg;
+
+        //! Bit mask of the pin in its register
+        uint8_t m_mask;
     };
   
   
@@ -299,11 +329,16 @@ namespace smrtobj
      * It takes about 100 microseconds (0.0001 s) to read an analog input, so the maximum reading rate is about
      * 10,000 times a second.
      *
+     * The resolution can be increased by oversampling (see smrtobj::io::AnalogInput::setOversampling): 4^k
+     * samples are added and decimated to 10 + k bits. It works only if the input has at least 1 LSB of
+     * noise. If smrtobj::io::ADCSampler is running, samples are added by its interrupt, otherwise
+     * smrtobj::io::AnalogInput::read calls \b analogRead 4^k times.
+     *
      */
     class AnalogInput : public Signal
     {
       public:
-        //! ADC resolution
+        //! ADC resolution (without oversampling)
         static const byte RESOLUTION = 10;
   
         //! Default ADC reference voltage
@@ -402,7 +437,9 @@ namespace smrtobj
          * Opens the pin in input mode. It is possible use internal pull up resistor.\n
          * The analog pins also have pullup resistors, which work identically to pullup resistors
          * on the digital pins.\n
-         * Be aware however that turning on a pullup will affect the values reported by analogRead().
+         * Be aware however that turning on a pullup will affect the values reported by analogRead().\n
+         * The pin is registered to smrtobj::io::ADCSampler, so it is converted in background when the
+         * sampler is started.
          *
          * \param[in] pin number of the input pin
          * \param[in] pullup use internal pull up resistor. Default value is false
@@ -422,32 +459,82 @@ namespace smrtobj
          * \return pin number
          */
         byte pin() { return m_pin; }
+
+        /**
+         * Sets the oversampling: every value read is the sum of 4^bits samples shifted right by \e bits,
+         * so it has RESOLUTION + bits bits. Inputs on the same pin share the channel of
+         * smrtobj::io::ADCSampler, so they must use the same oversampling.
+         *
+         * \param[in] bits extra bits of resolution (0 to disable, up to smrtobj::io::ADCSampler::MAX_OVERSAMPLING)
+         *
+         * \return false if the number of bits is not valid, true otherwise
+         */
+        bool setOversampling(byte bits);
+
+        /**
+         * Gets the oversampling.
+         *
+         * \return extra bits of resolution
+         */
+        byte oversampling() { return m_oversampling; }
+
+        /**
+         * Gets the resolution of the values read.
+         *
+         * \return number of bits
+         */
+        byte resolution() { return RESOLUTION + m_oversampling; }
   
         /**
-         * Reads value from the analog input. If the input has not been opened yet, it returns 0.
+         * Reads value from the analog input. If the input has not been opened yet, it returns 0.\n
+         * If smrtobj::io::ADCSampler is running, it returns the latest sample (or decimated sample, with
+         * oversampling) converted in background without waiting (the last value read if the channel has not
+         * been converted yet or it has not been registered because all the slots of the sampler were used).
          *
-         * \return value, it is a number between 0 and 1023
+         * \return value, it is a number between 0 and 2^resolution() - 1 (1023 without oversampling)
          */
         unsigned long read();
   
         /**
-         * Gets value as voltage. Pay attention, this value depends on reference voltage, if it has been set a
+         * Gets value as voltage. The voltage of one LSB is computed when the reference is set, the
+         * oversampling only changes the exponent of the result.\n
+         * Pay attention, this value depends on reference voltage, if it has been set a
          * wrong value for this voltage, function will return a wrong result. See
          * smrtobj::io::AnalogSensor::setReferenceDefault and smrtobj::io::AnalogSensor::setReference
          *
          * \return input value as voltage
          */
         float inputVoltage();
+
+        /**
+         * Gets value as millivolts, without floating point operations. As smrtobj::io::AnalogInput::inputVoltage,
+         * it depends on the reference voltage.
+         *
+         * \return input value (in millivolts)
+         */
+        unsigned int inputMillivolts();
   
       private:
         //! ADC reference voltage
         static float VREF;
+
+        //! ADC reference voltage (in millivolts)
+        static unsigned int VREF_MV;
+
+        //! Voltage of one LSB at RESOLUTION bits
+        static float LSB;
   
         //! Last value written
         unsigned long m_value;
   
         //! Pin number
         byte m_pin;
+
+        //! Slot of smrtobj::io::ADCSampler
+        byte m_slot;
+
+        //! Extra bits of resolution given by oversampling
+        byte m_oversampling;
     };
   
   } /* namespace io */
@@ -47,7 +47,7 @@ namespace smrtobj
     {
       unsigned long value = AnalogInput::read();
   
-      m_measure = inputVoltage();
+      m_measure = calibrate( inputVoltage() );
   
       return m_measure;
     }
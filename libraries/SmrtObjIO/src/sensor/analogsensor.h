@@ -90,6 +90,13 @@ namespace smrtobj
          *
          */
         virtual float measure() { return m_measure; };
+
+        /**
+         * Starts the acquisition: the analog input is read at once, so the measurement is already updated.
+         *
+         * \return always true
+         */
+        virtual bool startAcquisition() { read(); return true; }
   
       protected:
         //! Last value read
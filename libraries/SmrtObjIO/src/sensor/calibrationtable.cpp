@@ -0,0 +1,325 @@
+/**
+ * \file calibrationtable.cpp
+ * \brief CalibrationTable is a class to correct the measurements of a sensor with a piecewise-linear or
+ *        polynomial function, stored in EEPROM.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "calibrationtable.h"
+
+#if defined(E2END)
+#include <avr/eeprom.h>
+#endif
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+#if defined(E2END)
+    /**
+     * Writes bytes to EEPROM (only the changed ones) and updates the checksum.
+     */
+    static void writeEEPROM(uint16_t &address, const void *data, byte len, byte &sum)
+    {
+      const byte *p = (const byte *) data;
+
+      for (byte i = 0; i < len; i++)
+      {
+        eeprom_update_byte((uint8_t *) (uintptr_t) address++, p[i]);
+        sum ^= p[i];
+      }
+    }
+
+    /**
+     * Reads bytes from EEPROM and updates the checksum.
+     */
+    static void readEEPROM(uint16_t &address, void *data, byte len, byte &sum)
+    {
+      byte *p = (byte *) data;
+
+      for (byte i = 0; i < len; i++)
+      {
+        p[i] = eeprom_read_byte((const uint8_t *) (uintptr_t) address++);
+        sum ^= p[i];
+      }
+    }
+#endif
+
+    CalibrationTable::CalibrationTable() :
+        m_type(NONE),
+        m_count(0)
+    {
+    }
+
+    CalibrationTable::CalibrationTable(const CalibrationTable &t)
+    {
+      (*this) = t;
+    }
+
+    CalibrationTable::~CalibrationTable()
+    {
+    }
+
+    CalibrationTable & CalibrationTable::operator=(const CalibrationTable &t)
+    {
+      m_type = t.m_type;
+      m_count = t.m_count;
+      memcpy(m_x, t.m_x, sizeof(m_x));
+      memcpy(m_y, t.m_y, sizeof(m_y));
+      memcpy(m_slope, t.m_slope, sizeof(m_slope));
+
+      return (*this);
+    }
+
+    void CalibrationTable::clear()
+    {
+      m_type = NONE;
+      m_count = 0;
+    }
+
+    bool CalibrationTable::setPoints(const float *x, const float *y, byte n)
+    {
+      if (n < 2 || n > MAX_POINTS)
+      {
+        return false;
+      }
+
+      for (byte i = 1; i < n; i++)
+      {
+        if ( !(x[i] > x[i - 1]) )
+        {
+          return false;
+        }
+      }
+
+      memcpy(m_x, x, n * sizeof(float));
+      memcpy(m_y, y, n * sizeof(float));
+      m_type = LINEAR;
+      m_count = n;
+      slopes();
+
+      return true;
+    }
+
+    bool CalibrationTable::setPolynomial(const float *c, byte n)
+    {
+      if (n < 1 || n > MAX_POINTS)
+      {
+        return false;
+      }
+
+      memcpy(m_y, c, n * sizeof(float));
+      m_type = POLYNOMIAL;
+      m_count = n;
+
+      return true;
+    }
+
+    void CalibrationTable::slopes()
+    {
+      // Divisions are done once, when the table is set
+      for (byte i = 0; i + 1 < m_count; i++)
+      {
+        m_slope[i] = (m_y[i + 1] - m_y[i]) / (m_x[i + 1] - m_x[i]);
+      }
+    }
+
+    byte CalibrationTable::segment(float x) const
+    {
+      // Segment i goes from m_x[i] to m_x[i + 1]; first and last ones are extended to infinity
+      byte lo = 0;
+      byte hi = m_count - 2;
+
+      while (lo < hi)
+      {
+        byte mid = (lo + hi + 1) >> 1;
+
+        if (x < m_x[mid])
+        {
+          hi = mid - 1;
+        }
+        else
+        {
+          lo = mid;
+        }
+      }
+
+      return lo;
+    }
+
+    float CalibrationTable::apply(float x) const
+    {
+      switch (m_type)
+      {
+        case LINEAR:
+        {
+          byte i = segment(x);
+
+          return m_y[i] + m_slope[i] * (x - m_x[i]);
+        }
+
+        case POLYNOMIAL:
+        {
+          byte i = m_count - 1;
+          float y = m_y[i];
+
+          while (i > 0)
+          {
+            y = y * x + m_y[--i];
+          }
+
+          return y;
+        }
+
+        default:
+          return x;
+      }
+    }
+
+    void CalibrationTable::apply(const float *in, float *out, uint16_t n) const
+    {
+      if (m_type == NONE)
+      {
+        if (in != out)
+        {
+          memmove(out, in, n * sizeof(float));
+        }
+
+        return;
+      }
+
+      for (uint16_t k = 0; k < n; k++)
+      {
+        out[k] = apply(in[k]);
+      }
+    }
+
+    uint16_t CalibrationTable::storageSize() const
+    {
+      // MAGIC, type, count, data, checksum
+      uint16_t size = 4 + m_count * sizeof(float);
+
+      if (m_type == LINEAR)
+      {
+        size += m_count * sizeof(float);
+      }
+
+      return size;
+    }
+
+    bool CalibrationTable::load(uint16_t address)
+    {
+#if defined(E2END)
+      byte sum = 0;
+      byte head[3];
+
+      readEEPROM(address, head, 3, sum);
+
+      if (head[0] != MAGIC || head[2] > MAX_POINTS)
+      {
+        return false;
+      }
+
+      CalibrationTable t;
+      byte check = 0;
+      byte unused = 0;
+
+      switch (head[1])
+      {
+        case LINEAR:
+        {
+          if (head[2] < 2)
+          {
+            return false;
+          }
+
+          for (byte i = 0; i < head[2]; i++)
+          {
+            readEEPROM(address, &(t.m_x[i]), sizeof(float), sum);
+            readEEPROM(address, &(t.m_y[i]), sizeof(float), sum);
+          }
+        }
+        break;
+
+        case POLYNOMIAL:
+        {
+          if (head[2] < 1)
+          {
+            return false;
+          }
+
+          readEEPROM(address, t.m_y, head[2] * sizeof(float), sum);
+        }
+        break;
+
+        case NONE:
+        break;
+
+        default:
+          return false;
+      }
+
+      readEEPROM(address, &check, 1, unused);
+
+      if (check != sum)
+      {
+        return false;
+      }
+
+      // Points are checked as in setPoints
+      switch (head[1])
+      {
+        case LINEAR:
+          return setPoints(t.m_x, t.m_y, head[2]);
+
+        case POLYNOMIAL:
+          return setPolynomial(t.m_y, head[2]);
+
+        default:
+          clear();
+          return true;
+      }
+#else
+      (void) address;
+      return false;
+#endif
+    }
+
+    bool CalibrationTable::save(uint16_t address) const
+    {
+#if defined(E2END)
+      byte sum = 0;
+      byte head[3] = { MAGIC, m_type, m_count };
+
+      writeEEPROM(address, head, 3, sum);
+
+      if (m_type == LINEAR)
+      {
+        for (byte i = 0; i < m_count; i++)
+        {
+          writeEEPROM(address, &(m_x[i]), sizeof(float), sum);
+          writeEEPROM(address, &(m_y[i]), sizeof(float), sum);
+        }
+      }
+      else
+      {
+        writeEEPROM(address, m_y, m_count * sizeof(float), sum);
+      }
+
+      // The checksum is written last, so that load can detect an interrupted save
+      byte unused = 0;
+      writeEEPROM(address, &sum, 1, unused);
+
+      return true;
+#else
+      (void) address;
+      return false;
+#endif
+    }
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
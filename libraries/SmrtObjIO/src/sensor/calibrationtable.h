@@ -0,0 +1,237 @@
+/**
+ * \file calibrationtable.h
+ * \brief CalibrationTable is a class to correct the measurements of a sensor with a piecewise-linear or
+ *        polynomial function, stored in EEPROM.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef CALIBRATIONTABLE_H_
+#define CALIBRATIONTABLE_H_
+
+#include <Arduino.h>
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    /**
+     * The CalibrationTable class maps the measurement of a sensor (e.g. the value computed with the nominal
+     * constants of the datasheet) to the calibrated value of a specific unit. Two kinds of table are
+     * available:
+     *   - piecewise-linear: up to MAX_POINTS points (x, y) with increasing x. A value is converted finding
+     *     its segment with a binary search and interpolating; values outside the table are extrapolated
+     *     with the first or the last segment;
+     *   - polynomial: up to MAX_POINTS coefficients, y = c0 + c1 * x + c2 * x^2 + ..., evaluated with
+     *     the Horner method.
+     *
+     * An empty table does not change the values. A table is linked to a sensor with
+     * smrtobj::io::Sensor::setCalibrationTable; the table is not copied, so it must exist as long as the
+     * sensor uses it (the same table can be shared among sensors).
+     *
+     * Tables can be saved to and loaded from EEPROM (boards defining E2END, as the AVR ones), so every unit
+     * can be calibrated in the field without building a new firmware. The record in EEPROM is:
+     *   - MAGIC (1 byte);
+     *   - type (1 byte), according to smrtobj::io::CalibrationTable::_type enum;
+     *   - number of points or coefficients (1 byte);
+     *   - points (x, y) or coefficients as float (4 bytes each);
+     *   - checksum (1 byte), XOR of the previous bytes.
+     *
+     * The size of the record is given by smrtobj::io::CalibrationTable::storageSize, so several tables can
+     * be stored one after the other.
+     *
+     * \code{.cpp}
+     * smrtobj::io::MCP9700A temperature;
+     * smrtobj::io::CalibrationTable table;
+     *
+     * if ( !table.load(0) )
+     * {
+     *   // Not calibrated yet: two points measured with a reference thermometer
+     *   float x[] = { 0.5, 40.2 };
+     *   float y[] = { 0.0, 40.0 };
+     *
+     *   table.setPoints(x, y, 2);
+     *   table.save(0);
+     * }
+     *
+     * temperature.setCalibrationTable(&table);
+     * \endcode
+     */
+    class CalibrationTable
+    {
+      public:
+        /**
+         * Limits of the table.
+         */
+        enum _limits
+        {
+          //! Maximum number of points or coefficients
+          MAX_POINTS = 8,
+        };
+
+        /**
+         * Kind of table.
+         */
+        enum _type
+        {
+          //! Empty table, values are not changed
+          NONE = 0,
+
+          //! Piecewise-linear function
+          LINEAR = 1,
+
+          //! Polynomial function
+          POLYNOMIAL = 2,
+        };
+
+        //! First byte of a table stored in EEPROM
+        static const byte MAGIC = 0xCA;
+
+        /**
+         * Default Constructor.
+         * It creates an empty table.
+         */
+        CalibrationTable();
+
+        /**
+         * Copy Constructor.
+         *
+         * \param[in] t source table
+         */
+        CalibrationTable(const CalibrationTable &t);
+
+        /**
+         * Destructor.
+         */
+        virtual ~CalibrationTable();
+
+        /**
+         * Override operator =
+         *
+         * \param[in] t source table
+         *
+         * \return reference of the destination table
+         */
+        CalibrationTable & operator=(const CalibrationTable &t);
+
+        /**
+         * Removes the points or the coefficients: values are not changed.
+         */
+        void clear();
+
+        /**
+         * Sets a piecewise-linear table.
+         *
+         * \param[in] x measurements (increasing)
+         * \param[in] y calibrated values
+         * \param[in] n number of points (2 - MAX_POINTS)
+         *
+         * \return false if the number of points is not valid or x is not increasing, true otherwise
+         */
+        bool setPoints(const float *x, const float *y, byte n);
+
+        /**
+         * Sets a polynomial table.
+         *
+         * \param[in] c coefficients, from the constant term
+         * \param[in] n number of coefficients (1 - MAX_POINTS)
+         *
+         * \return false if the number of coefficients is not valid, true otherwise
+         */
+        bool setPolynomial(const float *c, byte n);
+
+        /**
+         * Gets the kind of table.
+         *
+         * \return type according to smrtobj::io::CalibrationTable::_type enum
+         */
+        byte type() const { return m_type; }
+
+        /**
+         * Gets the number of points or coefficients.
+         *
+         * \return number of points or coefficients
+         */
+        byte count() const { return m_count; }
+
+        /**
+         * Converts a measurement.
+         *
+         * \param[in] x measurement
+         *
+         * \return calibrated value
+         */
+        float apply(float x) const;
+
+        /**
+         * Converts a buffer of measurements. Input and output can be the same buffer.
+         *
+         * \param[in] in measurements
+         * \param[out] out calibrated values
+         * \param[in] n number of values
+         */
+        void apply(const float *in, float *out, uint16_t n) const;
+
+        /**
+         * Gets the number of bytes used in EEPROM by the table.
+         *
+         * \return size of the record
+         */
+        uint16_t storageSize() const;
+
+        /**
+         * Loads the table from EEPROM. If the record is not valid, the table is not changed.
+         *
+         * \param[in] address address of the record
+         *
+         * \return true if the table has been loaded, false otherwise (invalid record or EEPROM not supported)
+         */
+        bool load(uint16_t address);
+
+        /**
+         * Saves the table to EEPROM. Only the bytes changed are written.
+         *
+         * \param[in] address address of the record
+         *
+         * \return true if the table has been saved, false if the EEPROM is not supported
+         */
+        bool save(uint16_t address) const;
+
+      private:
+        /**
+         * Computes the slopes of the segments of a piecewise-linear table.
+         */
+        void slopes();
+
+        /**
+         * Finds the segment of a value in a piecewise-linear table.
+         *
+         * \param[in] x value
+         *
+         * \return index of the first point of the segment (0 - count - 2)
+         */
+        byte segment(float x) const;
+
+        //! Kind of table
+        byte m_type;
+
+        //! Number of points or coefficients
+        byte m_count;
+
+        //! x of the points
+        float m_x[MAX_POINTS];
+
+        //! y of the points or coefficients
+        float m_y[MAX_POINTS];
+
+        //! Slope of the segment starting at each point
+        float m_slope[MAX_POINTS - 1];
+    };
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
+
+#endif /* CALIBRATIONTABLE_H_ */
@@ -15,7 +15,12 @@ namespace smrtobj
   
     MCP9700A::MCP9700A() :
        m_mVpC(MV_PER_DEGREE_C),
-       m_Vat0C(ZERO_C_VOLTS)
+       m_Vat0C(ZERO_C_VOLTS),
+       m_gain(0),
+       m_offset(0),
+       m_vref(-1.0),
+       m_bits(0),
+       m_centi(0)
       {
       }
   
@@ -25,6 +30,11 @@ namespace smrtobj
     {
       m_mVpC = s.m_mVpC;
       m_Vat0C = s.m_Vat0C;
+      m_gain = s.m_gain;
+      m_offset = s.m_offset;
+      m_vref = s.m_vref;
+      m_bits = s.m_bits;
+      m_centi = s.m_centi;
     }
   
     MCP9700A::~MCP9700A()
@@ -36,33 +46,82 @@ namespace smrtobj
       AnalogSensor::operator=(s);
       m_mVpC = s.m_mVpC;
       m_Vat0C = s.m_Vat0C;
+      m_gain = s.m_gain;
+      m_offset = s.m_offset;
+      m_vref = s.m_vref;
+      m_bits = s.m_bits;
+      m_centi = s.m_centi;
   
       return (*this);
     }
   
     float MCP9700A::celsius()
     {
-      return measure();
+      return m_centi / 100.0;
     }
   
     float MCP9700A::kelvin()
     {
-      return celsius2kelvin(measure());
+      return celsius2kelvin(celsius());
     }
   
     float MCP9700A::farenheit()
     {
-      return celsius2farenheit(measure());
+      return celsius2farenheit(celsius());
+    }
+
+    bool MCP9700A::setCalibration(float vat0c, float vpc)
+    {
+      // Full scale (5 V) must be less than 2^(31 - SHIFT) centi-degrees
+      if (vat0c < 0 || vat0c > 5.0 || vpc < 0.004)
+      {
+        return false;
+      }
+
+      m_Vat0C = vat0c;
+      m_mVpC = vpc;
+      updateGain();
+
+      return true;
+    }
+
+    void MCP9700A::updateGain()
+    {
+      m_vref = reference();
+      m_bits = resolution();
+
+      // C = (count * VREF / 2^bits - Vat0C) / VpC
+      m_gain = (long) (ldexp(m_vref * 100 / m_mVpC, SHIFT - m_bits) + 0.5);
+      m_offset = (long) (ldexp(m_Vat0C * 100 / m_mVpC, SHIFT) + 0.5);
+    }
+
+    long MCP9700A::readCentiCelsius()
+    {
+      long count = AnalogInput::read();
+
+      if (m_vref != reference() || m_bits != resolution())
+      {
+        updateGain();
+      }
+
+      // Rounded to the nearest centi-degree
+      m_centi = (count * m_gain - m_offset + (1L << (SHIFT - 1))) >> SHIFT;
+
+      if (m_table)
+      {
+        // Floating point is used only by calibrated sensors
+        float c = calibrate(m_centi / 100.0) * 100;
+        m_centi = (c < 0) ? (long) (c - 0.5) : (long) (c + 0.5);
+      }
+
+      return m_centi;
     }
   
     float MCP9700A::read()
     {
-      float value = AnalogSensor::read();
-  
-      value -= m_Vat0C; //ZERO_C_VOLTS;
-      value /= m_mVpC; //MV_PER_DEGREE_C;
-  
-      m_measure = value;
+      readCentiCelsius();
+
+      m_measure = celsius();
   
       return m_measure;
     }
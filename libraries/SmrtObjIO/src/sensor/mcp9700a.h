@@ -28,6 +28,18 @@ namespace smrtobj
      * a slope of 10mV/°C and has a DC offset of 500mV. The offset allows reading
      * negative temperatures without the need for a negative supply.
      *
+     * The conversion uses integer operations only: the calibration (voltage at 0C, slope), the reference
+     * voltage and the resolution of the input are folded in a fixed-point gain and offset, so every sample
+     * is converted in centi-degrees with one multiply and one shift. The gain is computed again when the
+     * reference voltage or the resolution change. Floating point values (celsius, kelvin, farenheit) are
+     * computed only when they are requested.
+     *
+     * \code{.cpp}
+     * smrtobj::io::MCP9700A temperature;
+     *
+     * temperature.init(A0);
+     * long t = temperature.readCentiCelsius();    // 2150 is 21.50C
+     * \endcode
      */
     class MCP9700A : public AnalogSensor, public SensorTemperature
     {
@@ -43,6 +55,9 @@ namespace smrtobj
   
         //! millivolts per degree Celsius (VDD = 5.0V)
         static const float MV_PER_DEGREE_C = 0.01000;
+
+        //! Fractional bits of the fixed-point gain and offset
+        static const byte SHIFT = 14;
   
         /**
          * Default Constructor.
@@ -93,13 +108,66 @@ namespace smrtobj
          */
         virtual float farenheit();
   
+        /**
+         * Gets the last temperature read, in celsius degrees.
+         *
+         * \return celsius degrees
+         */
+        virtual float measure() { return celsius(); }
+
+        /**
+         * Sets the calibration of the sensor.
+         *
+         * \param[in] vat0c output voltage at 0C (0.0 - 5.0 V)
+         * \param[in] vpc slope of the output voltage (in volt per celsius degree, at least 0.004 V/C)
+         *
+         * \return false if the calibration is not valid, true otherwise
+         */
+        bool setCalibration(float vat0c, float vpc);
+
+        /**
+         * Reads value from the analog input and converts it in hundredths of celsius degree, without
+         * floating point operations.
+         *
+         * \return temperature (in hundredths of celsius degree)
+         */
+        long readCentiCelsius();
+
+        /**
+         * Gets the last temperature read, in hundredths of celsius degree.
+         *
+         * \return temperature (in hundredths of celsius degree)
+         */
+        long centiCelsius() { return m_centi; }
+
         /**
          * Reads value from the analog input
          *
-         * \return value as voltage
+         * \return temperature in celsius degrees
          */
         float read();
-  
+
+      private:
+        /**
+         * Computes the fixed-point gain and offset from the calibration, the reference voltage and
+         * the resolution of the input.
+         */
+        void updateGain();
+
+        //! Centi-degrees per ADC count (SHIFT fractional bits)
+        long m_gain;
+
+        //! Centi-degrees at 0 V (SHIFT fractional bits)
+        long m_offset;
+
+        //! Reference voltage used to compute the gain
+        float m_vref;
+
+        //! Resolution used to compute the gain
+        byte m_bits;
+
+        //! Last temperature read (in hundredths of celsius degree)
+        long m_centi;
     };
   
   } /* namespace io */
@@ -0,0 +1,97 @@
+/**
+ * \file sensorjob.cpp
+ * \brief SensorJob is a class to describe the periodic acquisition of a sensor, executed by
+ *        smrtobj::io::SensorScheduler.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "sensorjob.h"
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    SensorJob::SensorJob() :
+        m_sensor(0),
+        m_period(0),
+        m_warmup(0),
+        m_latency(0),
+        m_callback(0),
+        m_context(0),
+        m_value(0),
+        m_timestamp(0),
+        m_start(0),
+        m_errors(0),
+        m_overruns(0),
+        m_pending(false),
+        m_scheduler(0),
+        m_next(0)
+    {
+    }
+
+    SensorJob::SensorJob(Sensor &s, unsigned long period, callback_t callback, void *context) :
+        m_sensor(&s),
+        m_period(period),
+        m_warmup(s.warmup()),
+        m_latency(s.latency()),
+        m_callback(callback),
+        m_context(context),
+        m_value(0),
+        m_timestamp(0),
+        m_start(0),
+        m_errors(0),
+        m_overruns(0),
+        m_pending(false),
+        m_scheduler(0),
+        m_next(0)
+    {
+    }
+
+    SensorJob::SensorJob(const SensorJob &j) :
+        m_value(0),
+        m_timestamp(0),
+        m_start(0),
+        m_errors(0),
+        m_overruns(0),
+        m_pending(false),
+        m_scheduler(0),
+        m_next(0)
+    {
+      (*this) = j;
+    }
+
+    SensorJob::~SensorJob()
+    {
+    }
+
+    SensorJob & SensorJob::operator=(const SensorJob &j)
+    {
+      m_sensor = j.m_sensor;
+      m_period = j.m_period;
+      m_warmup = j.m_warmup;
+      m_latency = j.m_latency;
+      m_callback = j.m_callback;
+      m_context = j.m_context;
+
+      return (*this);
+    }
+
+    void SensorJob::setSensor(Sensor &s)
+    {
+      m_sensor = &s;
+      m_warmup = s.warmup();
+      m_latency = s.latency();
+    }
+
+    void SensorJob::setCallback(callback_t callback, void *context)
+    {
+      m_callback = callback;
+      m_context = context;
+    }
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
@@ -0,0 +1,250 @@
+/**
+ * \file sensorjob.h
+ * \brief SensorJob is a class to describe the periodic acquisition of a sensor, executed by
+ *        smrtobj::io::SensorScheduler.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef SENSORJOB_H_
+#define SENSORJOB_H_
+
+#include <Arduino.h>
+#include <timertask.h>
+#include "interfaces/sensor.h"
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    class SensorScheduler;
+
+    /**
+     * The SensorJob class links a sensor (smrtobj::io::Sensor) to its acquisition timing:
+     *   - period: time between two acquisitions;
+     *   - warm up: time to wait after the job has been added to the scheduler, before the first
+     *     acquisition (by default smrtobj::io::Sensor::warmup);
+     *   - latency: time between the start of an acquisition and the first check of its result (e.g. the
+     *     conversion time of the device, by default smrtobj::io::Sensor::latency), so that the sensor is not
+     *     polled while it is still converting.
+     *
+     * When a new measurement is available, it is stored in the job with the time the acquisition has
+     * been started and the callback of the job is called.
+     *
+     * A job does not copy the sensor and it must exist as long as it is added to a scheduler.
+     */
+    class SensorJob
+    {
+      public:
+        /**
+         * Function called when a new measurement is available.
+         */
+        typedef void (*callback_t)(SensorJob &job);
+
+        /**
+         * Default Constructor.
+         * It creates a job without sensor.
+         */
+        SensorJob();
+
+        /**
+         * Constructor.
+         *
+         * \param[in] s sensor
+         * \param[in] period time between two acquisitions (in milliseconds), 0 for a single acquisition
+         * \param[in] callback function called when a new measurement is available
+         * \param[in] context user data, returned by smrtobj::io::SensorJob::context
+         */
+        SensorJob(Sensor &s, unsigned long period, callback_t callback = 0, void *context = 0);
+
+        /**
+         * Copy Constructor. Only the configuration is copied: the new job is not scheduled.
+         *
+         * \param[in] j source job
+         */
+        SensorJob(const SensorJob &j);
+
+        /**
+         * Destructor.
+         */
+        virtual ~SensorJob();
+
+        /**
+         * Override operator =. Only the configuration is copied.
+         *
+         * \param[in] j source job
+         *
+         * \return reference of the destination job
+         */
+        SensorJob & operator=(const SensorJob &j);
+
+        /**
+         * Sets the sensor. The warm up time and the latency are set to the ones of the sensor.
+         *
+         * \param[in] s sensor
+         */
+        void setSensor(Sensor &s);
+
+        /**
+         * Gets the sensor.
+         *
+         * \return pointer to the sensor, 0 if it is not set
+         */
+        Sensor * sensor() const { return m_sensor; }
+
+        /**
+         * Sets the time between two acquisitions. It is applied when the job is added to a scheduler.
+         *
+         * \param[in] period period (in milliseconds), 0 for a single acquisition
+         */
+        void setPeriod(unsigned long period) { m_period = period; }
+
+        /**
+         * Gets the time between two acquisitions.
+         *
+         * \return period (in milliseconds)
+         */
+        unsigned long period() const { return m_period; }
+
+        /**
+         * Sets the time to wait before the first acquisition. It is applied when the job is added to a
+         * scheduler.
+         *
+         * \param[in] warmup warm up time (in milliseconds)
+         */
+        void setWarmup(unsigned long warmup) { m_warmup = warmup; }
+
+        /**
+         * Gets the time to wait before the first acquisition.
+         *
+         * \return warm up time (in milliseconds)
+         */
+        unsigned long warmup() const { return m_warmup; }
+
+        /**
+         * Sets the time between the start of an acquisition and the first check of its result.
+         *
+         * \param[in] latency latency (in milliseconds)
+         */
+        void setLatency(unsigned long latency) { m_latency = latency; }
+
+        /**
+         * Gets the time between the start of an acquisition and the first check of its result.
+         *
+         * \return latency (in milliseconds)
+         */
+        unsigned long latency() const { return m_latency; }
+
+        /**
+         * Sets the function called when a new measurement is available.
+         *
+         * \param[in] callback function, 0 for none
+         * \param[in] context user data, returned by smrtobj::io::SensorJob::context
+         */
+        void setCallback(callback_t callback, void *context = 0);
+
+        /**
+         * Gets the user data of the callback.
+         *
+         * \return user data
+         */
+        void * context() const { return m_context; }
+
+        /**
+         * Gets the last measurement.
+         *
+         * \return value of the measurement (see smrtobj::io::Sensor::measure)
+         */
+        float value() const { return m_value; }
+
+        /**
+         * Gets the time of the last measurement, that is the time its acquisition has been started.
+         *
+         * \return time (in milliseconds, see smrtobj::io::SensorScheduler::time)
+         */
+        unsigned long timestamp() const { return m_timestamp; }
+
+        /**
+         * Gets the number of acquisitions failed (not started or completed with an error).
+         *
+         * \return number of errors
+         */
+        unsigned int errors() const { return m_errors; }
+
+        /**
+         * Gets the number of acquisitions skipped because the previous one was still in progress.
+         *
+         * \return number of overruns
+         */
+        unsigned int overruns() const { return m_overruns; }
+
+        /**
+         * Checks if an acquisition is in progress.
+         *
+         * \return true if the acquisition has been started and it is not completed yet, false otherwise
+         */
+        bool isPending() const { return m_pending; }
+
+        /**
+         * Checks if the job has been added to a scheduler.
+         *
+         * \return true if the job is added to a scheduler, false otherwise
+         */
+        bool isScheduled() const { return (m_scheduler != 0); }
+
+      private:
+        friend class SensorScheduler;
+
+        //! Sensor
+        Sensor *m_sensor;
+
+        //! Time between two acquisitions (in milliseconds)
+        unsigned long m_period;
+
+        //! Time before the first acquisition (in milliseconds)
+        unsigned long m_warmup;
+
+        //! Time before checking the result of an acquisition (in milliseconds)
+        unsigned long m_latency;
+
+        //! Function called when a new measurement is available
+        callback_t m_callback;
+
+        //! User data of the callback
+        void *m_context;
+
+        //! Last measurement
+        float m_value;
+
+        //! Time of the last measurement
+        unsigned long m_timestamp;
+
+        //! Start time of the pending acquisition
+        unsigned long m_start;
+
+        //! Number of errors
+        unsigned int m_errors;
+
+        //! Number of overruns
+        unsigned int m_overruns;
+
+        //! Acquisition in progress
+        bool m_pending;
+
+        //! Timer of the acquisitions
+        smrtobj::timer::TimerTask m_task;
+
+        //! Scheduler the job is added to
+        SensorScheduler *m_scheduler;
+
+        //! Next job in the list of the pending acquisitions
+        SensorJob *m_next;
+    };
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
+
+#endif /* SENSORJOB_H_ */
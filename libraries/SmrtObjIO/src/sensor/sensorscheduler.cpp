@@ -0,0 +1,183 @@
+/**
+ * \file sensorscheduler.cpp
+ * \brief SensorScheduler is a class to acquire several sensors, each one with its own period, without
+ *        blocking the main loop.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#include "sensorscheduler.h"
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    SensorScheduler::SensorScheduler(unsigned int resolution) :
+        m_wheel(resolution),
+        m_pending(0),
+        m_tail(&m_pending),
+        m_count(0)
+    {
+    }
+
+    SensorScheduler::~SensorScheduler()
+    {
+    }
+
+    bool SensorScheduler::add(SensorJob &j)
+    {
+      if ( !j.m_sensor || (j.m_scheduler && j.m_scheduler != this) )
+      {
+        return false;
+      }
+
+      j.m_task.setCallback(due, &j);
+
+      if ( !m_wheel.start(j.m_task, j.m_warmup, j.m_period) )
+      {
+        return false;
+      }
+
+      if ( !j.m_scheduler )
+      {
+        j.m_scheduler = this;
+        m_count++;
+      }
+
+      return true;
+    }
+
+    bool SensorScheduler::remove(SensorJob &j)
+    {
+      if (j.m_scheduler != this)
+      {
+        return false;
+      }
+
+      m_wheel.stop(j.m_task);
+      unlink(j);
+
+      j.m_scheduler = 0;
+      m_count--;
+
+      return true;
+    }
+
+    void SensorScheduler::poll(unsigned long tref)
+    {
+      m_wheel.tick(tref);
+
+      unsigned long now = m_wheel.time();
+
+      // Detach the list, so that callbacks can add and remove any job (also the pending ones)
+      SensorJob *j = m_pending;
+
+      m_pending = 0;
+      m_tail = &m_pending;
+
+      while (j)
+      {
+        SensorJob *next = j->m_next;
+
+        if ( !j->m_pending )
+        {
+          // Removed by a callback
+          j = next;
+          continue;
+        }
+
+        int8_t status = Sensor::ACQUISITION_PENDING;
+
+        if (now - j->m_start >= j->m_latency)
+        {
+          status = j->m_sensor->pollAcquisition();
+        }
+
+        if (status == Sensor::ACQUISITION_PENDING)
+        {
+          // Still in progress: the order of start is kept
+          append(*j);
+        }
+        else
+        {
+          j->m_pending = false;
+
+          if (status == Sensor::ACQUISITION_DONE)
+          {
+            j->m_value = j->m_sensor->measure();
+            j->m_timestamp = j->m_start;
+
+            if (j->m_callback)
+            {
+              j->m_callback(*j);
+            }
+          }
+          else
+          {
+            j->m_errors++;
+          }
+        }
+
+        j = next;
+      }
+    }
+
+    void SensorScheduler::due(smrtobj::timer::TimerTask &t)
+    {
+      SensorJob *j = (SensorJob *) t.context();
+      SensorScheduler *s = j->m_scheduler;
+
+      if (j->m_pending)
+      {
+        j->m_overruns++;
+        return;
+      }
+
+      if ( !j->m_sensor->startAcquisition() )
+      {
+        j->m_errors++;
+        return;
+      }
+
+      j->m_start = s->m_wheel.time();
+      j->m_pending = true;
+
+      s->append(*j);
+    }
+
+    void SensorScheduler::append(SensorJob &j)
+    {
+      j.m_next = 0;
+      *m_tail = &j;
+      m_tail = &(j.m_next);
+    }
+
+    void SensorScheduler::unlink(SensorJob &j)
+    {
+      if ( !j.m_pending )
+      {
+        return;
+      }
+
+      for (SensorJob **link = &m_pending; *link; link = &((*link)->m_next))
+      {
+        if (*link == &j)
+        {
+          // m_next is kept, so that a poll in progress can go on from this job
+          *link = j.m_next;
+          if (m_tail == &(j.m_next))
+          {
+            m_tail = link;
+          }
+          break;
+        }
+      }
+
+      j.m_pending = false;
+    }
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
@@ -0,0 +1,177 @@
+/**
+ * \file sensorscheduler.h
+ * \brief SensorScheduler is a class to acquire several sensors, each one with its own period, without
+ *        blocking the main loop.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef SENSORSCHEDULER_H_
+#define SENSORSCHEDULER_H_
+
+#include <Arduino.h>
+#include <timerwheel.h>
+#include "sensor/sensorjob.h"
+
+namespace smrtobj
+{
+
+  namespace io
+  {
+
+    /**
+     * The SensorScheduler class replaces the blocking reads of the sensors in the main loop. Every sensor
+     * is described by a job (smrtobj::io::SensorJob) with its period, warm up time and conversion latency;
+     * the main loop calls smrtobj::io::SensorScheduler::poll as often as possible.
+     *
+     * Acquisitions are started by a timer wheel (smrtobj::timer::TimerWheel), so that jobs are executed in
+     * order of deadline and the cost of a poll does not depend on the number of jobs that are not due.
+     * An acquisition is done in two steps (see smrtobj::io::Sensor::startAcquisition and
+     * smrtobj::io::Sensor::pollAcquisition): sensors read in background (e.g. smrtobj::i2c::HIH7121) are
+     * started and then checked at every poll, once their latency has elapsed, while the others
+     * (e.g. smrtobj::io::AnalogSensor) are read at start. A job still pending when its next acquisition is
+     * due is not restarted and the overrun is counted.
+     *
+     * When an acquisition is completed, the value of the sensor is stored in the job with the time the
+     * acquisition has been started and the callback of the job is called. All times come from the wheel,
+     * so millis() is read once per poll.
+     *
+     * The wheel can be used to schedule other tasks (see smrtobj::io::SensorScheduler::wheel).
+     *
+     * \code{.cpp}
+     * smrtobj::io::MCP9700A temperature(A0);
+     * smrtobj::i2c::HIH7121 humidity;
+     *
+     * // Warm up and latency are the ones of the sensors (e.g. the measurement cycle of HIH7121)
+     * smrtobj::io::SensorJob jt(temperature, 1000, publish);
+     * smrtobj::io::SensorJob jh(humidity, 5000, publish);
+     *
+     * smrtobj::io::SensorScheduler scheduler;
+     *
+     * void setup()
+     * {
+     *   scheduler.add(jt);
+     *   scheduler.add(jh);
+     * }
+     *
+     * void loop()
+     * {
+     *   scheduler.poll();
+     *   ...
+     * }
+     * \endcode
+     */
+    class SensorScheduler
+    {
+      public:
+        /**
+         * Constructor.
+         *
+         * \param[in] resolution duration of a tick of the wheel (in milliseconds)
+         */
+        SensorScheduler(unsigned int resolution = 1);
+
+        /**
+         * Destructor.
+         */
+        virtual ~SensorScheduler();
+
+        /**
+         * Adds a job. The first acquisition starts after the warm up time of the job. If the job is
+         * already added to this scheduler, it is restarted.
+         *
+         * \param[in] j job
+         *
+         * \return false if the job has no sensor, it is added to another scheduler or its times are
+         *         too long, true otherwise
+         */
+        bool add(SensorJob &j);
+
+        /**
+         * Removes a job. An acquisition in progress is abandoned.
+         *
+         * \param[in] j job
+         *
+         * \return false if the job was not added to this scheduler, true otherwise
+         */
+        bool remove(SensorJob &j);
+
+        /**
+         * Starts the acquisitions due and checks the pending ones. It never waits for a sensor: it has to
+         * be called in the main loop, as often as possible.
+         *
+         * \param[in] tref external reference time (in milliseconds), if 0 use system time
+         */
+        void poll(unsigned long tref = 0);
+
+        /**
+         * Gets the number of jobs.
+         *
+         * \return number of jobs
+         */
+        unsigned int count() const { return m_count; }
+
+        /**
+         * Gets the time of the last poll.
+         *
+         * \return time (in milliseconds)
+         */
+        unsigned long time() const { return m_wheel.time(); }
+
+        /**
+         * Gets the timer wheel used to start the acquisitions.
+         *
+         * \return reference to the wheel
+         */
+        smrtobj::timer::TimerWheel & wheel() { return m_wheel; }
+
+      private:
+        /**
+         * Copy Constructor. A scheduler can not be copied: jobs are linked to it.
+         */
+        SensorScheduler(const SensorScheduler &s);
+
+        /**
+         * Overload operator =. A scheduler can not be copied: jobs are linked to it.
+         */
+        SensorScheduler& operator=(const SensorScheduler &s);
+
+        /**
+         * Starts the acquisition of a job, when its timer expires.
+         *
+         * \param[in] t timer of the job
+         */
+        static void due(smrtobj::timer::TimerTask &t);
+
+        /**
+         * Adds a job at the end of the list of the pending acquisitions.
+         *
+         * \param[in] j job
+         */
+        void append(SensorJob &j);
+
+        /**
+         * Removes a job from the list of the pending acquisitions.
+         *
+         * \param[in] j job
+         */
+        void unlink(SensorJob &j);
+
+        //! Timer wheel
+        smrtobj::timer::TimerWheel m_wheel;
+
+        //! First pending acquisition
+        SensorJob *m_pending;
+
+        //! Link to the end of the list of the pending acquisitions
+        SensorJob **m_tail;
+
+        //! Number of jobs
+        unsigned int m_count;
+    };
+
+  } /* namespace io */
+
+} /* namespace smrtobj */
+
+#endif /* SENSORSCHEDULER_H_ */
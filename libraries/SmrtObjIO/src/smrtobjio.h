@@ -21,13 +21,19 @@
 
 // Actuators
 #include "actuator/digitalactuator.h"
+#include "actuator/ledsequencer.h"
 
 // Sensors
 #include "sensor/analogsensor.h"
+#include "sensor/calibrationtable.h"
 #include "sensor/sensorbase.h"
+#include "sensor/sensorjob.h"
+#include "sensor/sensorscheduler.h"
 #include "sensor/mcp9700a.h"
 
 // IO signals
+#include <adcsampler.h>
+#include <digitaloutputgroup.h>
 #include <iosignal.h>
 
 
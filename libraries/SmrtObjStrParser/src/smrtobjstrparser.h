@@ -12,6 +12,7 @@
 
 // Parser
 #include <stringparser.h>
+#include <stringtokenizer.h>
 
 
 #endif /* SMRTOBJSTRPARSER_H_ */
@@ -7,6 +7,7 @@
  */
 
 #include "stringparser.h"
+#include "stringtokenizer.h"
 
 namespace smrtobj
 {
@@ -26,7 +27,7 @@ namespace smrtobj
     {
       // Check if is a number
       uint8_t i = 0;
-      for (; i < strlen(str) && (i < size); i++)
+      for (; str[i] != '\0' && (i < size); i++)
       {
         if (!isDigit(str[i]) /*str[i] < '0' || str[i] > '9'*/)
         {
@@ -44,69 +45,25 @@ namespace smrtobj
   
     bool StringParser::isIPAddress(char* str, uint8_t size)
     {
-      char n[4] = {0};
-      uint8_t iStr = 0;
-      char* p = &str[iStr];
-  
-      for (uint8_t j = 0; j < 4; j++)
-      {
-  
-        uint8_t i = 0;
-        for (i = 0; i < 4 && p[iStr] != '.' && p[iStr] != '\0'; i++)
-        {
-          n[i] = p[iStr++];
-  
-          if (n[i] < '0' || n[i] > '9')
-          {
-            break;
-          }
-        }
-        if ( p[iStr] == '.' || p[iStr] == '\0')
-        {
-          n[i] = '\0';
-          memset(n, 0, 4);
-          iStr++;
-        }
-        else
-        {
-          return false;
-        }
-  
-      }
-      return true;
+      uint8_t ip[4] = {0};
+
+      return toIPAddress(str, ip, size);
     }
   
     bool StringParser::toIPAddress(char* str, uint8_t*ip, uint8_t size)
     {
-      char *field;
-      char *p = str;
-      uint8_t nWord = 0;
+      // The string is split in place: it is neither copied nor changed
+      StringTokenizer t(str, '.', size);
   
-      while ((field = strtok_r(p, ".", &p)) != NULL)  // Don't use \n here it fails
+      for (uint8_t nWord = 0; nWord < 4; nWord++)
       {
-        if (nWord < 4)
-        {
-          uint8_t n = 0;
-          if (!StringParser::toInt(field, n, strlen(field ) + 1))
-          {
-            return false;
-          }
-          else
-          {
-            if (n > 255)
-            {
-              return false;
-            }
-            ip[nWord++] = n;
-          }
-        }
-        else
+        if ( !t.next(ip[nWord]) )
         {
           return false;
         }
       }
   
-      return true;
+      return !t.hasNext();
     }
   
     bool StringParser::isFloatStr(char* str, uint8_t size)
@@ -120,7 +77,7 @@ namespace smrtobj
         i++;
       }
   
-      for (; i < strlen(str) && (i < size); i++)
+      for (; str[i] != '\0' && (i < size); i++)
       {
         if (str[i] == '.' && d)
         {
@@ -153,82 +110,27 @@ namespace smrtobj
   
     bool StringParser::toInt(char* str, uint8_t &n, uint8_t size)
     {
-      bool ret = true;
-  
-      if ( !isDigitStr(str, size) )
-      {
-        ret = false;
-      }
-      else
-      {
-        n = atoi(str);
-      }
-  
-      return ret;
+      return toInteger(str, n, size);
     }
   
     bool StringParser::toInt(char* str, int &n, uint8_t size)
     {
-      bool ret = true;
-  
-      if ( !isDigitStr(str, size) )
-      {
-        ret = false;
-      }
-      else
-      {
-        n = atoi(str);
-      }
-  
-      return ret;
+      return toInteger(str, n, size);
     }
   
     bool StringParser::toInt(char* str, unsigned int &n, uint8_t size)
     {
-      bool ret = true;
-  
-      if ( !isDigitStr(str, size) )
-      {
-        ret = false;
-      }
-      else
-      {
-        n = (unsigned int) atol(str);
-      }
-  
-      return ret;
+      return toInteger(str, n, size);
     }
   
     bool StringParser::toLong(char* str, unsigned long &n, uint8_t size)
     {
-      bool ret = true;
-  
-      if ( !isDigitStr(str, size) )
-      {
-        ret = false;
-      }
-      else
-      {
-        n = atol(str);
-     }
-   
-      return ret;
+      return toInteger(str, n, size);
     }
   
     bool StringParser::toLong(char* str, long &n, uint8_t size)
     {
-      bool ret = true;
-  
-      if ( !isDigitStr(str, size) )
-      {
-        ret = false;
-      }
-      else
-      {
-        n = atol(str);
-      }
-  
-      return ret;
+      return toInteger(str, n, size);
     }
   
     bool StringParser::toFloat(char* str, float &n, uint8_t size)
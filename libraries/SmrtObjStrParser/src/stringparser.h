@@ -44,63 +44,86 @@ namespace smrtobj
   
         /**
          * Parses the string str interpreting its content as an integral number of 8 bits and save it in the variable n.
-         * It returns false if the string is not a number.
+         * It returns false if the string is not a number or if the number does not fit in n.
+         * An empty string is not a number: it is rejected (before the single pass parsing it was read as 0).
          *
          * \param[in] str string with the representation of an integral number.
          * \param[out] n 8 bit variable where it is saved the number to return.
          * \param[in] size maximum size of string str.
            *
-         * \return false if the string is not a number.
+         * \return false if the string is not a number or if it is out of range.
          */
         static bool toInt(char* str, uint8_t &n, uint8_t size = 255);
   
         /**
          * Parses the string str interpreting its content as an integral number of 16 bits and save it in the variable n.
-         * It returns false if the string is not a number.
+         * It returns false if the string is not a number or if the number does not fit in n.
+         * An empty string is not a number: it is rejected (before the single pass parsing it was read as 0).
          *
          * \param[in] str string with the representation of an integral number.
          * \param[out] n 16 bit variable where it is saved the number to return.
          * \param[in] size maximum size of string str.
            *
-         * \return false if the string is not a number.
+         * \return false if the string is not a number or if it is out of range.
          */
         static bool toInt(char* str, int &n, uint8_t size = 255);
   
         /**
          * Parses the string str interpreting its content as an unsigned integral number of 16 bits and save it in the variable n.
-         * It returns false if the string is not a number.
+         * It returns false if the string is not a number or if the number does not fit in n.
+         * An empty string is not a number: it is rejected (before the single pass parsing it was read as 0).
          *
          * \param[in] str string with the representation of an integral number.
          * \param[out] n unsigned 16 bit variable where it is saved the number to return.
          * \param[in] size maximum size of string str.
            *
-         * \return false if the string is not a number.
+         * \return false if the string is not a number or if it is out of range.
          */
         static bool toInt(char* str, unsigned int &n, uint8_t size);
   
         /**
          * Parses the string str interpreting its content as an unsigned integral number of 32 bits and save it in the variable n.
-         * It returns false if the string is not a number.
+         * It returns false if the string is not a number or if the number does not fit in n.
+         * An empty string is not a number: it is rejected (before the single pass parsing it was read as 0).
          *
          * \param[in] str string with the representation of an integral number.
          * \param[out] n 32 bit variable where it is saved the number to return.
          * \param[in] size maximum size of string str.
            *
-         * \return false if the string is not a number.
+         * \return false if the string is not a number or if it is out of range.
          */
         static bool toLong(char* str, long &n, uint8_t size);
   
         /**
          * Parses the string str interpreting its content as an integral number of 32 bits and save it in the variable n.
-         * It returns false if the string is not a number.
+         * It returns false if the string is not a number or if the number does not fit in n.
+         * An empty string is not a number: it is rejected (before the single pass parsing it was read as 0).
          *
          * \param[in] str string with the representation of an integral number.
          * \param[out] n 32 bit variable where it is saved the number to return.
          * \param[in] size maximum size of string str.
            *
-         * \return false if the string is not a number.
+         * \return false if the string is not a number or if it is out of range.
          */
         static bool toLong(char* str, unsigned long &n, uint8_t size);
+
+        /**
+         * Parses the integral number at the beginning of the string str in a single pass, saving it in the
+         * variable n. Digits are validated, accumulated and range-checked against the type of n in the same loop,
+         * so a value that does not fit (e.g. "300" for an uint8_t) is rejected instead of being truncated.
+         * A leading sign ('+' or '-') is accepted only if the type of n is signed.
+         * The parsing stops at the first character that is not a digit, at the string terminator or after
+         * size characters; n is not changed if the function fails. An empty string has no digits, so it fails
+         * (the toInt and toLong functions, that use this one, no longer read it as 0).
+         *
+         * \param[in] str string with the representation of an integral number.
+         * \param[out] n variable where it is saved the number to return.
+         * \param[in] size maximum number of characters to parse.
+         *
+         * \return number of characters consumed (sign included), 0 if there are no digits or the number is out of range.
+         */
+        template <typename T>
+        static uint8_t parseInt(const char* str, T &n, uint8_t size = 255);
   
         /**
          * Parses the string str interpreting its content as a floating point number and save it in the variable n.
@@ -116,7 +139,9 @@ namespace smrtobj
   
         /**
          * Parses the string str interpreting its content as an IP address (array of 4 integral number of 8 bits).
-         * It returns false if the string is not a IP address.
+         * It returns false if the string is not a IP address. The string is not modified.
+         * Every octet must have at least one digit: a string with an empty octet (e.g. "1..2.3") is rejected,
+         * while it was read as 1.0.2.3 before the single pass parsing.
          *
          * \param[in] str string with the representation of an IP address.
          * \param[out] ip array whey the octets are saved.
@@ -138,8 +163,8 @@ namespace smrtobj
         static bool isDigitStr(char* str, uint8_t size = 255);
   
         /**
-         * Checks if the string str contains an IP address.
-         * It returns false if the string is not an IP address.
+         * Checks if the string str contains an IP address (see smrtobj::parser::StringParser::toIPAddress).
+         * It returns false if the string is not an IP address, e.g. if an octet is empty ("1..2.3").
          *
          * \param[in] str string with the representation of an IP address.
          * \param[in] size maximum size of string str.
@@ -184,7 +209,101 @@ namespace smrtobj
          * /
          static bool readStringFromFlash(const char str[] PROGMEM, char* buf, uint8_t size_b);
          */
+
+      private:
+        /**
+         * Parses the whole string str as an integral number. It fails if the string contains any character that
+         * is not a digit or if it is not terminated within size characters.
+         *
+         * \param[in] str string with the representation of an integral number.
+         * \param[out] n variable where it is saved the number to return.
+         * \param[in] size maximum size of string str.
+         *
+         * \return false if the string is not a number or if the number is out of range.
+         */
+        template <typename T>
+        static bool toInteger(const char* str, T &n, uint8_t size);
+    };
+
+    /**
+     * Range of an integral type. It replaces std::numeric_limits, which is not available on AVR.
+     */
+    template <typename T>
+    struct IntegerRange
+    {
+      //! true if the type is signed
+      static const bool IS_SIGNED = ((T) -1) < ((T) 0);
+
+      //! Maximum value: 2^(n-1) - 1 for signed types, 2^n - 1 for unsigned ones
+      static const T MAX = IS_SIGNED ? (T) ((((T) 1 << (sizeof(T) * 8 - 2)) - 1) * 2 + 1) : (T) ~((T) 0);
+
+      //! Minimum value: -2^(n-1) for signed types, 0 for unsigned ones
+      static const T MIN = IS_SIGNED ? (T) (-MAX - 1) : (T) 0;
     };
+
+    template <typename T>
+    uint8_t StringParser::parseInt(const char* str, T &n, uint8_t size)
+    {
+      uint8_t i = 0;
+      bool neg = false;
+      T value = 0;
+
+      if ( IntegerRange<T>::IS_SIGNED && size > 0 && (str[0] == '-' || str[0] == '+') )
+      {
+        neg = (str[0] == '-');
+        i++;
+      }
+
+      uint8_t first = i;
+
+      for (; i < size && str[i] >= '0' && str[i] <= '9'; i++)
+      {
+        uint8_t d = str[i] - '0';
+
+        // Negative numbers are accumulated downwards, so the minimum value is reachable
+        if (neg)
+        {
+          if ( value < (IntegerRange<T>::MIN + d) / 10 )
+          {
+            return 0;
+          }
+          value = value * 10 - d;
+        }
+        else
+        {
+          if ( value > (IntegerRange<T>::MAX - d) / 10 )
+          {
+            return 0;
+          }
+          value = value * 10 + d;
+        }
+      }
+
+      if (i == first)
+      {
+        return 0;
+      }
+
+      n = value;
+
+      return i;
+    }
+
+    template <typename T>
+    bool StringParser::toInteger(const char* str, T &n, uint8_t size)
+    {
+      T value = 0;
+      uint8_t len = parseInt(str, value, size);
+
+      if ( len == 0 || len >= size || str[len] != '\0' )
+      {
+        return false;
+      }
+
+      n = value;
+
+      return true;
+    }
   
   } /* namespace parser */
   
@@ -0,0 +1,187 @@
+/**
+ * \file stringtokenizer.cpp
+ * \brief Arduino library to split delimited strings without copying or changing them.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+
+#include "stringtokenizer.h"
+
+namespace smrtobj
+{
+
+  namespace parser
+  {
+
+    /**********************************************************************************
+     * StringToken
+     **********************************************************************************/
+    StringToken::StringToken() : m_str(0), m_len(0)
+    {
+    }
+
+    StringToken::StringToken(const char* str, uint8_t len) : m_str(str), m_len(len)
+    {
+    }
+
+    StringToken::StringToken(const StringToken &t)
+    {
+      m_str = t.m_str;
+      m_len = t.m_len;
+    }
+
+    StringToken & StringToken::operator=(const StringToken &t)
+    {
+      m_str = t.m_str;
+      m_len = t.m_len;
+
+      return (*this);
+    }
+
+    bool StringToken::equals(const char* str) const
+    {
+      for (uint8_t i = 0; i < m_len; i++)
+      {
+        if ( str[i] != m_str[i] )
+        {
+          return false;
+        }
+      }
+
+      return ( str[m_len] == '\0' );
+    }
+
+    bool StringToken::to(float &n) const
+    {
+      uint8_t i = 0;
+      bool neg = false;
+      bool digits = false;
+      float value = 0;
+      float div = 1;
+
+      if ( m_len > 0 && (m_str[0] == '-' || m_str[0] == '+') )
+      {
+        neg = (m_str[0] == '-');
+        i++;
+      }
+
+      // Integer part
+      for (; i < m_len && m_str[i] >= '0' && m_str[i] <= '9'; i++)
+      {
+        value = value * 10 + (m_str[i] - '0');
+        digits = true;
+      }
+
+      // Decimal part
+      if ( i < m_len && m_str[i] == '.' )
+      {
+        for (i++; i < m_len && m_str[i] >= '0' && m_str[i] <= '9'; i++)
+        {
+          value = value * 10 + (m_str[i] - '0');
+          div *= 10;
+          digits = true;
+        }
+      }
+
+      if ( !digits || i != m_len )
+      {
+        return false;
+      }
+
+      value /= div;
+      n = (neg) ? -value : value;
+
+      return true;
+    }
+
+    /**********************************************************************************
+     * StringTokenizer
+     **********************************************************************************/
+    StringTokenizer::StringTokenizer(const char* str, char delim, uint8_t size) :
+        m_str(str), m_size(size), m_delim(delim), m_pos(0), m_done(false)
+    {
+    }
+
+    StringTokenizer::StringTokenizer(const StringToken &token, char delim) :
+        m_str(token.data()), m_size(token.length()), m_delim(delim), m_pos(0), m_done(false)
+    {
+    }
+
+    StringTokenizer::StringTokenizer(const StringTokenizer &t)
+    {
+      m_str = t.m_str;
+      m_size = t.m_size;
+      m_delim = t.m_delim;
+      m_pos = t.m_pos;
+      m_done = t.m_done;
+    }
+
+    StringTokenizer & StringTokenizer::operator=(const StringTokenizer &t)
+    {
+      m_str = t.m_str;
+      m_size = t.m_size;
+      m_delim = t.m_delim;
+      m_pos = t.m_pos;
+      m_done = t.m_done;
+
+      return (*this);
+    }
+
+    void StringTokenizer::reset()
+    {
+      m_pos = 0;
+      m_done = false;
+    }
+
+    bool StringTokenizer::next(StringToken &token)
+    {
+      if (m_done)
+      {
+        return false;
+      }
+
+      uint8_t start = m_pos;
+
+      while ( m_pos < m_size && m_str[m_pos] != '\0' && m_str[m_pos] != m_delim )
+      {
+        m_pos++;
+      }
+
+      token = StringToken(&m_str[start], m_pos - start);
+
+      // Skip the delimiter, otherwise this is the last field
+      if ( m_pos < m_size && m_str[m_pos] == m_delim )
+      {
+        m_pos++;
+      }
+      else
+      {
+        m_done = true;
+      }
+
+      return true;
+    }
+
+    bool StringTokenizer::next(float &n)
+    {
+      StringToken token;
+
+      if ( !next(token) )
+      {
+        return false;
+      }
+
+      return token.to(n);
+    }
+
+    bool StringTokenizer::skip()
+    {
+      StringToken token;
+
+      return next(token);
+    }
+
+  } /* namespace parser */
+
+} /* namespace smrtobj */
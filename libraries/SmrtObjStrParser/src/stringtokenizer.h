@@ -0,0 +1,278 @@
+/**
+ * \file stringtokenizer.h
+ * \brief Arduino library to split delimited strings without copying or changing them.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+
+#ifndef STRINGTOKENIZER_H_
+#define STRINGTOKENIZER_H_
+
+#if ARDUINO >= 100
+#include "Arduino.h"       // for delayMicroseconds, digitalPinToBitMask, etc
+#else
+#include "WProgram.h"      // for delayMicroseconds
+#include "pins_arduino.h"  // for digitalPinToBitMask, etc
+#endif
+
+#include "stringparser.h"
+
+namespace smrtobj
+{
+
+  namespace parser
+  {
+
+    /**
+     * StringToken is a field of a string: a pointer to its first character and its length. The field is
+     * not terminated by '\\0' and it is never copied, so the source buffer must be valid as long as the
+     * token is used.
+     */
+    class StringToken
+    {
+      public:
+        /**
+         * Default Constructor.
+         * It creates an empty token.
+         */
+        StringToken();
+
+        /**
+         * Constructor.
+         *
+         * \param[in] str pointer to the first character of the field
+         * \param[in] len number of characters of the field
+         */
+        StringToken(const char* str, uint8_t len);
+
+        /**
+         * Copy Constructor.
+         *
+         * \param[in] t source token
+         */
+        StringToken(const StringToken &t);
+
+        /**
+         * Override operator =
+         *
+         * \param[in] t source token
+         *
+         * \return reference to the destination token
+         */
+        StringToken & operator=(const StringToken &t);
+
+        /**
+         * Gets the pointer to the first character of the field (not terminated by '\\0').
+         *
+         * \return pointer to the field
+         */
+        const char* data() const { return m_str; }
+
+        /**
+         * Gets the number of characters of the field.
+         *
+         * \return field length
+         */
+        uint8_t length() const { return m_len; }
+
+        /**
+         * Checks if the field is empty.
+         *
+         * \return true if the field has no characters
+         */
+        bool isEmpty() const { return (m_len == 0); }
+
+        /**
+         * Compares the field with a string terminated by '\\0'.
+         *
+         * \param[in] str string to compare
+         *
+         * \return true if the field and the string are equal
+         */
+        bool equals(const char* str) const;
+
+        /**
+         * Converts the whole field to an integral number (see smrtobj::parser::StringParser::parseInt).
+         *
+         * \param[out] n variable where it is saved the number; it is not changed if the conversion fails.
+         *
+         * \return false if the field is not a number or if the number does not fit in n.
+         */
+        template <typename T>
+        bool to(T &n) const;
+
+        /**
+         * Converts the whole field to a floating point number ([+|-]digits[.digits]).
+         *
+         * \param[out] n variable where it is saved the number; it is not changed if the conversion fails.
+         *
+         * \return false if the field is not a floating point number.
+         */
+        bool to(float &n) const;
+
+      private:
+        //! First character of the field
+        const char* m_str;
+
+        //! Field length
+        uint8_t m_len;
+    };
+
+    /**
+     * StringTokenizer splits a string into the fields separated by a delimiter character (e.g. the octets of
+     * an IP address, the values of a CSV row or a key=value pair). Differently from strtok, the source buffer
+     * is never written: every field is returned as a smrtobj::parser::StringToken pointing into it, so a
+     * record can be parsed directly into the buffer where it has been received.
+     *
+     * Two consecutive delimiters produce an empty field, and a string ending with the delimiter has an empty
+     * last field.
+     *
+     * \code{.cpp}
+     * const char row[] = "21,45.3,1013";
+     * smrtobj::parser::StringTokenizer t(row, ',');
+     *
+     * uint8_t id = 0;
+     * float rh = 0;
+     * unsigned int p = 0;
+     *
+     * if ( t.next(id) && t.next(rh) && t.next(p) && !t.hasNext() )
+     * {
+     *   ...
+     * }
+     * \endcode
+     */
+    class StringTokenizer
+    {
+      public:
+        /**
+         * Constructor.
+         *
+         * \param[in] str string to split. It ends at the first '\\0' or after size characters.
+         * \param[in] delim delimiter character
+         * \param[in] size maximum size of string str.
+         */
+        StringTokenizer(const char* str, char delim, uint8_t size = 255);
+
+        /**
+         * Constructor.
+         * It splits a field returned by an other tokenizer (e.g. a key=value pair of a record).
+         *
+         * \param[in] token field to split
+         * \param[in] delim delimiter character
+         */
+        StringTokenizer(const StringToken &token, char delim);
+
+        /**
+         * Copy Constructor.
+         *
+         * \param[in] t source tokenizer
+         */
+        StringTokenizer(const StringTokenizer &t);
+
+        /**
+         * Override operator =
+         *
+         * \param[in] t source tokenizer
+         *
+         * \return reference to the destination tokenizer
+         */
+        StringTokenizer & operator=(const StringTokenizer &t);
+
+        /**
+         * Restarts from the first field.
+         */
+        void reset();
+
+        /**
+         * Checks if there are other fields to read.
+         *
+         * \return true if next returns a field
+         */
+        bool hasNext() const { return !m_done; }
+
+        /**
+         * Gets the next field.
+         *
+         * \param[out] token next field
+         *
+         * \return false if there are no more fields
+         */
+        bool next(StringToken &token);
+
+        /**
+         * Gets the next field as an integral number.
+         *
+         * \param[out] n variable where it is saved the number
+         *
+         * \return false if there are no more fields, if the field is not a number or if it does not fit in n.
+         */
+        template <typename T>
+        bool next(T &n);
+
+        /**
+         * Gets the next field as a floating point number.
+         *
+         * \param[out] n variable where it is saved the number
+         *
+         * \return false if there are no more fields or if the field is not a floating point number.
+         */
+        bool next(float &n);
+
+        /**
+         * Skips the next field.
+         *
+         * \return false if there are no more fields
+         */
+        bool skip();
+
+      private:
+        //! String to split
+        const char* m_str;
+
+        //! Maximum size of the string
+        uint8_t m_size;
+
+        //! Delimiter character
+        char m_delim;
+
+        //! Position of the next field
+        uint8_t m_pos;
+
+        //! true when all fields have been read
+        bool m_done;
+    };
+
+    template <typename T>
+    bool StringToken::to(T &n) const
+    {
+      T value = 0;
+
+      if ( m_len == 0 || StringParser::parseInt(m_str, value, m_len) != m_len )
+      {
+        return false;
+      }
+
+      n = value;
+
+      return true;
+    }
+
+    template <typename T>
+    bool StringTokenizer::next(T &n)
+    {
+      StringToken token;
+
+      if ( !next(token) )
+      {
+        return false;
+      }
+
+      return token.to(n);
+    }
+
+  } /* namespace parser */
+
+} /* namespace smrtobj */
+
+#endif /* STRINGTOKENIZER_H_ */
@@ -0,0 +1,66 @@
+/*
+ * TimerWheel.ino
+ * Example showing periodic and one-shot tasks scheduled by a timer wheel.
+ * The led blinks every 500 milliseconds, a message is printed on serial
+ * monitor every 10 seconds and, 30 seconds after the start, the blink is
+ * stopped.
+ * 
+ * The loop only calls tick(): millis() is read once and only the expired
+ * tasks are called.
+ * 
+ * Authors:
+ *         Marco Boeris Frusca 
+ * 
+ */
+#include <Time.h>
+#include <timerwheel.h>
+
+#define LED 13
+
+//! Scheduler with 1 ms resolution
+smrtobj::timer::TimerWheel wheel;
+
+void blink(smrtobj::timer::TimerTask &t)
+{
+  digitalWrite(LED, !digitalRead(LED));
+}
+
+void report(smrtobj::timer::TimerTask &t)
+{
+  Serial.print( "Tick at " );
+  Serial.print( wheel.time() );
+  Serial.print( "ms, tasks " );
+  Serial.println( wheel.count() );
+}
+
+void timeout(smrtobj::timer::TimerTask &t)
+{
+  // The task to stop is the user data of this task
+  wheel.stop( *(smrtobj::timer::TimerTask *) t.context() );
+  digitalWrite(LED, LOW);
+  Serial.println( "Blink stopped" );
+}
+
+//! Tasks
+smrtobj::timer::TimerTask led(blink);
+smrtobj::timer::TimerTask monitor(report);
+smrtobj::timer::TimerTask end(timeout, &led);
+
+void setup() {
+  // Open serial port to debug
+  Serial.begin(9600);
+  pinMode(LED, OUTPUT);
+
+  // Periodic tasks
+  wheel.start(led, 500, 500);
+  wheel.start(monitor, 0, 10000);
+
+  // One-shot task
+  wheel.start(end, 30000);
+}
+
+void loop() {
+  wheel.tick();
+
+  //put your code here
+}
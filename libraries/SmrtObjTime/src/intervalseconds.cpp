@@ -18,18 +18,24 @@
     IntervalSeconds::IntervalSeconds()
     {
       m_start = now();
+      m_minute = 0;
+      m_format = NO_FORMAT;
       memset(m_buffer, 0, SIZE_BUFFER);
     }
   
     IntervalSeconds::IntervalSeconds(unsigned long start)
     {
       m_start = start;
+      m_minute = 0;
+      m_format = NO_FORMAT;
       memset(m_buffer, 0, SIZE_BUFFER);
     }
   
     IntervalSeconds::IntervalSeconds(const IntervalSeconds& s)
     {
       m_start = s.m_start;
+      m_minute = s.m_minute;
+      m_format = s.m_format;
       memcpy(m_buffer, s.m_buffer, SIZE_BUFFER);
     }
   
@@ -40,6 +46,7 @@
     IntervalSeconds& IntervalSeconds::operator=(const IntervalSeconds& s)
     {
       m_start = s.m_start;
+      m_format = NO_FORMAT;
   
       return *this;
     }
@@ -62,22 +69,80 @@
       }
     }
   
+    //! Two digits of the numbers from 0 to 99
+    static const char DIGITS[] PROGMEM =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    void IntervalSeconds::writeDigits(char *str, uint8_t value)
+    {
+      const char *p = &(DIGITS[value << 1]);
+
+      str[0] = pgm_read_byte(p);
+      str[1] = pgm_read_byte(p + 1);
+    }
+
+    void IntervalSeconds::civilFromDays(unsigned int days, unsigned int &y, uint8_t &m, uint8_t &d)
+    {
+      // Days from 0000-03-01: years start in March, so the leap day is the last day of the year
+      unsigned long z = days + 719468UL;
+      unsigned long era = z / 146097UL;
+      unsigned long doe = z - era * 146097UL;
+
+      // Year, day of the year and month (from March) of the era
+      unsigned int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+      unsigned int doy = doe - (365UL * yoe + yoe / 4 - yoe / 100);
+      uint8_t mp = (5 * doy + 2) / 153;
+
+      d = doy - (153 * mp + 2) / 5 + 1;
+      m = (mp < 10) ? mp + 3 : mp - 9;
+      y = era * 400 + yoe + ((m <= 2) ? 1 : 0);
+    }
+
     char *IntervalSeconds::getTimeAsString(byte format)
     {
-      int hh = hour(m_start);
-      int mm = minute(m_start);
-      int ss = second(m_start);
-      int DD = day(m_start);
-      int MM = month(m_start);
-      int YY = year(m_start);
-  
+      unsigned long ss = m_start - m_minute;
+
+      // Same minute of the buffer: only seconds change
+      if (format == m_format && m_start >= m_minute && ss < 60)
+      {
+        if (format != IOT)
+        {
+          writeDigits(&(m_buffer[17]), ss);
+        }
+
+        return m_buffer;
+      }
+
+      // One decomposition of the start time
+      unsigned long minutes = m_start / 60;
+      unsigned long hours = minutes / 60;
+      unsigned int days = hours / 24;
+
+      uint8_t mm = minutes - hours * 60;
+      uint8_t hh = hours - (unsigned long) days * 24;
+
+      unsigned int YY = 0;
+      uint8_t MM = 0;
+      uint8_t DD = 0;
+
+      civilFromDays(days, YY, MM, DD);
+
+      ss = m_start - minutes * 60;
+      m_minute = m_start - ss;
+
       char *pYear = 0;
       char *pMonth = 0;
       char *pDay = 0;
-      char *pHour = 0;
-      char *pminute = 0;
-      char *pSecond = 0;
-  
+
       // Set constant char into string (form used is xx/xx/xxxx xx:xx:xx
       m_buffer[2] = '/';
       m_buffer[5] = '/';
@@ -85,7 +150,7 @@
       m_buffer[13] = ':';
       m_buffer[16] = ':';
       m_buffer[19] = '\0';
-  
+
       switch (format)
       {
         case EN:
@@ -93,112 +158,54 @@
           pYear = &(m_buffer[6]);
           pMonth = &(m_buffer[0]);
           pDay = &(m_buffer[3]);
-          pHour = &(m_buffer[11]);
-          pminute = &(m_buffer[14]);
-          pSecond = &(m_buffer[17]);
         }
         break;
-  
+
         case IOT:
         {
           pYear = &(m_buffer[6]);
           pMonth = &(m_buffer[0]);
           pDay = &(m_buffer[3]);
-          pHour = &(m_buffer[11]);
-          pminute = &(m_buffer[14]);
-          pSecond = 0;
           m_buffer[16] = '\0';
         }
         break;
-    
-        default:
+
+        case ISO:
         {
-         pYear = &(m_buffer[6]);
-           pMonth = &(m_buffer[3]);
-          pDay = &(m_buffer[0]);
-          pHour = &(m_buffer[11]);
-          pminute = &(m_buffer[14]);
-         pSecond = &(m_buffer[17]);
+          // Form used is xxxx-xx-xxTxx:xx:xx
+          pYear = &(m_buffer[0]);
+          pMonth = &(m_buffer[5]);
+          pDay = &(m_buffer[8]);
+          m_buffer[4] = '-';
+          m_buffer[7] = '-';
+          m_buffer[10] = 'T';
         }
         break;
-      }
-  
-      // Month
-      if (MM < 10)
-      {
-        pMonth[0] = '0';
-        pMonth[1] = '0' + MM;
-      } else
-      {
-        pMonth[0] = '0' + ((MM / 10) % 10);
-        pMonth[1] = '0' + (MM % 10);
-      }
-  
-      // Day
-      if (DD < 10)
-      {
-        pDay[0] = '0';
-        pDay[1] = '0' + DD;
-      } else
-      {
-        pDay[0] = '0' + ((DD / 10) % 10);
-        pDay[1] = '0' + (DD % 10);
-      }
-  
-      //Year
-      pYear[0] = '0' + ((YY / 1000) % 10);
-      pYear[1] = '0' + ((YY / 100) % 10);
-      pYear[2] = '0' + ((YY / 10) % 10);
-      pYear[3] = '0' + (YY % 10);
-  
-      //Hour
-      if (hh >= 24)
-      {
-        //TODO: testare se questa condizione e' davvero necessaria: ovvero alla mezzanotte restituisce il valore 24?
-        pHour[0] = '0';
-        pHour[1] = '0';
-      }
-      else
-      {
-        if (hh < 10)
-        {
-          pHour[0] = '0';
-          pHour[1] = '0' + hh;
-        } 
-        else
+
+        default:
         {
-          pHour[0] = '0' + ((hh / 10) % 10);
-         pHour[1] = '0' + (hh % 10);
+          pYear = &(m_buffer[6]);
+          pMonth = &(m_buffer[3]);
+          pDay = &(m_buffer[0]);
+          format = DEFAULT_TF;
         }
+        break;
       }
-  
-      //Minute
-      if (mm < 10)
-      {
-        pminute[0] = '0';
-        pminute[1] = '0' + mm;
-      }
-      else
+
+      writeDigits(pYear, YY / 100);
+      writeDigits(pYear + 2, YY % 100);
+      writeDigits(pMonth, MM);
+      writeDigits(pDay, DD);
+      writeDigits(&(m_buffer[11]), hh);
+      writeDigits(&(m_buffer[14]), mm);
+
+      if (format != IOT)
       {
-        pminute[0] = '0' + ((mm / 10) % 10);
-        pminute[1] = '0' + (mm % 10);
+        writeDigits(&(m_buffer[17]), ss);
       }
-  
-      if (pSecond)
-      {
-        //Seconds
-        if (ss < 10)
-        {
-          pSecond[0] = '0';
-          pSecond[1] = '0' + ss;
-        }
-        else
-        {
-          pSecond[0] = '0' + ((ss / 10) % 10);
-          pSecond[1] = '0' + (ss % 10);
-        }
-      }
-  
+
+      m_format = format;
+
       return m_buffer;
     }
     
@@ -36,6 +36,9 @@ namespace smrtobj
           //! Internal buffer size
           SIZE_BUFFER = 20,
         };
+
+        //! Format of an empty buffer
+        static const byte NO_FORMAT = 0xFF;
   
         /**
          * \enum   _time_format
@@ -50,6 +53,8 @@ namespace smrtobj
           EN = 1,
           //! Default format: MM/DD/YYYY hh:mm
           IOT = 2,
+          //! ISO 8601 format: YYYY-MM-DDThh:mm:ss
+          ISO = 3,
         };
   
         /**
@@ -105,7 +110,9 @@ namespace smrtobj
         virtual unsigned long time();
   
         /**
-         * Gets time in readable form as a string.
+         * Gets time in readable form as a string. The date is computed with integer operations only; if
+         * the start time is in the same minute of the previous call (with the same format), only the
+         * seconds are updated.
          *
          * \param[in] format format time accorting to #_time_format
          *
@@ -120,8 +127,32 @@ namespace smrtobj
         IntervalSeconds& operator=(const IntervalSeconds&);
   
       private:
+        /**
+         * Converts a number of days from 1970-01-01 to a date.
+         *
+         * \param[in] days days from 1970-01-01
+         * \param[out] y year
+         * \param[out] m month (1 - 12)
+         * \param[out] d day of the month (1 - 31)
+         */
+        static void civilFromDays(unsigned int days, unsigned int &y, uint8_t &m, uint8_t &d);
+
+        /**
+         * Writes a number as two digits.
+         *
+         * \param[out] str string
+         * \param[in] value number (0 - 99)
+         */
+        static void writeDigits(char *str, uint8_t value);
+
         //! Internal buffer. It is used to get time in readable form
         char m_buffer[SIZE_BUFFER];
+
+        //! Start of the minute written in the buffer
+        unsigned long m_minute;
+
+        //! Format of the buffer, NO_FORMAT if the buffer is empty
+        byte m_format;
   
     };
   
@@ -16,4 +16,8 @@
 #include <intervalseconds.h>
 #include <intervalmicroseconds.h>
 
+// Scheduler
+#include <timertask.h>
+#include <timerwheel.h>
+
 #endif /* SMRTOBJTIME_H_ */
@@ -0,0 +1,67 @@
+/*
+ * timertask.cpp
+ *         One-shot or periodic function call scheduled by TimerWheel.
+ *
+ * Authors:
+ *         Marco Boeris Frusca
+ *
+ */
+
+#include "timertask.h"
+
+namespace smrtobj
+{
+
+  namespace timer
+  {
+
+    TimerTask::TimerTask() :
+        m_callback(0),
+        m_context(0),
+        m_expires(0),
+        m_period(0),
+        m_next(0),
+        m_pprev(0)
+    {
+    }
+
+    TimerTask::TimerTask(callback_t callback, void *context) :
+        m_callback(callback),
+        m_context(context),
+        m_expires(0),
+        m_period(0),
+        m_next(0),
+        m_pprev(0)
+    {
+    }
+
+    TimerTask::TimerTask(const TimerTask &t) :
+        m_expires(0),
+        m_period(0),
+        m_next(0),
+        m_pprev(0)
+    {
+      (*this) = t;
+    }
+
+    TimerTask::~TimerTask()
+    {
+    }
+
+    TimerTask& TimerTask::operator=(const TimerTask &t)
+    {
+      m_callback = t.m_callback;
+      m_context = t.m_context;
+
+      return (*this);
+    }
+
+    void TimerTask::setCallback(callback_t callback, void *context)
+    {
+      m_callback = callback;
+      m_context = context;
+    }
+
+  } /* namespace timer */
+
+} /* namespace smrtobj */
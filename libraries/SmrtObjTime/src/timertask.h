@@ -0,0 +1,145 @@
+/**
+ * \file timertask.h
+ * \brief  TimerTask is a one-shot or periodic function call scheduled by smrtobj::timer::TimerWheel.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef TIMERTASK_H_
+#define TIMERTASK_H_
+
+#if ARDUINO >= 100
+#include "Arduino.h"       // for delayMicroseconds, digitalPinToBitMask, etc
+#else
+#include "WProgram.h"      // for delayMicroseconds
+#include "pins_arduino.h"  // for digitalPinToBitMask, etc
+#endif
+
+namespace smrtobj
+{
+
+  namespace timer
+  {
+
+    class TimerWheel;
+
+    /**
+     * The TimerTask class describes a function called by a smrtobj::timer::TimerWheel when a time has
+     * expired. A task started with a period of 0 is called only once (one-shot), otherwise it is
+     * called every period until it is stopped.
+     *
+     * The wheel does not copy the task: it must exist until it is stopped or, for one-shot tasks,
+     * until it is called.
+     *
+     * \code{.cpp}
+     * void blink(smrtobj::timer::TimerTask &t)
+     * {
+     *   digitalWrite(13, !digitalRead(13));
+     * }
+     *
+     * smrtobj::timer::TimerWheel wheel;
+     * smrtobj::timer::TimerTask led(blink);
+     *
+     * wheel.start(led, 500, 500);
+     * \endcode
+     */
+    class TimerTask
+    {
+      public:
+        /**
+         * Function called when the task expires.
+         *
+         * \param[in] t expired task
+         */
+        typedef void (*callback_t)(TimerTask &t);
+
+        /**
+         * Default Constructor.
+         * It creates a task without function.
+         */
+        TimerTask();
+
+        /**
+         * Constructor.
+         *
+         * \param[in] callback function called when the task expires
+         * \param[in] context user data available with smrtobj::timer::TimerTask::context
+         */
+        TimerTask(callback_t callback, void *context = 0);
+
+        /**
+         * Copy Constructor. The copy is not scheduled.
+         *
+         * \param[in] t source task
+         */
+        TimerTask(const TimerTask &t);
+
+        /**
+         * Destructor.
+         */
+        virtual ~TimerTask();
+
+        /**
+         * Overload operator =. The function and the user data are copied, the schedule is not.
+         *
+         * \param[in] t source task
+         */
+        TimerTask& operator=(const TimerTask &t);
+
+        /**
+         * Sets the function called when the task expires.
+         *
+         * \param[in] callback function, 0 to remove it
+         * \param[in] context user data available with smrtobj::timer::TimerTask::context
+         */
+        void setCallback(callback_t callback, void *context = 0);
+
+        /**
+         * Checks if the task is scheduled in a wheel.
+         *
+         * \return true if it is scheduled, false otherwise
+         */
+        bool isScheduled() const { return (m_pprev != 0); }
+
+        /**
+         * Gets the period of the task (in ticks of the wheel).
+         *
+         * \return period, 0 for one-shot tasks
+         */
+        unsigned long period() const { return m_period; }
+
+        /**
+         * Gets the user data set with the callback.
+         *
+         * \return user data
+         */
+        void* context() const { return m_context; }
+
+      private:
+        //! The wheel links and schedules tasks
+        friend class TimerWheel;
+
+        //! Function called when the task expires
+        callback_t m_callback;
+
+        //! User data
+        void *m_context;
+
+        //! Tick of the wheel when the task expires
+        unsigned long m_expires;
+
+        //! Period (in ticks), 0 for one-shot tasks
+        unsigned long m_period;
+
+        //! Next task in the same slot
+        TimerTask *m_next;
+
+        //! Link pointing to this task (slot or previous task), 0 if the task is not scheduled
+        TimerTask **m_pprev;
+    };
+
+  } /* namespace timer */
+
+} /* namespace smrtobj */
+
+#endif /* TIMERTASK_H_ */
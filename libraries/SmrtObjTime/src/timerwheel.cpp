@@ -0,0 +1,247 @@
+/*
+ * timerwheel.cpp
+ *         Hierarchical timer wheel calling one-shot and periodic tasks.
+ *
+ * Authors:
+ *         Marco Boeris Frusca
+ *
+ */
+
+#include "timerwheel.h"
+
+namespace smrtobj
+{
+
+  namespace timer
+  {
+
+    TimerWheel::TimerWheel(unsigned int resolution) :
+        m_ticks(0),
+        m_resolution((resolution > 0) ? resolution : 1),
+        m_count(0)
+    {
+      for (uint8_t l = 0; l < LEVELS; l++)
+      {
+        for (uint8_t s = 0; s < SLOTS; s++)
+        {
+          m_slots[l][s] = 0;
+        }
+      }
+
+      m_last = millis();
+    }
+
+    TimerWheel::~TimerWheel()
+    {
+    }
+
+    unsigned long TimerWheel::ticks(unsigned long ms) const
+    {
+      if (m_resolution == 1)
+      {
+        return ms;
+      }
+
+      return (ms / m_resolution) + ((ms % m_resolution) ? 1 : 0);
+    }
+
+    bool TimerWheel::start(TimerTask &t, unsigned long delay, unsigned long period)
+    {
+      unsigned long d = ticks(delay);
+      unsigned long p = ticks(period);
+
+      // Expiration ticks are compared as signed numbers
+      if (d > 0x7FFFFFFF || p > 0x7FFFFFFF)
+      {
+        return false;
+      }
+
+      if ( t.isScheduled() )
+      {
+        remove(t);
+        m_count--;
+      }
+
+      // The next tick to execute ends one tick after the last one
+      t.m_expires = m_ticks + d - 1;
+      t.m_period = p;
+
+      add(t);
+      m_count++;
+
+      return true;
+    }
+
+    bool TimerWheel::stop(TimerTask &t)
+    {
+      if ( !t.isScheduled() )
+      {
+        return false;
+      }
+
+      remove(t);
+      m_count--;
+
+      return true;
+    }
+
+    void TimerWheel::tick(unsigned long tref)
+    {
+      unsigned long now = (tref != 0) ? tref : millis();
+
+      // Unsigned difference: it is right also after the roll over of millis()
+      unsigned long n = now - m_last;
+
+      if (m_resolution != 1)
+      {
+        n /= m_resolution;
+      }
+
+      if (n == 0)
+      {
+        return;
+      }
+
+      m_last += n * m_resolution;
+
+      unsigned long target = m_ticks + n - 1;
+
+      while (n)
+      {
+        if (m_count == 0)
+        {
+          // Nothing to execute: skip the remaining ticks
+          m_ticks += n;
+          return;
+        }
+
+        step(target);
+        n--;
+      }
+    }
+
+    void TimerWheel::add(TimerTask &t)
+    {
+      unsigned long when = t.m_expires;
+      unsigned long delta = when - m_ticks;
+      TimerTask **slot;
+
+      if ((long) delta < 0)
+      {
+        // Already expired: execute it at the next tick
+        slot = &m_slots[0][m_ticks & (SLOTS - 1)];
+      }
+      else
+      {
+        uint8_t level = 0;
+
+        if ( delta >> (LEVEL_BITS * LEVELS) )
+        {
+          // Beyond the last wheel: park it in the farthest slot, it is moved again when reached
+          delta = (1UL << (LEVEL_BITS * LEVELS)) - 1;
+          when = m_ticks + delta;
+        }
+
+        while (level < LEVELS - 1 && (delta >> (LEVEL_BITS * (level + 1))))
+        {
+          level++;
+        }
+
+        slot = &m_slots[level][(when >> (LEVEL_BITS * level)) & (SLOTS - 1)];
+      }
+
+      t.m_next = *slot;
+      if (t.m_next)
+      {
+        t.m_next->m_pprev = &t.m_next;
+      }
+
+      t.m_pprev = slot;
+      *slot = &t;
+    }
+
+    void TimerWheel::remove(TimerTask &t)
+    {
+      *t.m_pprev = t.m_next;
+      if (t.m_next)
+      {
+        t.m_next->m_pprev = t.m_pprev;
+      }
+
+      t.m_next = 0;
+      t.m_pprev = 0;
+    }
+
+    uint8_t TimerWheel::cascade(uint8_t level)
+    {
+      uint8_t index = (m_ticks >> (LEVEL_BITS * level)) & (SLOTS - 1);
+      TimerTask *t = m_slots[level][index];
+
+      m_slots[level][index] = 0;
+
+      while (t)
+      {
+        TimerTask *next = t->m_next;
+
+        add(*t);
+        t = next;
+      }
+
+      return index;
+    }
+
+    void TimerWheel::step(unsigned long target)
+    {
+      uint8_t index = m_ticks & (SLOTS - 1);
+
+      if (index == 0)
+      {
+        // The first wheel has completed a round: refill it from the upper ones
+        for (uint8_t level = 1; level < LEVELS && cascade(level) == 0; level++)
+        {
+        }
+      }
+
+      // Detach the slot, so that callbacks can start and stop any task (also the expired ones)
+      TimerTask *expired = m_slots[0][index];
+
+      m_slots[0][index] = 0;
+      if (expired)
+      {
+        expired->m_pprev = &expired;
+      }
+
+      m_ticks++;
+
+      while (expired)
+      {
+        TimerTask *t = expired;
+
+        remove(*t);
+        m_count--;
+
+        if (t->m_period)
+        {
+          unsigned long late = target - t->m_expires;
+
+          t->m_expires += t->m_period;
+          if (late >= t->m_period)
+          {
+            // Skip the calls missed while the loop was stopped, keeping the phase
+            t->m_expires += (late / t->m_period) * t->m_period;
+          }
+
+          add(*t);
+          m_count++;
+        }
+
+        if (t->m_callback)
+        {
+          t->m_callback(*t);
+        }
+      }
+    }
+
+  } /* namespace timer */
+
+} /* namespace smrtobj */
@@ -0,0 +1,216 @@
+/**
+ * \file timerwheel.h
+ * \brief  TimerWheel is a hierarchical timer wheel calling one-shot and periodic tasks
+ *         (smrtobj::timer::TimerTask) when their time expires.
+ *
+ * \author Marco Boeris Frusca
+ *
+ */
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+#include "Arduino.h"
+#include "timertask.h"
+
+namespace smrtobj
+{
+
+  namespace timer
+  {
+
+    /**
+     * The TimerWheel class replaces a list of intervals checked one by one in the main loop. The main loop
+     * calls smrtobj::timer::TimerWheel::tick: it reads millis() once and calls only the tasks expired
+     * since the previous call, whatever the number of scheduled tasks is.
+     *
+     * Time is divided in ticks of \e resolution milliseconds. Tasks are linked in slots of LEVELS wheels of
+     * SLOTS slots each: the first wheel holds the tasks expiring in the next SLOTS ticks, one slot per
+     * tick; every next wheel covers SLOTS times the time of the previous one. At every tick only the
+     * slot of the current tick is executed; when the first wheel completes a round, the tasks of the next
+     * slot of the second wheel are moved to the first one (and so on). Starting, stopping and executing a
+     * task take a constant time. Tasks expiring beyond the last wheel are parked in it and moved again
+     * at every round.
+     *
+     * As smrtobj::timer::Interval, the wheel handles the roll over of millis() (every ~49.7 days): elapsed
+     * time is an unsigned difference, so the roll over does not stop nor anticipate the tasks. The delay
+     * of a task must be less than 2^31 ticks (~24.8 days with 1 ms resolution).
+     *
+     * Periodic tasks keep their phase: the next expiration is computed from the previous one, not from
+     * the time the task has been called. If the loop has been stopped for more than a period, the
+     * missed calls are skipped instead of being executed all together.
+     *
+     * The wheel does not copy nor allocate anything: tasks must exist until they are stopped or, for
+     * one-shot tasks, until they are called. Tasks can be started and stopped inside a callback.
+     *
+     * \code{.cpp}
+     * smrtobj::timer::TimerWheel wheel;
+     * smrtobj::timer::TimerTask report(sendReport);
+     * smrtobj::timer::TimerTask timeout(closeValve);
+     *
+     * void setup()
+     * {
+     *   wheel.start(report, 0, 60000);     // every minute
+     *   wheel.start(timeout, 5000);        // once, after 5 seconds
+     * }
+     *
+     * void loop()
+     * {
+     *   wheel.tick();
+     *   ...
+     * }
+     * \endcode
+     */
+    class TimerWheel
+    {
+      public:
+        /**
+         * \enum   _wheel
+         *
+         * Size of the wheels
+         */
+        enum _wheel
+        {
+          //! Bits of the tick counter used by each wheel
+          LEVEL_BITS = 4,
+
+          //! Slots of each wheel
+          SLOTS = (1 << LEVEL_BITS),
+
+          //! Number of wheels
+          LEVELS = 4,
+        };
+
+        /**
+         * Constructor.
+         * It sets the start time of the wheel at current time.
+         *
+         * \param[in] resolution duration of a tick (in milliseconds)
+         */
+        TimerWheel(unsigned int resolution = 1);
+
+        /**
+         * Destructor.
+         */
+        virtual ~TimerWheel();
+
+        /**
+         * Schedules a task. If the task is already scheduled, it is rescheduled. The delay is counted
+         * from the last tick.
+         *
+         * \param[in] t task
+         * \param[in] delay time before the first call (in milliseconds)
+         * \param[in] period time between two calls (in milliseconds), 0 for one-shot tasks
+         *
+         * \return false if the delay or the period are too long, true otherwise
+         */
+        bool start(TimerTask &t, unsigned long delay, unsigned long period = 0);
+
+        /**
+         * Removes a task from the wheel.
+         *
+         * \param[in] t task
+         *
+         * \return false if the task was not scheduled, true otherwise
+         */
+        bool stop(TimerTask &t);
+
+        /**
+         * Advances the wheel to the current time and calls the expired tasks. It has to be called in
+         * the main loop, as often as possible.
+         *
+         * \param[in] tref external reference time (in milliseconds), if 0 use system time
+         */
+        void tick(unsigned long tref = 0);
+
+        /**
+         * Gets the number of scheduled tasks.
+         *
+         * \return number of tasks
+         */
+        unsigned int count() const { return m_count; }
+
+        /**
+         * Gets the duration of a tick.
+         *
+         * \return resolution (in milliseconds)
+         */
+        unsigned int resolution() const { return m_resolution; }
+
+        /**
+         * Gets the time of the last tick.
+         *
+         * \return time (in milliseconds)
+         */
+        unsigned long time() const { return m_last; }
+
+      private:
+        /**
+         * Copy Constructor. A wheel can not be copied: tasks are linked to it.
+         */
+        TimerWheel(const TimerWheel &w);
+
+        /**
+         * Overload operator =. A wheel can not be copied: tasks are linked to it.
+         */
+        TimerWheel& operator=(const TimerWheel &w);
+
+        /**
+         * Converts a time in ticks, rounding up.
+         *
+         * \param[in] ms time (in milliseconds)
+         *
+         * \return number of ticks
+         */
+        unsigned long ticks(unsigned long ms) const;
+
+        /**
+         * Links a task to the slot of its expiration tick.
+         *
+         * \param[in] t task
+         */
+        void add(TimerTask &t);
+
+        /**
+         * Unlinks a task from its slot.
+         *
+         * \param[in] t task
+         */
+        void remove(TimerTask &t);
+
+        /**
+         * Moves the tasks of the current slot of a wheel to the lower wheels.
+         *
+         * \param[in] level wheel (1 to LEVELS - 1)
+         *
+         * \return index of the slot moved
+         */
+        uint8_t cascade(uint8_t level);
+
+        /**
+         * Executes the slot of the current tick and moves to the next tick.
+         *
+         * \param[in] target last tick to execute in this call to smrtobj::timer::TimerWheel::tick
+         */
+        void step(unsigned long target);
+
+        //! Slots of the wheels
+        TimerTask *m_slots[LEVELS][SLOTS];
+
+        //! Next tick to execute
+        unsigned long m_ticks;
+
+        //! Time of the last tick (in milliseconds)
+        unsigned long m_last;
+
+        //! Duration of a tick (in milliseconds)
+        unsigned int m_resolution;
+
+        //! Number of scheduled tasks
+        unsigned int m_count;
+    };
+
+  } /* namespace timer */
+
+} /* namespace smrtobj */
+
+#endif /* TIMERWHEEL_H_ */